@@ -1,6 +1,7 @@
 #include <posix/SpiMasterImpl.hpp>
 #include <posix/StorageImpl.hpp>
 #include <posix/FlashImpl.hpp>
+#include <posix/MappedFlashImpl.hpp>
 #include <FlashStorage.hpp>
 
 
@@ -16,6 +17,13 @@ constexpr int BLUETOOTH_CONTEXT_COUNT = 2;
 constexpr int NETWORK_CONTEXT_COUNT = 1;
 
 
+// packet pool
+// -----------
+
+constexpr int PACKET_POOL_COUNT = 8;
+constexpr int PACKET_POOL_SIZE = 128;
+
+
 // storage
 // -------
 
@@ -29,17 +37,17 @@ struct Drivers {
 	SpiMasterImpl airSensor{"airSensor"};
 	SpiMasterImpl display{"display"};
 	//StorageImpl storage{"storage.bin", 0xffff, 1024};
-	FlashImpl flash{"flash.bin", 32, 4096, 4};
+	MappedFlashImpl flash{"flash.bin", 32, 4096, 4};
 	FlashStorage storage{flash};
 };
 
 struct DriversFlashTest {
-	FlashImpl flash{"flashTest.bin", 2, 4096, 4};
+	MappedFlashImpl flash{"flashTest.bin", 2, 4096, 4};
 };
 
 struct DriversStorageTest {
 	//FlashImpl flash{"storageTest.bin", 2, 65536, 4};
-	FlashImpl flash{"storageTest.bin", 4, 32768, 4};
+	MappedFlashImpl flash{"storageTest.bin", 4, 32768, 4};
 	//FlashImpl flash{"storageTest.bin", 32, 4096, 4};
 	FlashStorage storage{flash};
 };
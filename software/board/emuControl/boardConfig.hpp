@@ -7,6 +7,7 @@
 #include <emu/SpiMR45Vxxx.hpp>
 #include <posix/StorageImpl.hpp>
 #include <posix/FlashImpl.hpp>
+#include <posix/MappedFlashImpl.hpp>
 #include <FeRamStorage4.hpp>
 #include <FlashStorage.hpp>
 #include <util.hpp>
@@ -39,6 +40,13 @@ constexpr int RADIO_CONTEXT_COUNT = 2;
 constexpr int RADIO_MAX_PAYLOAD_LENGTH = 125; // payload length without leading length byte and trailing crc
 
 
+// packet pool
+// -----------
+
+constexpr int PACKET_POOL_COUNT = 16;
+constexpr int PACKET_POOL_SIZE = 1 + RADIO_MAX_PAYLOAD_LENGTH + 1 + 4; // radio packet with length, LQI and timestamp
+
+
 // bluetooth
 // ---------
 
@@ -66,7 +74,7 @@ struct Drivers {
 	BusMasterImpl busMaster;
 
 	//StorageImpl storage{"storage.bin", 0xffff, 1024};
-	FlashImpl flash{"flash.bin", 4, 32768, 4};
+	MappedFlashImpl flash{"flash.bin", 4, 32768, 4};
 	FlashStorage storage{flash};
 
 	//StorageImpl counters{"counters.bin", FERAM_SIZE / 10, 4};
@@ -75,10 +83,10 @@ struct Drivers {
 };
 
 struct DriversFlashTest {
-	FlashImpl flash{"flashTest.bin", 2, 4096, 4};
+	MappedFlashImpl flash{"flashTest.bin", 2, 4096, 4};
 };
 
 struct DriversStorageTest {
-	FlashImpl flash{"storageTest.bin", 4, 32768, 4};
+	MappedFlashImpl flash{"storageTest.bin", 4, 32768, 4};
 	FlashStorage storage{flash};
 };
@@ -8,6 +8,7 @@
 #include <emu/SpiMPQ6526.hpp>
 #include <posix/StorageImpl.hpp>
 #include <posix/FlashImpl.hpp>
+#include <posix/MappedFlashImpl.hpp>
 #include <FlashStorage.hpp>
 #include <util.hpp>
 
@@ -43,6 +44,13 @@ constexpr int RADIO_CONTEXT_COUNT = 1;
 constexpr int RADIO_MAX_PAYLOAD_LENGTH = 125; // payload length without leading length byte and trailing crc
 
 
+// packet pool
+// -----------
+
+constexpr int PACKET_POOL_COUNT = 8;
+constexpr int PACKET_POOL_SIZE = 1 + RADIO_MAX_PAYLOAD_LENGTH + 1 + 4; // radio packet with length, LQI and timestamp
+
+
 // bluetooth
 // ---------
 
@@ -79,10 +87,10 @@ struct SwitchDrivers {
 };
 
 struct DriversFlashTest {
-	FlashImpl flash{"flashTest.bin", 2, 1024, 4};
+	MappedFlashImpl flash{"flashTest.bin", 2, 1024, 4};
 };
 
 struct DriversStorageTest {
-	FlashImpl flash{"storageTest.bin", 2, 1024, 4};
+	MappedFlashImpl flash{"storageTest.bin", 2, 1024, 4};
 	FlashStorage storage{flash};
 };
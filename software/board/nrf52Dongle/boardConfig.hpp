@@ -51,6 +51,13 @@ constexpr int RADIO_RECEIVE_QUEUE_LENGTH = 4;
 constexpr int RADIO_MAX_PAYLOAD_LENGTH = 125; // payload length without leading length byte and trailing crc
 
 
+// packet pool
+// -----------
+
+constexpr int PACKET_POOL_COUNT = 8;
+constexpr int PACKET_POOL_SIZE = 1 + RADIO_MAX_PAYLOAD_LENGTH + 1 + 4; // radio packet with length, LQI and timestamp
+
+
 // motion detector
 // ---------------
 
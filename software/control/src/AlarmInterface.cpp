@@ -38,6 +38,7 @@ AlarmInterface::AlarmInterface(uint8_t interfaceId, Storage &storage) : listener
 		++j;
 	}
 	this->alarmCount = j;
+	updateSchedule();
 
 	// start coroutines
 	tick();
@@ -116,6 +117,7 @@ void AlarmInterface::erase(uint8_t id) {
 
 			// delete alarm
 			delete alarm;
+			updateSchedule();
 
 			goto list;
 		}
@@ -145,6 +147,8 @@ void AlarmInterface::set(uint8_t id, Data &data) {
 
 		// store alarm to flash
 		this->storage.writeBlocking(STORAGE_ID_ALARM | id, sizeof(alarm->data), &alarm->data);
+
+		updateSchedule();
 		return;
 	}
 
@@ -159,6 +163,8 @@ void AlarmInterface::set(uint8_t id, Data &data) {
 
 	// store data to flash
 	this->storage.writeBlocking(STORAGE_ID_ALARM | data.id, sizeof(alarm->data), &alarm->data);
+
+	updateSchedule();
 }
 
 int AlarmInterface::getSubscriberCount(uint8_t id, uint8_t command) {
@@ -171,7 +177,7 @@ int AlarmInterface::getSubscriberCount(uint8_t id, uint8_t command) {
 
 			// check if conversion for subscriber succeeds (command is not discarded by convertOptions)
 			Message dst;
-			if (convertSwitch(subscriber.target.type, dst, command, subscriber.data->convertOptions))
+			if (subscriber.converter.convertSwitch(dst, command))
 				++count;
 		}
 		return count;
@@ -213,27 +219,60 @@ uint8_t AlarmInterface::allocateId() {
 	return id;
 }
 
+void AlarmInterface::updateSchedule() {
+	// add one entry for each weekday of each alarm
+	this->schedule.clear();
+	auto alarm = this->alarms;
+	while (alarm != nullptr) {
+		auto &time = alarm->data.time;
+		int weekdays = time.getWeekdays();
+		for (int weekday = 0; weekday < 7; ++weekday) {
+			if ((weekdays & (1 << weekday)) == 0)
+				continue;
+			this->schedule.add(ClockTime(weekday, time.getHours(), time.getMinutes(), time.getSeconds())
+				.getWeekSeconds(), alarm->data.id);
+		}
+		alarm = alarm->next;
+	}
+
+	// let tick() recalculate the next alarm
+	this->scheduleChanged.resumeFirst();
+}
+
 Coroutine AlarmInterface::tick() {
+	// time up to which the alarms were checked in seconds since start of week
+	int checked = Calendar::now().getWeekSeconds();
+	auto checkedTime = Timer::now();
 	while (true) {
-		// measure
-		co_await Calendar::secondTick();
-
-		// check if an alarm goes off
-		auto time = Calendar::now();
-		if (time.getSeconds() != 0)
+		if (this->schedule.isEmpty()) {
+			// wait until an alarm gets added
+			co_await select(this->scheduleChanged.wait(), Calendar::clockChange());
+			checked = Calendar::now().getWeekSeconds();
+			checkedTime = Timer::now();
 			continue;
-		auto alarm = this->alarms;
-		while (alarm != nullptr) {
-			if (alarm->data.time.matches(time)) {
-				// alarm goes off: publish to subscribers of this alarm
+		}
+
+		// sleep until the next alarm goes off, the wall clock is read with a resolution of one second, therefore we may
+		// wake up early and sleep again for the remaining second
+		int delay = this->schedule.getDelay(checked);
+		co_await select(Timer::sleep(delay * 1s), this->scheduleChanged.wait(), Calendar::clockChange());
+		int now = Calendar::now().getWeekSeconds();
+		auto time = Timer::now();
+
+		// publish all alarms that went off since the last check, also when the schedule was changed or the clock was
+		// adjusted in the meantime. Nothing is due when the clock jumped back or far forward
+		int span = this->schedule.getDueSpan(checked, now, (time - checkedTime + 999ms) / 1s);
+		this->schedule.forEachDue(checked, span, [this](uint8_t id) {
+			// alarm goes off: publish to subscribers of this alarm
+			auto alarm = findAlarm(id);
+			if (alarm != nullptr) {
 				alarm->publishSwitch(0, 1);
 
 				// set to active state
 				alarm->active = true;
-			} else if (alarm->active) {
-				// todo: check if alarm is deactivated again
 			}
-			alarm = alarm->next;
-		}
+		});
+		checked = now;
+		checkedTime = time;
 	}
 }
@@ -2,6 +2,7 @@
 
 #include "Interface.hpp"
 #include <ClockTime.hpp>
+#include <WeekSchedule.hpp>
 #include <Storage.hpp>
 
 
@@ -107,5 +108,15 @@ protected:
 
 	uint8_t allocateId();
 
+
+	// schedule of all alarms for one week, one entry per alarm and weekday
+	WeekSchedule<MAX_ALARM_COUNT * 7> schedule;
+
+	// gets resumed when the schedule changes
+	Barrier<> scheduleChanged;
+
+	// rebuild the schedule after alarms were added, changed or erased
+	void updateSchedule();
+
 	Coroutine tick();
 };
@@ -24,6 +24,7 @@ constexpr int MAX_RETRY = 2;
 
 BusInterface::BusInterface(uint8_t interfaceId, BusMaster &busMaster, Storage &storage, Storage &counters)
 	: listeners(interfaceId), busMaster(busMaster), storage(storage), counters(counters)
+	, securityCounter(counters, COUNTERS_ID_BUS)
 {
 	// load list of element ids
 	int elementCount = sizeof(this->elementIds);
@@ -75,10 +76,7 @@ BusInterface::BusInterface(uint8_t interfaceId, BusMaster &busMaster, Storage &s
 	this->elementCount = j;
 
 	// load security counter
-	int counterSize = 4;
-	counters.readBlocking(COUNTERS_ID_BUS, counterSize, &this->securityCounter);
-	if (counterSize != 4)
-		this->securityCounter = 0;
+	this->securityCounter.loadBlocking();
 
 	// start coroutines
 	for (int i = 0; i < RECEIVE_COUNT; ++i)
@@ -370,11 +368,14 @@ static bool readMessage(MessageType dstType, void *dstMessage, MessageType srcTy
 }*/
 
 Coroutine BusInterface::receive() {
-	uint8_t receiveMessage[MESSAGE_LENGTH];
-
 	while (true) {
-		int receiveLength = MESSAGE_LENGTH;
-		co_await this->busMaster.receive(receiveLength, receiveMessage);
+		// wait until we receive a message, the message gets decrypted in-place
+		PacketBuffer packet;
+		co_await this->busMaster.receive(packet);
+		if (!packet.makeWritable())
+			continue;
+		int receiveLength = min(packet.getLength(), MESSAGE_LENGTH);
+		uint8_t *receiveMessage = packet.data();
 
 		// debug print received message
 		//for (int i = 0; i < receiveLength; ++i)
@@ -764,10 +765,10 @@ AwaitableCoroutine BusInterface::readAttribute(int &length, uint8_t (&message)[M
 			length = w.getLength();
 		}
 
-		// increment and store security counter
+		// increment security counter and store if necessary
 		++this->securityCounter;
 		Storage::Status status;
-		co_await this->counters.write(COUNTERS_ID_BUS, 4, &this->securityCounter, status);
+		co_await this->securityCounter.store(status);
 
 		// send
 		co_await this->busMaster.send(length, message);
@@ -911,9 +912,9 @@ Coroutine BusInterface::publish() {
 						length = w.getLength();
 					}
 
-					// store security counter
+					// store security counter if necessary
 					Storage::Status status;
-					co_await this->counters.write(COUNTERS_ID_BUS, 4, &this->securityCounter, status);
+					co_await this->securityCounter.store(status);
 
 					// send
 					co_await this->busMaster.send(length, sendMessage);
@@ -3,6 +3,7 @@
 #include "Interface.hpp"
 #include <BusMaster.hpp>
 #include <Storage.hpp>
+#include <PersistentCounter.hpp>
 #include <MessageReader.hpp>
 #include <MessageWriter.hpp>
 //#include <appConfig.hpp>
@@ -150,7 +151,7 @@ private:
 
 	// persistent counters
 	Storage &counters;
-	uint32_t securityCounter;
+	PersistentCounter securityCounter;
 
 	// configuration
 	DataBuffer<16> const *key = nullptr;
@@ -78,7 +78,7 @@ static const TypeInfo typeInfos[] = {
 					co_await function->barrier.wait(info, &message);
 				} else {
 					// on: wait for message or timeout
-					int s = co_await select(function->barrier.wait(info, &message), Timer::sleep(timeout));
+					int s = co_await select(function->barrier.wait(info, &message), function->animator.wait(Timer::now() + timeout));
 					if (s == 2) {
 						// timeout: switch off
 						message = 0;
@@ -146,7 +146,8 @@ static const TypeInfo typeInfos[] = {
 					//Terminal::out << "select" << '\n';
 					bool off = timeoutActive && (!transition || offTime <= endTime);
 					now = off ? offTime : endTime;
-					int s = co_await select(function->barrier.wait(info, &message), Timer::sleep(now));
+					int s = co_await select(function->barrier.wait(info, &message),
+						off ? function->animator.wait(now) : function->animator.step(now));
 
 					// "relaxed" time to prevent lagging behind
 					now = Timer::now();
@@ -299,7 +300,8 @@ static const TypeInfo typeInfos[] = {
 					//Terminal::out << "select" << '\n';
 					bool off = timeoutActive && (!transition || offTime <= endTime);
 					now = off ? offTime : endTime;
-					int s = co_await select(function->barrier.wait(info, &message), Timer::sleep(now));
+					int s = co_await select(function->barrier.wait(info, &message),
+						off ? function->animator.wait(now) : function->animator.step(now));
 
 					// "relaxed" time to prevent lagging behind
 					now = Timer::now();
@@ -492,7 +494,8 @@ static const TypeInfo typeInfos[] = {
 					bool off = timeout > 0ms && on && offTime <= now;
 					if (off)
 						now = offTime;
-					int s = co_await select(function->barrier.wait(info, &message), Timer::sleep(now));
+					int s = co_await select(function->barrier.wait(info, &message),
+						off ? function->animator.wait(now) : function->animator.step(now));
 
 					// "relaxed" time to prevent lagging behind
 					now = Timer::now();
@@ -691,9 +694,14 @@ static const TypeInfo typeInfos[] = {
 					//Terminal::out << "plug " << dec(info.plug.id) << '\n';
 				} else {
 					auto d = targetPosition - position;
+					if (up)
+						d = -d;
 
-					// wait for event or timeout with a maximum to regularly report the current position
-					int s = co_await select(function->barrier.wait(info, &message), Timer::sleep(min(up ? -d : d, 200ms)));
+					// wait for event, for the target position (precisely) or for the next report of the current position
+					// which is synchronized with the other functions by the animation engine
+					auto now = Timer::now();
+					int s = co_await select(function->barrier.wait(info, &message),
+						d <= 200ms ? function->animator.wait(now + d) : function->animator.step(now + 200ms));
 
 					// set invalid plug index when timeout occurred
 					if (s != 1)
@@ -889,6 +897,22 @@ static const TypeInfo typeInfos[] = {
 	}
 };
 
+
+Coroutine FunctionInterface::animate() {
+	while (true) {
+		// wait until a function waits for a transition step
+		SystemTime next;
+		if (!this->animator.getNext(next)) {
+			co_await this->animator.changed();
+			continue;
+		}
+
+		// sleep until the next step, restart if an earlier step is requested in the meantime
+		if (co_await select(Timer::sleep(next), this->animator.changed()) == 1)
+			this->animator.advance(Timer::now());
+	}
+}
+
 static int findIndex(FunctionInterface::Type type) {
 	return array::binaryLowerBound(typeInfos, [type](TypeInfo const &element) { return element.type < type; });
 }
@@ -946,9 +970,13 @@ FunctionInterface::FunctionInterface(uint8_t interfaceId, Storage &storage)
 		++j;
 	}
 	this->functionCount = j;
+
+	// start animation engine
+	this->animatorCoroutine = animate();
 }
 
 FunctionInterface::~FunctionInterface() {
+	this->animatorCoroutine.destroy();
 }
 
 String FunctionInterface::getName() {
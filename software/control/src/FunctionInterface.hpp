@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Interface.hpp"
+#include <Animator.hpp>
 #include <Storage.hpp>
 #include <Data.hpp>
 
@@ -161,6 +162,7 @@ public:
 		// adds to linked list and takes ownership of the data
 		Function(FunctionInterface *interface, Data *data)
 			: Element(data->id, interface->listeners), next(interface->functions), data(data)
+			, animator(interface->animator)
 		{
 			interface->functions = this;
 		}
@@ -179,6 +181,9 @@ public:
 
 		// coroutines wait here until something gets published to them
 		SubscriberBarrier barrier;
+
+		// animation engine of the interface
+		Animator &animator;
 	};
 
 	// find function by id
@@ -193,6 +198,13 @@ public:
 	// persistent storage
 	Storage &storage;
 
+	// animation engine for all functions
+	Animator animator;
+	Coroutine animatorCoroutine;
+
+	// drive the animation engine using one timer
+	Coroutine animate();
+
 	// functions
 	Function *functions = nullptr;
 	int functionCount = 0;
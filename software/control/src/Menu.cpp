@@ -5,15 +5,21 @@
 #include "tahoma_8pt.hpp" // font
 
 
+Menu::Cache Menu::cache;
+
 Menu::Menu(QuadratureDecoder &decoder, SwapChain &swapChain)
 	: decoder(decoder), swapChain(swapChain), bitmap(swapChain.get())
 {}
 
+Menu::~Menu() {
+	// a new menu may be created at the same address
+	if (Menu::cache.owner == this)
+		Menu::cache.owner = nullptr;
+}
+
 void Menu::line() {
-	int x = 10;
-	int y = this->entryY + 2 - this->offsetY;
-	if (this->bitmap != nullptr)
-		this->bitmap->fillRectangle(x, y, 108, 1);
+	this->text.clear();
+	addLine(1 + 4, Line::Type::DIVIDER);
 	this->entryY += 1 + 4;
 }
 
@@ -33,23 +39,23 @@ Menu::Stream Menu::stream() {
 		line();
 	this->section = Section::BODY;
 
-	return {10, this->entryY + 2 - this->offsetY, this->bitmap};
+	this->text.clear();
+	return Stream(this->bitmap != nullptr ? &this->text : nullptr);
 }
 
 void Menu::label() {
-	this->entryY += tahoma_8pt.height + 4;
+	const int lineHeight = tahoma_8pt.height + 4;
+	addLine(lineHeight, Line::Type::TEXT);
+	this->entryY += lineHeight;
 }
 
 bool Menu::entry() {
 	const int lineHeight = tahoma_8pt.height + 4;
-	int y = this->entryY + 2 - this->offsetY;
 
 	bool selected = this->entryIndex == this->selected;
-	if (selected) {
-		if (this->bitmap != nullptr)
-			this->bitmap->drawText(0, y, tahoma_8pt, ">", 0);
+	addLine(lineHeight, selected ? Line::Type::SELECTED_TEXT : Line::Type::TEXT);
+	if (selected)
 		this->selectedY = this->entryY;
-	}
 
 	++this->entryIndex;
 	this->entryY += lineHeight;
@@ -107,6 +113,30 @@ AwaitableCoroutine Menu::show() {
 	// number of entries in menu
 	int entryCount = this->entryIndex;
 
+	// clear rows of lines of the last frame that are not covered by lines of this frame
+	claimCache();
+	auto &cache = Menu::cache;
+	for (int i = 0; i < cache.lineCount; ++i) {
+		auto &line = cache.lines[i];
+		if (i < this->lineCount && line == this->lines[i])
+			continue;
+		int end = min(line.y + line.height, DISPLAY_HEIGHT);
+		for (int y = max(int(line.y), 0); y < end; ++y) {
+			bool covered = false;
+			for (int j = 0; j < this->lineCount; ++j) {
+				auto &l = this->lines[j];
+				covered |= y >= l.y && y < l.y + l.height;
+			}
+			if (!covered)
+				cache.bitmap.hLine(0, y, DISPLAY_WIDTH, DrawMode::CLEAR);
+		}
+	}
+
+	// lines of this frame become the cached lines
+	array::copy(this->lineCount, cache.lines, this->lines);
+	cache.lineCount = this->lineCount;
+	this->lineCount = 0;
+
 	// clear for next menu drawing
 	this->entryIndex = 0;
 	this->entryY = 0;
@@ -115,6 +145,7 @@ AwaitableCoroutine Menu::show() {
 
 	if (!redraw) {
 		// show menu
+		this->bitmap->copy(cache.bitmap);
 		this->swapChain.show(this->bitmap);
 		this->bitmap = nullptr;
 
@@ -148,3 +179,91 @@ AwaitableCoroutine Menu::show() {
 			this->bitmap->clear();
 	}
 }
+
+// protected:
+
+void Menu::claimCache() {
+	auto &cache = Menu::cache;
+	if (cache.owner != this) {
+		cache.owner = this;
+		cache.bitmap.clear();
+		cache.lineCount = 0;
+	}
+}
+
+void Menu::addLine(int height, Line::Type type) {
+	int y = this->entryY - this->offsetY;
+
+	// only lines on the display are drawn, no lines are drawn after an entry was activated
+	if (this->bitmap != nullptr && y < DISPLAY_HEIGHT && y + height > 0 && this->lineCount < MAX_LINE_COUNT) {
+		claimCache();
+		auto &cache = Menu::cache;
+		Line line = {int16_t(y), uint8_t(height), type};
+		int index = this->lineCount++;
+		this->lines[index] = line;
+
+		// draw if position, type or text changed
+		auto &text = cache.texts[index];
+		if (index >= cache.lineCount || !(cache.lines[index] == line) || !(text.string() == this->text.string())) {
+			text = this->text.string();
+			drawLine(line, text);
+		}
+	}
+	this->text.clear();
+}
+
+void Menu::drawLine(Line const &line, String text) {
+	auto &bitmap = Menu::cache.bitmap;
+	int y = line.y + 2;
+
+	// clear the rows of the line
+	bitmap.fillRectangle(0, line.y, DISPLAY_WIDTH, line.height, DrawMode::CLEAR);
+
+	if (line.type == Line::Type::DIVIDER) {
+		bitmap.fillRectangle(10, y, 108, 1);
+		return;
+	}
+	if (line.type == Line::Type::SELECTED_TEXT)
+		bitmap.drawText(0, y, tahoma_8pt, ">", 0);
+
+	// draw text and interpret markup
+	int x = 10;
+	int underlineCount = 0;
+	int underlineStart = 0;
+	int invertCount = 0;
+	int invertStart = 0;
+	int start = 0;
+	for (int i = 0; i <= text.length; ++i) {
+		if (i < text.length && uint8_t(text[i]) > uint8_t(Stream::Command::CLEAR_INVERT))
+			continue;
+		x = bitmap.drawText(x, y, tahoma_8pt, text.substring(start, i));
+		start = i + 1;
+		if (i == text.length)
+			break;
+
+		switch (Stream::Command(text[i])) {
+			case Stream::Command::SET_UNDERLINE:
+				if (underlineCount == 0)
+					underlineStart = x;
+				++underlineCount;
+				break;
+			case Stream::Command::CLEAR_UNDERLINE:
+				if (underlineCount > 0) {
+					if (--underlineCount == 0)
+						bitmap.hLine(underlineStart, y + tahoma_8pt.height, x - underlineStart - 1);
+				}
+				break;
+			case Stream::Command::SET_INVERT:
+				if (invertCount == 0)
+					invertStart = x;
+				++invertCount;
+				break;
+			case Stream::Command::CLEAR_INVERT:
+				if (invertCount > 0) {
+					if (--invertCount == 0)
+						bitmap.fillRectangle(invertStart - 1, y, x - invertStart + 1, tahoma_8pt.height, DrawMode::FLIP);
+				}
+				break;
+		}
+	}
+}
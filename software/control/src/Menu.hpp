@@ -7,10 +7,19 @@
 #include <StringOperators.hpp>
 
 
+/*
+	Menu that gets rebuilt by the menu coroutine on each event (immediate mode). Rendering is retained: each line (text
+	with markup, selection and position) is compared to the line at the same index of the last frame and only changed
+	lines are rasterized into a bitmap that is shared by all menus. Unchanged menus only copy this bitmap
+	to the swap chain which in turn only transfers changed parts to the display.
+*/
 class Menu {
 public:
-	
+	// maximum length of a line of text including markup
+	static constexpr int LINE_LENGTH = 64;
+
 	Menu(QuadratureDecoder &decoder, SwapChain &swapChain);
+	~Menu();
 
 	/**
 	 * Add a divider line to the menu
@@ -19,66 +28,35 @@ public:
 	void beginSection();
 	void endSection();
 
+	/**
+	 * Stream for the text of the current line, markup is stored as Command and interpreted when the line gets drawn
+	 */
 	class Stream : public ::Stream {
 	public:
-		int x;
-		int y;
-		Bitmap<DISPLAY_WIDTH, DISPLAY_HEIGHT> *bitmap;
-		int16_t underlineCount = 0;
-		int16_t underlineStart;
-		int16_t invertCount = 0;
-		int16_t invertStart;
-
-
-		Stream(int x, int y, Bitmap<DISPLAY_WIDTH, DISPLAY_HEIGHT> *bitmap) : x(x), y(y), bitmap(bitmap) {}
+		explicit Stream(StringBuffer<LINE_LENGTH> *text) : text(text) {}
 
 		~Stream() override {}
 
 		Stream &operator <<(char ch) override {
-			if (this->bitmap != nullptr)
-				this->x = this->bitmap->drawText(this->x, this->y, tahoma_8pt, String(1, &ch));
+			if (this->text != nullptr)
+				*this->text += ch;
 			return *this;
 		}
 		
 		Stream &operator <<(String const &str) override {
-			if (this->bitmap != nullptr)
-				this->x = this->bitmap->drawText(this->x, this->y, tahoma_8pt, str);
+			if (this->text != nullptr)
+				*this->text += str;
 			return *this;
 		}
 		
 		Stream &operator <<(Command command) override {
-			switch (command) {
-				case Command::SET_UNDERLINE:
-					if (this->underlineCount == 0)
-						this->underlineStart = this->x;
-					++this->underlineCount;
-					break;
-				case Command::CLEAR_UNDERLINE:
-					if (this->underlineCount > 0) {
-						if (--this->underlineCount == 0) {
-							int x = this->underlineStart;
-							if (this->bitmap != nullptr)
-								this->bitmap->hLine(x, this->y + tahoma_8pt.height, this->x - x - 1);
-						}
-					}
-					break;
-				case Command::SET_INVERT:
-					if (this->invertCount == 0)
-						this->invertStart = this->x;
-					++this->invertCount;
-					break;
-				case Command::CLEAR_INVERT:
-					if (this->invertCount > 0) {
-						if (--this->invertCount == 0) {
-							int x = this->invertStart;
-							if (this->bitmap != nullptr)
-								this->bitmap->fillRectangle(x - 1, this->y, this->x - x + 1, tahoma_8pt.height, DrawMode::FLIP);
-						}
-					}
-					break;
-			}
+			if (this->text != nullptr)
+				*this->text += char(command);
 			return *this;
 		}
+
+	protected:
+		StringBuffer<LINE_LENGTH> *text;
 	};
 
 	Stream stream();
@@ -147,10 +125,60 @@ protected:
 		}
 	};
 
+	// line of the menu on the display
+	struct Line {
+		enum class Type : uint8_t {
+			DIVIDER,
+			TEXT,
+			SELECTED_TEXT
+		};
+
+		int16_t y;
+		uint8_t height;
+		Type type;
+
+		bool operator ==(Line const &) const = default;
+	};
+
+	// maximum number of lines on the display (dividers are the lowest lines)
+	static constexpr int MAX_LINE_COUNT = DISPLAY_HEIGHT / 5 + 2;
+
+	// retained rendering shared by all menus
+	struct Cache {
+		// menu that was drawn into the cache
+		Menu const *owner = nullptr;
+
+		// rendered lines
+		Bitmap<DISPLAY_WIDTH, DISPLAY_HEIGHT> bitmap;
+		int lineCount = 0;
+		Line lines[MAX_LINE_COUNT];
+
+		// text of the rendered lines including markup
+		StringBuffer<LINE_LENGTH> texts[MAX_LINE_COUNT];
+	};
+	static Cache cache;
+
+	// claim the cache for this menu, cached lines of another menu get discarded
+	void claimCache();
+
+	// add a line of the current frame, gets drawn if it differs from the line at the same index in the last frame
+	void addLine(int height, Line::Type type);
+
+	// draw a line into the cache
+	static void drawLine(Line const &line, String text);
+
+
 	QuadratureDecoder &decoder;
 	SwapChain &swapChain;
 	Bitmap<DISPLAY_WIDTH, DISPLAY_HEIGHT> *bitmap;
 
+	// text of current line
+	StringBuffer<LINE_LENGTH> text;
+
+	// lines of current frame
+	int lineCount = 0;
+	Line lines[MAX_LINE_COUNT];
+
 	int8_t delta = 0;
 	bool activated = false;
 
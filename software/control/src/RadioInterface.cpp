@@ -21,6 +21,20 @@ constexpr SystemDuration timeout = 1s;
 // number of retries when a send fails
 constexpr int MAX_RETRY = 2;
 
+// route cache: routes of recently used devices get refreshed in the background before they reach the maximum age
+constexpr SystemDuration ROUTE_CHECK_INTERVAL = 10s;
+constexpr SystemDuration ROUTE_REFRESH_AGE = 4min;
+constexpr SystemDuration ROUTE_MAX_AGE = 10min;
+
+// time after the last use when a device does not count as recently used anymore
+constexpr SystemDuration ROUTE_USE_TIME = 1h;
+
+// interval for repeating unanswered route requests for unknown routes
+constexpr SystemDuration ROUTE_RETRY_INTERVAL = 1min;
+
+// number of unacknowledged sends after which the route gets refreshed
+constexpr int ROUTE_MAX_FAIL_COUNT = 2;
+
 constexpr zb::SecurityControl securityLevel = zb::SecurityControl::LEVEL_ENC_MIC32; // encrypted + 32 bit message integrity code
 
 
@@ -28,6 +42,7 @@ constexpr zb::SecurityControl securityLevel = zb::SecurityControl::LEVEL_ENC_MIC
 
 RadioInterface::RadioInterface(uint8_t interfaceId, Storage &storage, Storage &counters)
 	: listeners(interfaceId), storage(storage), counters(counters)
+	, securityCounter(counters, COUNTERS_ID_RADIO)
 {
 	// load list of device ids
 	int elementCount = sizeof(this->elementIds);
@@ -72,9 +87,13 @@ RadioInterface::RadioInterface(uint8_t interfaceId, Storage &storage, Storage &c
 
 			// check size
 			if (endpointData->size() != size) {
-				// size is inconsistent, delete device
-				free(data);
-				continue;
+				// data may be stored before reporting existed where the report count is an undefined padding byte
+				endpointData->reportCount = 0;
+				if (endpointData->size() != size) {
+					// size is inconsistent, delete device
+					free(data);
+					continue;
+				}
 			}
 
 			// get or load the device this endpoint belongs to
@@ -86,7 +105,7 @@ RadioInterface::RadioInterface(uint8_t interfaceId, Storage &storage, Storage &c
 			}
 
 			// create endpoint, add to list of endpoints of device, device takes ownership of endpoint
-			new ZbEndpoint(this, device, endpointData);
+			this->zbEndpointIndex[id] = new ZbEndpoint(this, device, endpointData);
 		}
 
 		// device was correctly loaded
@@ -96,15 +115,13 @@ RadioInterface::RadioInterface(uint8_t interfaceId, Storage &storage, Storage &c
 	this->elementCount = j;
 
 	// load security counter
-	int counterSize = 4;
-	counters.readBlocking(COUNTERS_ID_RADIO, counterSize, &this->securityCounter);
-	if (counterSize != 4)
-		this->securityCounter = 0;
+	this->securityCounter.loadBlocking();
 	//Terminal::out << "ZB load security counter " << dec(this->securityCounter) << '\n';
 
 	// start coroutines
 	broadcast();
 	sendBeacon();
+	refreshRoutes();
 	for (int i = 0; i < PUBLISH_COUNT; ++i)
 		publish();
 	for (int i = 0; i < RECEIVE_COUNT; ++i)
@@ -257,8 +274,10 @@ void RadioInterface::erase(uint8_t id) {
 		while (*d != nullptr) {
 			auto device = *d;
 			if (device->data->id == id) {
-				// remove device from linked list
+				// remove device from linked list and lookup tables
 				*d = device->next;
+				this->gpDeviceIndex[id] = nullptr;
+				this->gpDeviceIds.remove(device->data->deviceId, device);
 
 				// erase from flash
 				this->storage.eraseBlocking(STORAGE_ID_RADIO1 | id);
@@ -281,13 +300,18 @@ void RadioInterface::erase(uint8_t id) {
 			while (*e != nullptr) {
 				auto endpoint = *e;
 				if (endpoint->data->id == id) {
-					// remove endpoint from linked list
+					// stop configuration of reporting as it may use the endpoint or device
+					this->reportingCoroutine.cancel();
+
+					// remove endpoint from linked list and lookup table
 					*e = endpoint->next;
+					this->zbEndpointIndex[id] = nullptr;
 
 					// check if device has no endpoints left
 					if (device->endpoints == nullptr) {
-						// remove device from linked list
+						// remove device from linked list and lookup tables
 						*d = device->next;
+						removeFromTables(device);
 
 						// erase device from flash
 						this->storage.eraseBlocking(STORAGE_ID_RADIO2 | device->data.id);
@@ -316,6 +340,35 @@ list:
 	this->storage.writeBlocking(STORAGE_ID_RADIO1, this->elementCount, this->elementIds);
 }
 
+RadioInterface::Reporting const *RadioInterface::getReporting(uint8_t id, uint8_t plugIndex) const {
+	auto zbEndpoint = getZbEndpoint(id);
+	if (zbEndpoint != nullptr) {
+		auto report = zbEndpoint->findReport(plugIndex);
+		if (report != nullptr)
+			return &report->reporting;
+	}
+	return nullptr;
+}
+
+void RadioInterface::setReporting(uint8_t id, uint8_t plugIndex, Reporting const &reporting) {
+	auto zbEndpoint = getZbEndpoint(id);
+	if (zbEndpoint == nullptr)
+		return;
+	auto report = zbEndpoint->findReport(plugIndex);
+	if (report == nullptr)
+		return;
+	report->reporting.minInterval = reporting.minInterval;
+	report->reporting.maxInterval = reporting.maxInterval;
+	report->reporting.reportableChange = reporting.reportableChange;
+
+	// write to flash
+	this->storage.writeBlocking(STORAGE_ID_RADIO1 | id, zbEndpoint->data->size(), zbEndpoint->data);
+
+	// send to device, cancels a configuration of reporting that is still in progress
+	this->reportingCoroutine.cancel();
+	this->reportingCoroutine = reconfigureReporting(id);
+}
+
 // private:
 
 // GpDevice
@@ -346,11 +399,68 @@ RadioInterface::ZbDevice::~ZbDevice() {
 	}
 }
 
+// attributes that are reported by zbee devices, with default reporting configuration and conversion of the attribute
+// value to the value of the plug: value * scale + offset
+struct ReportDefault {
+	zcl::Cluster cluster;
+	uint16_t attribute;
+	zcl::DataType type;
+	MessageType plug;
+	uint16_t minInterval;
+	uint16_t maxInterval;
+	uint16_t reportableChange;
+	float scale;
+	float offset;
+};
+static ReportDefault const reportDefaults[] = {
+	// on/off state of e.g. a smart plug, report each change
+	{zcl::Cluster::ON_OFF, uint16_t(zcl::OnOffAttribute::ON_OFF), zcl::DataType::BOOL,
+		MessageType::BINARY_POWER_OUT, 0, 600, 0, 1.0f, 0.0f},
+
+	// level 0 - 254
+	{zcl::Cluster::LEVEL_CONTROL, uint16_t(zcl::LevelControlAttribute::LEVEL), zcl::DataType::UINT8,
+		MessageType::LIGHTING_BRIGHTNESS_OUT, 1, 600, 5, 1.0f / 254.0f, 0.0f},
+
+	// battery in 0.5%, only a few reports per day to save battery
+	{zcl::Cluster::POWER_CONFIGURATION, uint16_t(zcl::PowerConfigurationAttribute::BATTERY_PERCENTAGE),
+		zcl::DataType::UINT8, MessageType::LEVEL_BATTERY_OUT, 3600, 43200, 2, 1.0f / 200.0f, 0.0f},
+
+	// battery voltage in 100mV
+	{zcl::Cluster::POWER_CONFIGURATION, uint16_t(zcl::PowerConfigurationAttribute::BATTERY_VOLTAGE),
+		zcl::DataType::UINT8, MessageType::PHYSICAL_VOLTAGE_MEASURED_LOW_OUT, 3600, 43200, 1, 0.1f, 0.0f},
+
+	// temperature in 1/100 Celsius, report changes of 0.1 Kelvin
+	{zcl::Cluster::THERMOSTAT, uint16_t(zcl::ThermostatAttribute::LOCAL_TEMPERATURE), zcl::DataType::INT16,
+		MessageType::PHYSICAL_TEMPERATURE_MEASURED_ROOM_OUT, 10, 600, 10, 0.01f, 273.15f},
+	{zcl::Cluster::TEMPERATURE_MEASUREMENT, uint16_t(zcl::TemperatureMeasurementAttribute::MEASURED_VALUE),
+		zcl::DataType::INT16, MessageType::PHYSICAL_TEMPERATURE_MEASURED_ROOM_OUT, 10, 600, 10, 0.01f, 273.15f},
+};
+
+static ReportDefault const *findReportDefault(zcl::Cluster cluster, uint16_t attribute) {
+	for (auto &report : reportDefaults) {
+		if (report.cluster == cluster && report.attribute == attribute)
+			return &report;
+	}
+	return nullptr;
+}
+
 // ZbEndpointDataBuilder
 int RadioInterface::ZbEndpointDataBuilder::size() const {
 	int s1 = (this->plugCount * sizeof(MessageType) + 3) / 4;
 	int s2 = ((this->serverClusterIndex + (MAX_CLUSTER_COUNT - 1 - this->clientClusterIndex)) * sizeof(ClusterInfo) + 3) / 4;
-	return offsetOf(ZbEndpointData, buffer[s1 + s2]);
+	int s3 = (this->reportCount * sizeof(ReportInfo) + 3) / 4;
+	return offsetOf(ZbEndpointData, buffer[s1 + s2 + s3]);
+}
+
+void RadioInterface::ZbEndpointDataBuilder::addReports(zcl::Cluster cluster) {
+	for (auto &report : reportDefaults) {
+		if (report.cluster == cluster && this->reportCount < MAX_REPORT_COUNT) {
+			this->reportInfos[this->reportCount++] = {cluster, report.attribute,
+				{report.minInterval, report.maxInterval, report.reportableChange, zcl::Status::SUCCESS}, report.type,
+				this->plugCount};
+			addPlug(report.plug);
+		}
+	}
 }
 
 void RadioInterface::ZbEndpointDataBuilder::build(ZbEndpointData *data) {
@@ -363,6 +473,7 @@ void RadioInterface::ZbEndpointDataBuilder::build(ZbEndpointData *data) {
 	data->plugCount = this->plugCount;
 	data->serverClusterCount = this->serverClusterIndex;
 	data->clientClusterCount = MAX_CLUSTER_COUNT - 1 - this->clientClusterIndex;
+	data->reportCount = this->reportCount;
 
 	// copy plugs
 	auto plugs = reinterpret_cast<MessageType *>(data->buffer);
@@ -381,6 +492,11 @@ void RadioInterface::ZbEndpointDataBuilder::build(ZbEndpointData *data) {
 		*clusterInfos = this->clusterInfos[MAX_CLUSTER_COUNT - 1 - i];
 		++clusterInfos;
 	}
+
+	// copy report infos
+	int s2 = ((data->serverClusterCount + data->clientClusterCount) * sizeof(ClusterInfo) + 3) / 4;
+	auto reportInfos = reinterpret_cast<ReportInfo *>(&data->buffer[s1 + s2]);
+	array::copy(data->reportCount, reportInfos, this->reportInfos);
 }
 
 // ZbEndpoint
@@ -424,30 +540,42 @@ RadioInterface::ClusterInfo RadioInterface::ZbEndpoint::getClientCluster(int plu
 	return {zcl::Cluster::BASIC, {0, 0}};
 }
 
-RadioInterface::GpDevice *RadioInterface::getGpDevice(uint8_t id) const {
-	auto device = this->gpDevices;
-	while (device != nullptr) {
-		if (device->data->id == id)
-			return device;
-		device = device->next;
+Array<RadioInterface::ReportInfo> RadioInterface::ZbEndpoint::getReports() const {
+	// get reportInfos array
+	int s1 = (this->data->plugCount * sizeof(MessageType) + 3) / 4;
+	int s2 = ((this->data->serverClusterCount + this->data->clientClusterCount) * sizeof(ClusterInfo) + 3) / 4;
+	auto reportInfos = reinterpret_cast<ReportInfo *>(&this->data->buffer[s1 + s2]);
+	return {this->data->reportCount, reportInfos};
+}
+
+RadioInterface::ReportInfo const *RadioInterface::ZbEndpoint::findReport(zcl::Cluster cluster, uint16_t attribute) const {
+	for (auto &report : getReports()) {
+		if (report.cluster == cluster && report.attribute == attribute)
+			return &report;
 	}
+
+	// not found
 	return nullptr;
 }
 
-RadioInterface::ZbEndpoint *RadioInterface::getZbEndpoint(uint8_t id) const {
-	auto device = this->zbDevices;
-	while (device != nullptr) {
-		auto endpoint = device->endpoints;
-		while (endpoint != nullptr) {
-			if (endpoint->data->id == id)
-				return endpoint;
-			endpoint = endpoint->next;
-		}
-		device = device->next;
+RadioInterface::ReportInfo *RadioInterface::ZbEndpoint::findReport(uint8_t plugIndex) const {
+	for (auto &report : getReports()) {
+		if (report.plugIndex == plugIndex)
+			return &report;
 	}
+
+	// not found
 	return nullptr;
 }
 
+RadioInterface::GpDevice *RadioInterface::getGpDevice(uint8_t id) const {
+	return this->gpDeviceIndex[id];
+}
+
+RadioInterface::ZbEndpoint *RadioInterface::getZbEndpoint(uint8_t id) const {
+	return this->zbEndpointIndex[id];
+}
+
 uint8_t RadioInterface::allocateId(int elementCount) {
 	// find a free id
 	int id;
@@ -485,12 +613,9 @@ uint8_t RadioInterface::allocateDeviceId() {
 }
 
 RadioInterface::ZbDevice *RadioInterface::getOrLoadZbDevice(uint8_t deviceId) {
-	auto device = this->zbDevices;
-	while (device != nullptr) {
-		if (device->data.id == deviceId)
-			return device;
-		device = device->next;
-	}
+	auto device = this->zbDeviceIndex[deviceId];
+	if (device != nullptr)
+		return device;
 
 	// load data
 	ZbDeviceData data;
@@ -504,7 +629,14 @@ RadioInterface::ZbDevice *RadioInterface::getOrLoadZbDevice(uint8_t deviceId) {
 		return nullptr;
 
 	// create device
-	return new ZbDevice(this, data);
+	device = new ZbDevice(this, data);
+	addToTables(device);
+
+	// discover the route in the background so that the first message after startup does not wait for it
+	device->useTime = Timer::now();
+	device->recentlyUsed = true;
+
+	return device;
 }
 /*
 void RadioInterface::eraseZbDevice(uint8_t deviceId) {
@@ -536,14 +668,32 @@ void RadioInterface::eraseZbDevice(uint8_t deviceId) {
 	}
 }*/
 
-RadioInterface::ZbDevice *RadioInterface::findZbDevice(uint16_t address) {
-	auto device = this->zbDevices;
-	while (device != nullptr) {
-		if (device->data.shortAddress == address)
-			return device;
-		device = device->next;
+void RadioInterface::addToTables(ZbDevice *device) {
+	this->zbDeviceIndex[device->data.id] = device;
+	this->zbShortAddresses.set(device->data.shortAddress, device);
+	this->zbLongAddresses.set(device->data.longAddress, device);
+	auto endpoint = device->endpoints;
+	while (endpoint != nullptr) {
+		this->zbEndpointIndex[endpoint->data->id] = endpoint;
+		endpoint = endpoint->next;
 	}
-	return nullptr;
+}
+
+void RadioInterface::removeFromTables(ZbDevice *device) {
+	if (this->zbDeviceIndex[device->data.id] == device)
+		this->zbDeviceIndex[device->data.id] = nullptr;
+	this->zbShortAddresses.remove(device->data.shortAddress, device);
+	this->zbLongAddresses.remove(device->data.longAddress, device);
+	auto endpoint = device->endpoints;
+	while (endpoint != nullptr) {
+		if (this->zbEndpointIndex[endpoint->data->id] == endpoint)
+			this->zbEndpointIndex[endpoint->data->id] = nullptr;
+		endpoint = endpoint->next;
+	}
+}
+
+RadioInterface::ZbDevice *RadioInterface::findZbDevice(uint16_t address) {
+	return this->zbShortAddresses.get(address);
 }
 
 void RadioInterface::allocateShortAddress() {
@@ -637,6 +787,32 @@ void RadioInterface::writeNwkBroadcastCommand(PacketWriter &w, zb::NwkCommand co
 	w.e8(command);
 }
 
+void RadioInterface::writeRouteRequest(PacketWriter &w, ZbDevice &device) {
+	// reset cost of route so that the route replies can overwrite the router
+	device.cost = 255;
+	device.routeRequested = true;
+	device.routeRequestTime = Timer::now();
+
+	// route request command
+	writeNwkBroadcastCommand(w, zb::NwkCommand::ROUTE_REQUEST);
+	w.e8(zb::NwkCommandRouteRequestOptions::DISCOVERY_SINGLE
+		| zb::NwkCommandRouteRequestOptions::EXTENDED_DESTINATION);
+
+	// route id
+	w.u8(this->routeCounter++);
+
+	// destination
+	w.u16L(device.data.shortAddress);
+
+	// path cost
+	w.u8(0);
+
+	// extended destination
+	w.u64L(device.data.longAddress);
+
+	writeFooter(w, Radio::SendFlags::NONE);
+}
+
 void RadioInterface::writeNwk(PacketWriter &w, zb::NwkFrameControl nwkFrameControl, uint8_t radius, ZbDevice &device) {
 	assert(device.routerAddress != 0xffff);
 
@@ -899,6 +1075,31 @@ void RadioInterface::writeApsAckZcl(PacketWriter &w, uint8_t dstEndpoint, zcl::C
 	w.u8(this->apsCounter++);
 }
 
+void RadioInterface::writeZclDefaultResponse(PacketWriter &w, ZbDevice &device, uint8_t dstEndpoint,
+	zcl::Cluster clusterId, zcl::Profile profile, uint8_t srcEndpoint, uint8_t zclCounter, uint8_t command)
+{
+	// nwk data
+	writeNwkData(w, device);
+
+	// aps data
+	writeApsDataZcl(w, dstEndpoint, clusterId, profile, srcEndpoint);
+
+	// zcl profile wide
+	w.e8(zcl::FrameControl::TYPE_PROFILE_WIDE
+		| zcl::FrameControl::DIRECTION_SERVER_TO_CLIENT
+		| zcl::FrameControl::DISABLE_DEFAULT_RESPONSE);
+	w.u8(zclCounter);
+	w.e8(zcl::Command::DEFAULT_RESPONSE);
+
+	// response to command
+	w.u8(command);
+
+	// success
+	w.u8(0);
+
+	writeFooter(w, device.sendFlags);
+}
+
 static void writeCommandHeader(RadioInterface::PacketWriter &w, uint8_t zclCounter) {
 	// zbee cluster library frame
 	w.e8(zcl::FrameControl::TYPE_CLUSTER_SPECIFIC
@@ -1092,6 +1293,135 @@ AwaitableCoroutine RadioInterface::readAttribute(uint8_t (&packet)[MESSAGE_LENGT
 	}
 }
 
+AwaitableCoroutine RadioInterface::configureReporting(uint8_t (&packet)[MESSAGE_LENGTH], ZbDevice &device,
+	ZbEndpoint &endpoint)
+{
+	uint64_t thisLongAddress = Radio::getLongAddress();
+	auto &data = *endpoint.data;
+	auto reports = endpoint.getReports();
+
+	// the status stays FAILURE for attributes whose configuration is not confirmed by the device
+	for (auto &report : reports)
+		report.reporting.status = zcl::Status::FAILURE;
+
+	for (int reportIndex = 0; reportIndex < reports.count(); ++reportIndex) {
+		// handle all reports of a cluster at once, the reports of a cluster are consecutive
+		auto cluster = reports[reportIndex].cluster;
+		if (reportIndex > 0 && reports[reportIndex - 1].cluster == cluster)
+			continue;
+
+		// bind cluster of device to our endpoint so that the device knows where to send the reports
+		uint8_t sendResult;
+		int length;
+		for (int retry = 0;; ++retry) {
+			uint8_t zdpCounter;
+			{
+				PacketWriter w(packet);
+
+				// nwk data
+				writeNwkData(w, device);
+
+				// zdp data
+				zdpCounter = writeApsDataZdp(w, zb::ZdpCommand::BIND_REQUEST);
+
+				// source
+				w.u64L(device.data.longAddress);
+				w.u8(data.deviceEndpoint);
+
+				// cluster
+				w.e16L(cluster);
+
+				// address mode: unicast
+				w.u8(3);
+
+				// destination
+				w.u64L(thisLongAddress);
+				w.u8(data.id);
+
+				writeFooter(w, device.sendFlags);
+			}
+			co_await Radio::send(RADIO_ZBEE, packet, sendResult);
+			if (sendResult != 0) {
+				// wait for a response from the device
+				int r = co_await select(this->responseBarrier.wait(length, packet, uint8_t(0), zdpCounter,
+					uint16_t(zb::ZdpCommand::BIND_RESPONSE)), Timer::sleep(timeout));
+
+				// check if response was received
+				if (r == 1)
+					break;
+			}
+			if (retry == MAX_RETRY)
+				co_return;
+		}
+
+		// configure reporting of all attributes of the cluster
+		uint8_t zclCounter = this->zclCounter++;
+		for (int retry = 0;; ++retry) {
+			{
+				PacketWriter w(packet);
+
+				// nwk data
+				writeNwkData(w, device);
+
+				// aps data
+				writeApsDataZcl(w, data.deviceEndpoint, cluster, zcl::Profile::HOME_AUTOMATION, data.id);
+
+				// zcl profile wide
+				w.e8(zcl::FrameControl::TYPE_PROFILE_WIDE
+					| zcl::FrameControl::DIRECTION_CLIENT_TO_SERVER
+					| zcl::FrameControl::DISABLE_DEFAULT_RESPONSE);
+				w.u8(zclCounter);
+				w.e8(zcl::Command::CONFIGURE_REPORTING);
+
+				// attribute reporting configuration records
+				for (int i = reportIndex; i < reports.count() && reports[i].cluster == cluster; ++i) {
+					auto &report = reports[i];
+					zcl::writeReportingConfiguration(w, report.attribute, report.type, report.reporting.minInterval,
+						report.reporting.maxInterval, report.reporting.reportableChange);
+				}
+
+				writeFooter(w, device.sendFlags);
+			}
+			co_await Radio::send(RADIO_ZBEE, packet, sendResult);
+			if (sendResult != 0) {
+				// wait for a response from the device
+				int r = co_await select(
+					this->responseBarrier.wait(length, packet, data.id, zclCounter,
+						uint16_t(zcl::Command::CONFIGURE_REPORTING_RESPONSE)), Timer::sleep(timeout));
+
+				// check if response was received
+				if (r == 1)
+					break;
+			}
+			if (retry == MAX_RETRY)
+				co_return;
+		}
+
+		// handle configure reporting response: set status of each attribute of the cluster
+		MessageReader r(length, packet);
+		for (int i = reportIndex; i < reports.count() && reports[i].cluster == cluster; ++i) {
+			auto &report = reports[i];
+			report.reporting.status = zcl::getReportingStatus(r, report.attribute);
+			if (report.reporting.status != zcl::Status::SUCCESS) {
+				Terminal::out << "configure reporting " << hex(uint16_t(cluster)) << ':' << hex(report.attribute)
+					<< " status " << hex(uint8_t(report.reporting.status)) << '\n';
+			}
+		}
+	}
+}
+
+AwaitableCoroutine RadioInterface::reconfigureReporting(uint8_t id) {
+	auto endpoint = getZbEndpoint(id);
+	if (endpoint == nullptr)
+		co_return;
+
+	uint8_t packet[MESSAGE_LENGTH];
+	co_await configureReporting(packet, *endpoint->device, *endpoint);
+
+	// write status to flash
+	this->storage.writeBlocking(STORAGE_ID_RADIO1 | id, endpoint->data->size(), endpoint->data);
+}
+
 template <typename T, int N>
 optional<T> getEnum8(uint8_t (&packet)[N]) {
 	MessageReader r(sizeof(packet), packet);
@@ -1236,6 +1566,64 @@ Coroutine RadioInterface::sendBeacon() {
 		co_await Timer::sleep(100ms);
 	}
 }
+
+Coroutine RadioInterface::refreshRoutes() {
+	uint8_t packet[64];
+	uint8_t sendResult;
+	int lastCount = 0;
+	while (true) {
+		co_await Timer::sleep(ROUTE_CHECK_INTERVAL);
+
+		// log statistics of the route cache
+		int count = this->routeHitCount + this->routeMissCount;
+		if (count != lastCount) {
+			lastCount = count;
+			Terminal::out << "Route cache hits: " << dec(this->routeHitCount) << " of " << dec(count) << '\n';
+		}
+
+		// send route requests, start again at the beginning of the list after each request because the list may
+		// change while sending
+		while (true) {
+			auto now = Timer::now();
+			auto device = this->zbDevices;
+			while (device != nullptr) {
+				bool known = device->routerAddress != 0xffff;
+				auto age = now - device->routeTime;
+
+				// drop outdated routes that also failed to deliver
+				if (known && age > ROUTE_MAX_AGE && device->failCount >= ROUTE_MAX_FAIL_COUNT) {
+					device->routerAddress = 0xffff;
+					known = false;
+				}
+
+				// only refresh routes of recently used devices
+				if (device->recentlyUsed && now - device->useTime > ROUTE_USE_TIME) {
+					device->recentlyUsed = false;
+					device->routeRequested = false;
+				}
+				if (device->recentlyUsed && (!known || age >= ROUTE_REFRESH_AGE)) {
+					// check if a route request is already pending
+					auto retryInterval = known ? ROUTE_REFRESH_AGE : ROUTE_RETRY_INTERVAL;
+					if (!device->routeRequested || now - device->routeRequestTime >= retryInterval)
+						break;
+				}
+				device = device->next;
+			}
+			if (device == nullptr)
+				break;
+
+			// send route request, the route reply gets handled in receive()
+			{
+				PacketWriter w(packet);
+				writeRouteRequest(w, *device);
+			}
+			co_await Radio::send(RADIO_ZBEE, packet, sendResult);
+
+			// "cool down" before the next route request
+			co_await Timer::sleep(100ms);
+		}
+	}
+}
 /*
 static bool handleZclCommand(MessageType dstType, void *dstMessage, int plugIndex, zcl::Cluster cluster,
 	MessageReader r, ConvertOptions const &convertOptions)
@@ -1297,19 +1685,65 @@ static bool handleZclCommand(MessageType dstType, void *dstMessage, int plugInde
 	return false;
 }*/
 
+void RadioInterface::handleZclReport(PacketReader &r, ZbEndpoint &endpoint, zcl::Cluster cluster) {
+	// attribute reports: attribute id, data type, value
+	while (r.getRemaining() >= 3) {
+		uint16_t attribute = r.u16L();
+		auto type = r.e8<zcl::DataType>();
+
+		// read value, stop at data types with unknown size as the following reports can't be found
+		int32_t value;
+		switch (type) {
+		case zcl::DataType::BOOL:
+		case zcl::DataType::UINT8:
+		case zcl::DataType::ENUM8:
+			value = r.u8();
+			break;
+		case zcl::DataType::INT8:
+			value = int8_t(r.u8());
+			break;
+		case zcl::DataType::UINT16:
+		case zcl::DataType::ENUM16:
+			value = r.u16L();
+			break;
+		case zcl::DataType::INT16:
+			value = r.i16L();
+			break;
+		default:
+			if (zcl::getSize(type) == 0)
+				return;
+			r.skip(zcl::getSize(type));
+			continue;
+		}
+		if (!r.isValid())
+			return;
+
+		// publish on the plug that was configured for the attribute during commissioning
+		auto report = endpoint.findReport(cluster, attribute);
+		auto reportDefault = findReportDefault(cluster, attribute);
+		if (report == nullptr || reportDefault == nullptr)
+			continue;
+		if (type == zcl::DataType::BOOL)
+			endpoint.publishSwitch(report->plugIndex, value);
+		else
+			endpoint.publishFloat(report->plugIndex, float(value) * reportDefault->scale + reportDefault->offset);
+	}
+}
+
 Coroutine RadioInterface::receive() {
-	auto lastSecurityCounter = this->securityCounter;
 	while (true) {
 		// store security counter if necessary
-		if (this->securityCounter != lastSecurityCounter) {
-			lastSecurityCounter = this->securityCounter;
+		{
 			Storage::Status status;
-			co_await this->counters.write(COUNTERS_ID_RADIO, 4, &this->securityCounter, status);
+			co_await this->securityCounter.store(status);
 		}
 
-		// wait until we receive a packet
-		Radio::Packet packet;
-		co_await Radio::receive(RADIO_ZBEE, packet);
+		// wait until we receive a packet, the buffer is also used to build responses
+		PacketBuffer buffer;
+		co_await Radio::receive(RADIO_ZBEE, buffer);
+		if (!buffer.makeWritable())
+			continue;
+		auto &packet = *reinterpret_cast<Radio::Packet *>(buffer.data());
 		PacketReader r(packet);
 
 		// ieee 802.15.4 mac
@@ -1375,85 +1809,88 @@ Terminal::out << "Beacon Request\n";
 					}
 
 					// search device
-					auto device = this->gpDevices;
-					while (device != nullptr) {
-						if (device->data->deviceId != deviceId) {
-							device = device->next;
-							continue;
-						}
-
-						// security
-						// --------
-						// header: header that is not encrypted, payload is part of header for security levels 0 and 1
-						// payload: payload that is encrypted, has zero length for security levels 0 and 1
-						// mic: message integrity code, 2 or 4 bytes
-						uint32_t securityCounter = 0;
-						int micLength;
-						switch (securityLevel) {
-							// todo: compare securityLevel with security level from commissioning
-						/*case gp::NwkExtendedFrameControl::SECURITY_LEVEL_CNT8_MIC16:
-							// security level 1: 1 byte counter, 2 byte mic
-
-							// header starts at mac sequence number and includes also payload
-							r.setHeader(mac + 2);
-
-							// use mac sequence number as security counter
-							securityCounter = mac[2];
-
-							// only decrypt message integrity code of length 2
-							micLength = 2;
-							r.setMessageFromEnd(micLength);
-							break;*/
-						case gp::NwkExtendedFrameControl::SECURITY_LEVEL_CNT32_MIC32:
-							// security level 2: 4 byte counter, 4 byte mic
-
-							// security counter
-							securityCounter = r.u32L();
-
-							// only decrypt message integrity code of length 4
-							micLength = 4;
-							r.setMessageFromEnd(micLength);
-							break;
-						case gp::NwkExtendedFrameControl::SECURITY_LEVEL_ENC_CNT32_MIC32:
-							// security level 3: 4 byte counter, encrypted message, 4 byte mic
+					auto device = this->gpDeviceIds.get(deviceId);
+					if (device == nullptr)
+						continue; // -> receive
 
-							// security counter
-							securityCounter = r.u32L();
+					// security
+					// --------
+					// header: header that is not encrypted, payload is part of header for security levels 0 and 1
+					// payload: payload that is encrypted, has zero length for security levels 0 and 1
+					// mic: message integrity code, 2 or 4 bytes
+					uint32_t securityCounter = 0;
+					int micLength;
+					switch (securityLevel) {
+						// todo: compare securityLevel with security level from commissioning
+					/*case gp::NwkExtendedFrameControl::SECURITY_LEVEL_CNT8_MIC16:
+						// security level 1: 1 byte counter, 2 byte mic
+
+						// header starts at mac sequence number and includes also payload
+						r.setHeader(mac + 2);
+
+						// use mac sequence number as security counter
+						securityCounter = mac[2];
+
+						// only decrypt message integrity code of length 2
+						micLength = 2;
+						r.setMessageFromEnd(micLength);
+						break;*/
+					case gp::NwkExtendedFrameControl::SECURITY_LEVEL_CNT32_MIC32:
+						// security level 2: 4 byte counter, 4 byte mic
+
+						// security counter
+						securityCounter = r.u32L();
+
+						// only decrypt message integrity code of length 4
+						micLength = 4;
+						r.setMessageFromEnd(micLength);
+						break;
+					case gp::NwkExtendedFrameControl::SECURITY_LEVEL_ENC_CNT32_MIC32:
+						// security level 3: 4 byte counter, encrypted message, 4 byte mic
 
-							// decrypt message and message integrity code of length 4
-							r.setMessage();
-							micLength = 4;
-							break;
-						default:
-							// security is required
-							break;
-						}
+						// security counter
+						securityCounter = r.u32L();
 
-						// check security counter
-						if (securityCounter <= device->securityCounter) {
-							Terminal::out << "GP: security counter error " << dec(securityCounter) << " <= " << dec(device->securityCounter) << '\n';
-							//break; // -> receive
-						} else {
-							//Terminal::out << "GP: security counter ok " << dec(securityCounter) << " > " << dec(device->securityCounter) << '\n';
-						}
-						device->securityCounter = securityCounter;
+						// decrypt message and message integrity code of length 4
+						r.setMessage();
+						micLength = 4;
+						break;
+					default:
+						// security is required
+						break;
+					}
 
-						// store security counter
-						Storage::Status status;
-						co_await this->counters.write(COUNTERS_ID_RADIO + device->data->counterId, 4, &securityCounter, status);
+					// drop copies of a frame that was already received (switches send each telegram several times)
+					// before spending time on storing the security counter and decryption
+					if (isGpDuplicate(deviceId, securityCounter)) {
+						++this->gpDuplicateCount;
+						continue; // -> receive
+					}
 
-						// check message integrity code or decrypt message, depending on security level
-						Nonce nonce(deviceId, securityCounter);
-						if (!r.decrypt(micLength, nonce, device->data->aesKey)) {
-							//printf("error while decrypting message!\n");
-							break; // -> receive
-						}
+					// check security counter
+					if (securityCounter <= device->securityCounter) {
+						Terminal::out << "GP: security counter error " << dec(securityCounter) << " <= " << dec(device->securityCounter) << '\n';
+						//continue; // -> receive
+					} else {
+						//Terminal::out << "GP: security counter ok " << dec(securityCounter) << " > " << dec(device->securityCounter) << '\n';
+					}
+					device->securityCounter = securityCounter;
 
-						handleGp(r, *device);
+					// store security counter
+					Storage::Status status;
+					co_await this->counters.write(COUNTERS_ID_RADIO + device->data->counterId, 4, &securityCounter, status);
 
-						// finished with device
-						break; // -> receive
+					// check message integrity code or decrypt message, depending on security level
+					Nonce nonce(deviceId, securityCounter);
+					if (!r.decrypt(micLength, nonce, device->data->aesKey)) {
+						//printf("error while decrypting message!\n");
+						continue; // -> receive
 					}
+
+					// only authentic frames enter the cache so that forged frames can't suppress the original
+					addGpFrame(deviceId, securityCounter);
+
+					handleGp(r, *device);
 				}
 			}
 			continue; // -> receive
@@ -1649,6 +2086,7 @@ Terminal::out << "Beacon Request\n";
 				device.sendFlags = router.data.sendFlags;
 				device.routerAddress = router.data.shortAddress;
 				device.cost = 255; // set maximum costs so that route replies can later overwrite the router
+				device.routeTime = Timer::now();
 			}
 
 			auto nwkFrameType = nwkFrameControl & zb::NwkFrameControl::TYPE_MASK;
@@ -1724,14 +2162,22 @@ Terminal::out << "Beacon Request\n";
 						// check if a node has answered our own route request
 						if (originatorAddress == 0x0000) {
 							ZbDevice *destination = findZbDevice(destinationAddress);
-							if (destination != nullptr /*&& cost < destination->cost*/) {
+							if (destination != nullptr && (cost < destination->cost || destination->routerAddress == 0xffff)) {
+								auto now = Timer::now();
+								if (destination->routeRequested) {
+									destination->routeRequested = false;
+									Terminal::out << "Route to " << hex(destinationAddress) << " discovered in "
+										<< dec((now - destination->routeRequestTime).value) << "ms\n";
+								}
 								destination->sendFlags = device.data.sendFlags;
 
 								// set the node as the router for the destination
 								destination->routerAddress = device.data.shortAddress;
 
-								// set cost of route
+								// set cost and age of route
 								destination->cost = cost;
+								destination->routeTime = now;
+								destination->failCount = 0;
 
 								// resume publisher
 								destination->routeBarrier.resumeFirst();
@@ -2144,6 +2590,32 @@ Terminal::out << "Beacon Request\n";
 			if (frameType == zcl::FrameControl::TYPE_PROFILE_WIDE) {
 				// profile wide commands such as "read attribute response"
 				uint8_t command = r.u8();
+
+				if (zcl::Command(command) == zcl::Command::REPORT_ATTRIBUTES) {
+					// lookup destination endpoint
+					auto endpoint = device.endpoints;
+					while (endpoint != nullptr && endpoint->data->id != dstEndpoint) {
+						endpoint = endpoint->next;
+					}
+					if (endpoint == nullptr)
+						continue;
+
+					// publish reported attributes to subscribers
+					handleZclReport(r, *endpoint, cluster);
+
+					// reply with default response
+					if ((frameControl & zcl::FrameControl::DISABLE_DEFAULT_RESPONSE) == 0) {
+						{
+							PacketWriter w(packet);
+							writeZclDefaultResponse(w, device, srcEndpoint, cluster, profile, dstEndpoint, zclCounter,
+								command);
+						}
+						uint8_t sendResult;
+						co_await Radio::send(RADIO_ZBEE, packet, sendResult);
+					}
+					continue;
+				}
+
 				uint8_t *response = r.current;
 				int length = min(r.getRemaining(), MESSAGE_LENGTH);
 
@@ -2261,33 +2733,12 @@ Terminal::out << "Beacon Request\n";
 */
 				// reply with default response
 				if (sendDefaultResponse) {
-					// cluster command (e.g. 'on' or 'off' for on/off cluster)
-					uint8_t command = r.u8();
-
-					// build default response packet
+					// build default response packet for the cluster command (e.g. 'on' or 'off' for on/off cluster),
+					// exchange source and destination endpoints
 					{
 						PacketWriter w(packet);
-
-						// nwk data
-						writeNwkData(w, device);
-
-						// aps data (exchange source and destination endpoints)
-						writeApsDataZcl(w, srcEndpoint, cluster, profile, dstEndpoint);
-
-						// zcl profile wide
-						w.e8(zcl::FrameControl::TYPE_PROFILE_WIDE
-							| zcl::FrameControl::DIRECTION_SERVER_TO_CLIENT
-							| zcl::FrameControl::DISABLE_DEFAULT_RESPONSE);
-						w.u8(zclCounter);
-						w.e8(zcl::Command::DEFAULT_RESPONSE);
-
-						// response to command
-						w.u8(command);
-
-						// success
-						w.u8(0);
-
-						writeFooter(w, device.sendFlags);
+						writeZclDefaultResponse(w, device, srcEndpoint, cluster, profile, dstEndpoint, zclCounter,
+							command);
 					}
 
 					// send packet
@@ -2299,6 +2750,21 @@ Terminal::out << "Beacon Request\n";
 	}
 }
 
+bool RadioInterface::isGpDuplicate(uint32_t deviceId, uint32_t securityCounter) const {
+	for (int i = 0; i < this->gpFrameCount; ++i) {
+		auto const &frame = this->gpFrameCache[i];
+		if (frame.deviceId == deviceId && frame.securityCounter == securityCounter)
+			return true;
+	}
+	return false;
+}
+
+void RadioInterface::addGpFrame(uint32_t deviceId, uint32_t securityCounter) {
+	this->gpFrameCache[this->gpFrameIndex] = {deviceId, securityCounter};
+	this->gpFrameIndex = (this->gpFrameIndex + 1) % GP_FRAME_CACHE_SIZE;
+	this->gpFrameCount = min(this->gpFrameCount + 1, GP_FRAME_CACHE_SIZE);
+}
+
 void RadioInterface::handleGp(PacketReader &r, GpDevice &device) {
 	int plugIndex = -1;
 	uint8_t message = 0;
@@ -2572,13 +3038,8 @@ void RadioInterface::handleGpCommission(uint32_t deviceId, PacketReader& r) {
 		return;
 
 	// check if device already exists
-	auto device = this->gpDevices;
-	while (device != nullptr) {
-		if (device->data->deviceId != deviceId) {
-			device = device->next;
-			continue;
-		}
-
+	auto device = this->gpDeviceIds.get(deviceId);
+	if (device != nullptr) {
 		// yes: only update security counter
 		device->securityCounter = securityCounter;
 		this->counters.writeBlocking(COUNTERS_ID_RADIO + device->data->counterId, 4, &securityCounter);
@@ -2616,14 +3077,7 @@ AwaitableCoroutine RadioInterface::handleZbCommission(uint64_t deviceLongAddress
 	uint64_t thisLongAddress = Radio::getLongAddress();
 
 	// find existing device if any
-	auto od = &this->zbDevices;
-	while (*od != nullptr) {
-		auto device = *od;
-		if (device->data.longAddress == deviceLongAddress)
-			break;
-		od = &device->next;
-	}
-	auto oldDevice = *od;
+	auto oldDevice = this->zbLongAddresses.get(deviceLongAddress);
 
 	// check if we are out of space for new devices
 	bool outOfDevices = oldDevice == nullptr && this->elementCount >= MAX_ELEMENT_COUNT;
@@ -2691,6 +3145,7 @@ AwaitableCoroutine RadioInterface::handleZbCommission(uint64_t deviceLongAddress
 
 	// set first hop
 	device->routerAddress = deviceData.shortAddress;
+	device->routeTime = Timer::now();
 
 	// send network key
 	for (int retry = 0; ; ++retry) {
@@ -2895,21 +3350,26 @@ AwaitableCoroutine RadioInterface::handleZbCommission(uint64_t deviceLongAddress
 			case zcl::Cluster::BASIC:
 				break;
 			case zcl::Cluster::POWER_CONFIGURATION:
-				if (powerSource == zcl::BasicPowerSourceType::BATTERY) {
-					builder.addPlug(MessageType::LEVEL_BATTERY_IN);
-					builder.addPlug(MessageType::PHYSICAL_VOLTAGE_MEASURED_LOW_IN);
-				}
+				// battery level and voltage get reported by the device
+				if (powerSource == zcl::BasicPowerSourceType::BATTERY)
+					builder.addReports(cluster);
 				break;
 			case zcl::Cluster::ON_OFF:
 				builder.addPlug(MessageType::BINARY_POWER_CMD_IN);
+				builder.addReports(cluster);
 				break;
 			case zcl::Cluster::LEVEL_CONTROL:
 				builder.addPlug(MessageType::LIGHTING_BRIGHTNESS_CMD_IN);
+				builder.addReports(cluster);
 				break;
 			case zcl::Cluster::COLOR_CONTROL:
 				builder.addPlug(MessageType::LIGHTING_COLOR_PARAMETER_CHROMATICITY_X_CMD_IN);
 				builder.addPlug(MessageType::LIGHTING_COLOR_PARAMETER_CHROMATICITY_Y_CMD_IN);
 				break;
+			case zcl::Cluster::THERMOSTAT:
+			case zcl::Cluster::TEMPERATURE_MEASUREMENT:
+				builder.addReports(cluster);
+				break;
 			default:;
 			}
 			builder.endClientCluster();
@@ -3015,6 +3475,9 @@ AwaitableCoroutine RadioInterface::handleZbCommission(uint64_t deviceLongAddress
 			Terminal::out << "bind response status " << dec(status) << '\n';
 		}
 
+		// let the device report attributes instead of polling them, the configuration is stored with the endpoint
+		co_await configureReporting(packet2, *device, *endpoint);
+
 		if (oldEndpoint != nullptr)
 			oldEndpoint = oldEndpoint->next;
 		else
@@ -3029,8 +3492,13 @@ AwaitableCoroutine RadioInterface::handleZbCommission(uint64_t deviceLongAddress
 
 	// delete old device
 	if (oldDevice != nullptr) {
-		// remove device from linked list
-		*od = oldDevice->next;
+		// remove device from linked list and lookup tables
+		auto od = &this->zbDevices;
+		while (*od != nullptr && *od != oldDevice)
+			od = &(*od)->next;
+		if (*od != nullptr)
+			*od = oldDevice->next;
+		removeFromTables(oldDevice);
 
 		// move subscribers from old to new endpoints
 		auto oldEndpoint = oldDevice->endpoints;
@@ -3067,6 +3535,7 @@ AwaitableCoroutine RadioInterface::handleZbCommission(uint64_t deviceLongAddress
 	// transfer ownership of new device to devices list
 	device->next = this->zbDevices;
 	this->zbDevices = device.ptr;
+	addToTables(device.ptr);
 	device.ptr = nullptr;
 
 	// allocate next short address and interface id
@@ -3081,164 +3550,144 @@ Coroutine RadioInterface::publish() {
 		Message message;
 		co_await this->publishBarrier.wait(info, &message);
 
-		// find destination device
-		auto device = this->zbDevices;
-		while (device != nullptr) {
-			auto endpoint = device->endpoints;
-			while (endpoint != nullptr) {
-				if (endpoint->data->id != info.elementId) {
-					endpoint = endpoint->next;
-					continue;
-				}
+		// find destination endpoint
+		auto endpoint = getZbEndpoint(info.elementId);
+		if (endpoint == nullptr)
+			continue;
+		auto device = endpoint->device;
 
-				// get endpoint info
-				auto plugIndex = info.plugIndex;
-				if (plugIndex >= endpoint->data->plugCount)
+		// get endpoint info
+		auto plugIndex = info.plugIndex;
+		if (plugIndex >= endpoint->data->plugCount)
+			continue;
+		auto messageType = endpoint->getPlugs()[plugIndex];
+		auto clusterInfo = endpoint->getClientCluster(plugIndex);
+
+		// check if it is an input
+		if (isInput(messageType)) {
+			// mark device as recently used so that its route gets refreshed in the background
+			device->useTime = Timer::now();
+			device->recentlyUsed = true;
+
+			// use the cached route or request the route if necessary
+			if (device->routerAddress != 0xffff)
+				++this->routeHitCount;
+			else
+				++this->routeMissCount;
+			for (int retry = 0; retry < MAX_RETRY; ++retry) {
+	//device->routerAddress = device->data.shortAddress;
+				if (device->routerAddress != 0xffff)
 					break;
-				auto messageType = endpoint->getPlugs()[plugIndex];
-				auto clusterInfo = endpoint->getClientCluster(plugIndex);
 
-				// check if it is an input
-				if (isInput(messageType)) {
-					// request the route if necessary
-					for (int retry = 0; retry < MAX_RETRY; ++retry) {
-	//device->routerAddress = device->data.shortAddress;
-						if (device->routerAddress != 0xffff)
-							break;
+				// build packet
+				{
+					PacketWriter w(packet);
+					writeRouteRequest(w, *device);
+				}
 
-						// reset cost of route
-						device->cost = 255;
+				// send packet
+				uint8_t sendResult;
+				co_await Radio::send(RADIO_ZBEE, packet, sendResult);
+				if (sendResult == 0)
+					continue;
 
-						// build packet
-						{
-							PacketWriter w(packet);
-							auto const &flash = *device;
+				// wait for first route reply or timeout (more route replies with lower cost may arrive later)
+				co_await select(device->routeBarrier.wait(), Timer::sleep(timeout));
 
-							// route request command
-							writeNwkBroadcastCommand(w, zb::NwkCommand::ROUTE_REQUEST);
-							w.e8(zb::NwkCommandRouteRequestOptions::DISCOVERY_SINGLE
-								| zb::NwkCommandRouteRequestOptions::EXTENDED_DESTINATION);
+				Terminal::out << "Router for " << hex(device->data.shortAddress) << ": " << hex(device->routerAddress)
+					<< '\n';
+			}
 
-							// route id
-							w.u8(this->routeCounter++);
+			// fail if route remains unknown
+			if (device->routerAddress == 0xffff) {
+				// todo: set device to failed state and notify failure
+				continue;
+			}
 
-							// destination
-							w.u16L(device->data.shortAddress);
+			// try to send
+			uint8_t zclCounter = this->zclCounter++;
+			//Terminal::out << "zcl counter " << dec(zclCounter) << " for cluster " << hex(clusterInfo.cluster) << '\n';
+			for (int retry = 0; retry <= MAX_RETRY; ++retry) {
+				// build packet
+				{
+					PacketWriter w(packet);
+					auto const &flash = *device;
 
-							// path cost
-							w.u8(0);
+					// nwk data (always use a new mac counter when retrying)
+					writeNwkData(w, *device);
 
-							// extended destination
-							w.u64L(device->data.longAddress);
+					// aps data
+					writeApsDataZcl(w, endpoint->data->deviceEndpoint, clusterInfo.cluster,
+						zcl::Profile::HOME_AUTOMATION, endpoint->data->id);
 
-							writeFooter(w, Radio::SendFlags::NONE);
+					int clusterPlugIndex = plugIndex - clusterInfo.plugs.offset;
+					if ((messageType & MessageType::CMD) == 0) {
+						// write attribute (maybe using a command if the attribute is read only)
+						if (!writeZclAttribute(w, zclCounter, clusterPlugIndex, clusterInfo.cluster, message)) {
+							// rejected
+							break;
+						}
+					} else {
+						// send command
+						if (!writeZclCommand(w, zclCounter, clusterPlugIndex, clusterInfo.cluster, message, endpoint)) {
+							// rejected
+							break;
 						}
-
-						// send packet
-						uint8_t sendResult;
-						co_await Radio::send(RADIO_ZBEE, packet, sendResult);
-						if (sendResult == 0)
-							continue;
-
-						// wait for first route reply or timeout (more route replies with lower cost may arrive later)
-						co_await select(device->routeBarrier.wait(), Timer::sleep(timeout));
-
-						Terminal::out << "Router for " << hex(device->data.shortAddress) << ": " << hex(device->routerAddress)
-							<< '\n';
-					}
-
-					// fail if route remains unknown
-					if (device->routerAddress == 0xffff) {
-						// todo: set device to failed state and notify failure
-						continue;
 					}
 
-					// try to send
-					uint8_t zclCounter = this->zclCounter++;
-					//Terminal::out << "zcl counter " << dec(zclCounter) << " for cluster " << hex(clusterInfo.cluster) << '\n';
-					for (int retry = 0; retry <= MAX_RETRY; ++retry) {
-						// build packet
-						{
-							PacketWriter w(packet);
-							auto const &flash = *device;
-
-							// nwk data (always use a new mac counter when retrying)
-							writeNwkData(w, *device);
-
-							// aps data
-							writeApsDataZcl(w, endpoint->data->deviceEndpoint, clusterInfo.cluster,
-								zcl::Profile::HOME_AUTOMATION, endpoint->data->id);
-
-							int clusterPlugIndex = plugIndex - clusterInfo.plugs.offset;
-							if ((messageType & MessageType::CMD) == 0) {
-								// write attribute (maybe using a command if the attribute is read only)
-								if (!writeZclAttribute(w, zclCounter, clusterPlugIndex, clusterInfo.cluster, message)) {
-									// rejected
-									break;
-								}
-							} else {
-								// send command
-								if (!writeZclCommand(w, zclCounter, clusterPlugIndex, clusterInfo.cluster, message, endpoint)) {
-									// rejected
-									break;
-								}
-							}
+					writeFooter(w, Radio::SendFlags::NONE);
+				}
 
-							writeFooter(w, Radio::SendFlags::NONE);
-						}
+				// store security counter if necessary
+				Storage::Status status;
+				co_await this->securityCounter.store(status);
+				//Terminal::out << "ZB store security counter " << dec(this->securityCounter) << '\n';
+
+				// send packet
+				uint8_t sendResult;
+				co_await Radio::send(RADIO_ZBEE, packet, sendResult);
+				if (sendResult == 0) {
+					// first hop did not acknowledge, refresh the route in the background if this happens repeatedly
+					if (device->failCount < ROUTE_MAX_FAIL_COUNT)
+						++device->failCount;
+					if (device->failCount >= ROUTE_MAX_FAIL_COUNT)
+						device->routeTime = Timer::now() - ROUTE_REFRESH_AGE;
+				} else {
+					device->failCount = 0;
 
-						// store security counter
-						Storage::Status status;
-						co_await this->counters.write(COUNTERS_ID_RADIO, 4, &this->securityCounter, status);
-						//Terminal::out << "ZB store security counter " << dec(this->securityCounter) << '\n';
+					// wait for a response from the device
+					int length;
+					int r = co_await select(this->responseBarrier.wait(length, packet, endpoint->data->id,
+						zclCounter, uint16_t(zcl::Command::DEFAULT_RESPONSE)), Timer::sleep(timeout));
 
-						// send packet
-						uint8_t sendResult;
-						co_await Radio::send(RADIO_ZBEE, packet, sendResult);
-						if (sendResult != 0) {
-							// wait for a response from the device
-							int length;
-							int r = co_await select(this->responseBarrier.wait(length, packet, endpoint->data->id,
-								zclCounter, uint16_t(zcl::Command::DEFAULT_RESPONSE)), Timer::sleep(timeout));
-
-							// check if response was received
-							if (r == 1) {
-								//Terminal::out << "Received default response\n";
-								MessageReader r(length, packet);
-								uint8_t responseToCommand = r.u8();
-								uint8_t status = r.u8();
-
-								// check status (0 = ok)
-								if (status == 0)
-									break;
-							}
-						}
+					// check if response was received
+					if (r == 1) {
+						//Terminal::out << "Received default response\n";
+						MessageReader r(length, packet);
+						uint8_t responseToCommand = r.u8();
+						uint8_t status = r.u8();
 
-						// retry
+						// check status (0 = ok)
+						if (status == 0)
+							break;
 					}
 				}
-				/*
-				// forward to subscribers
-				for (auto &subscriber : device.subscribers) {
-					if (subscriber.index == publisher.index) {
-						subscriber.barrier->resumeAll([&subscriber, &publisher] (Subscriber::Parameters &p) {
-							p.subscriptionIndex = subscriber.subscriptionIndex;
-
-							// convert to target unit and type and resume coroutine if conversion was successful
-							return convert(subscriber.messageType, p.message,
-								publisher.messageType, publisher.message);
-						});
-					}
-				}*/
 
-				// break because message was handled
-				break;
+				// retry
 			}
-
-			// break if message was handled, otherwise check next device
-			if (endpoint != nullptr)
-				break;
-			device = device->next;
 		}
+		/*
+		// forward to subscribers
+		for (auto &subscriber : device.subscribers) {
+			if (subscriber.index == publisher.index) {
+				subscriber.barrier->resumeAll([&subscriber, &publisher] (Subscriber::Parameters &p) {
+					p.subscriptionIndex = subscriber.subscriptionIndex;
+
+					// convert to target unit and type and resume coroutine if conversion was successful
+					return convert(subscriber.messageType, p.message,
+						publisher.messageType, publisher.message);
+				});
+			}
+		}*/
 	}
 }
@@ -4,11 +4,13 @@
 #include "SystemTime.hpp"
 #include <Configuration.hpp>
 #include <Radio.hpp>
+#include <PersistentCounter.hpp>
 #include <crypt.hpp>
 #include <zcl.hpp>
 #include <MessageReader.hpp>
 #include <MessageWriter.hpp>
 #include <Coroutine.hpp>
+#include <PointerHash.hpp>
 
 
 /**
@@ -53,9 +55,39 @@ public:
 	void listen(Listener &listener) override;
 	void erase(uint8_t id) override;
 
+	// reporting configuration of an attribute that a zbee device reports to a plug
+	struct Reporting {
+		// minimum and maximum reporting interval in seconds
+		uint16_t minInterval;
+		uint16_t maxInterval;
+
+		// minimum change of an analog attribute in units of the attribute that causes a report
+		uint16_t reportableChange;
+
+		// status of the last configure reporting, e.g. UNREPORTABLE_ATTRIBUTE if the device does not report it
+		zcl::Status status;
+	};
+
+	/**
+	 * Get the reporting configuration of a plug
+	 * @param id id of zbee endpoint
+	 * @param plugIndex index of plug
+	 * @return reporting configuration or nullptr if the plug is not reported by the device
+	 */
+	Reporting const *getReporting(uint8_t id, uint8_t plugIndex) const;
+
+	/**
+	 * Set the reporting configuration of a plug, gets stored and sent to the device
+	 * @param id id of zbee endpoint
+	 * @param plugIndex index of plug
+	 * @param reporting reporting configuration, the status is ignored
+	 */
+	void setReporting(uint8_t id, uint8_t plugIndex, Reporting const &reporting);
+
 private:
 	static constexpr int MAX_CLUSTER_COUNT = 32;
 	static constexpr int MAX_PLUG_COUNT = 64;
+	static constexpr int MAX_REPORT_COUNT = 16;
 	static constexpr int MESSAGE_LENGTH = 80;
 
 
@@ -95,11 +127,13 @@ private:
 
 	class GpDevice : public Element {
 	public:
-		// takes ownership of the data
+		// adds to linked list and lookup tables and takes ownership of the data
 		GpDevice(RadioInterface *interface, GpDeviceData *data)
 			: Element(data->id, interface->listeners), next(interface->gpDevices), data(data)
 		{
 			interface->gpDevices = this;
+			interface->gpDeviceIndex[data->id] = this;
+			interface->gpDeviceIds.set(data->deviceId, this);
 		}
 
 		~GpDevice();
@@ -168,7 +202,22 @@ private:
 		uint16_t routerAddress = 0xffff;
 
 		// cost of the route to the device
-		uint8_t cost;
+		uint8_t cost = 255;
+
+		// number of consecutive sends over the route that were not acknowledged by the first hop
+		uint8_t failCount = 0;
+
+		// a route request is pending, started at routeRequestTime
+		bool routeRequested = false;
+
+		// device was used recently (at useTime), therefore its route gets refreshed in the background
+		bool recentlyUsed = false;
+
+		// time when the route was discovered
+		SystemTime routeTime;
+
+		SystemTime routeRequestTime;
+		SystemTime useTime;
 
 		// barrier for waiting until a route is available
 		Barrier<> routeBarrier;
@@ -184,6 +233,20 @@ private:
 		PlugRange plugs;
 	};
 
+	// attribute that the device reports to one of our plugs (configured using zcl configure reporting)
+	struct ReportInfo {
+		zcl::Cluster cluster;
+		uint16_t attribute;
+
+		// reporting configuration of the plug
+		Reporting reporting;
+
+		zcl::DataType type;
+
+		// plug index the reported attribute gets published on
+		uint8_t plugIndex;
+	};
+
 	// zbee endpoint data that is stored in flash
 	struct ZbEndpointData : public DeviceData {
 		static constexpr int BUFFER_SIZE = 1024;
@@ -198,13 +261,17 @@ private:
 		uint8_t serverClusterCount;
 		uint8_t clientClusterCount;
 
-		// data buffer
+		// number of reported attributes (stored in the padding byte of data that was stored before reporting existed)
+		uint8_t reportCount;
+
+		// data buffer: plugs, cluster infos, report infos
 		uint32_t buffer[BUFFER_SIZE / 4];
 
 		int size() {
 			auto s1 = (this->plugCount * sizeof(MessageType) + 3) / 4;
 			auto s2 = ((this->serverClusterCount + this->clientClusterCount) * sizeof(ClusterInfo) + 3) / 4;
-			return offsetOf(ZbEndpointData, buffer[s1 + s2]);
+			auto s3 = (this->reportCount * sizeof(ReportInfo) + 3) / 4;
+			return offsetOf(ZbEndpointData, buffer[s1 + s2 + s3]);
 		}
 	};
 
@@ -232,6 +299,9 @@ private:
 				this->clientClusterIndex--;
 		}
 
+		// add plugs for the attributes of a cluster that the device reports
+		void addReports(zcl::Cluster cluster);
+
 		int size() const;
 		void build(ZbEndpointData *data);
 
@@ -239,15 +309,17 @@ private:
 		uint8_t plugCount = 0;
 		uint8_t serverClusterIndex = 0;
 		uint8_t clientClusterIndex = MAX_CLUSTER_COUNT - 1;
+		uint8_t reportCount = 0;
 		MessageType plugs[MAX_PLUG_COUNT];
 		ClusterInfo clusterInfos[MAX_CLUSTER_COUNT];
+		ReportInfo reportInfos[MAX_REPORT_COUNT];
 	};
 
 	class ZbEndpoint : public Element {
 	public:
-		// adds to linked list and takes ownership of the data
+		// adds to linked list of device and takes ownership of the data
 		ZbEndpoint(RadioInterface *interface, ZbDevice *device, ZbEndpointData *data)
-			: Element(data->id, interface->listeners), next(device->endpoints), data(data)
+			: Element(data->id, interface->listeners), next(device->endpoints), device(device), data(data)
 		{
 			device->endpoints = this;
 		}
@@ -258,11 +330,17 @@ private:
 		//Array<ClusterInfo const *> getServerClusters() const;
 		PlugRange findServerCluster(zcl::Cluster cluster) const;
 		ClusterInfo getClientCluster(int plugIndex) const;
+		Array<ReportInfo> getReports() const;
+		ReportInfo const *findReport(zcl::Cluster cluster, uint16_t attribute) const;
+		ReportInfo *findReport(uint8_t plugIndex) const;
 
 
 		// next endpoint in list
 		ZbEndpoint *next;
 
+		// device this endpoint belongs to
+		ZbDevice *device;
+
 		// endpoint data that is stored in flash
 		ZbEndpointData *data;
 
@@ -279,11 +357,23 @@ private:
 	ZbDevice *getOrLoadZbDevice(uint8_t deviceId);
 	//void eraseZbDevice(uint8_t deviceId);
 
+	// add a zbee device and its endpoints to the lookup tables or remove them
+	void addToTables(ZbDevice *device);
+	void removeFromTables(ZbDevice *device);
+
 	int elementCount = 0;
 	uint8_t elementIds[MAX_ELEMENT_COUNT];
 	GpDevice *gpDevices = nullptr;
 	ZbDevice *zbDevices = nullptr;
 
+	// lookup tables so that received frames and outgoing messages find their device without walking the lists
+	GpDevice *gpDeviceIndex[256] = {}; // element id -> green power device
+	ZbEndpoint *zbEndpointIndex[256] = {}; // element id -> zbee endpoint
+	ZbDevice *zbDeviceIndex[256] = {}; // device id -> zbee device
+	PointerHash<uint32_t, GpDevice, MAX_ELEMENT_COUNT * 2> gpDeviceIds; // green power device id -> device
+	PointerHash<uint16_t, ZbDevice, MAX_ELEMENT_COUNT * 2> zbShortAddresses; // short address -> zbee device
+	PointerHash<uint64_t, ZbDevice, MAX_ELEMENT_COUNT * 2> zbLongAddresses; // long address -> zbee device
+
 
 	// start the interface
 	//Coroutine start();
@@ -296,7 +386,7 @@ private:
 
 	// persistent counters
 	Storage &counters;
-	uint32_t securityCounter;
+	PersistentCounter securityCounter;
 
 	// volatile counters
 	uint8_t macCounter = 0;
@@ -414,6 +504,7 @@ private:
 	void writeIeeeData(PacketWriter &w, ZbDevice &device);
 
 	void writeNwkBroadcastCommand(PacketWriter &w, zb::NwkCommand command);
+	void writeRouteRequest(PacketWriter &w, ZbDevice &device);
 	void writeNwk(PacketWriter &w, zb::NwkFrameControl nwkFrameControl, uint8_t radius, ZbDevice &device);
 	void writeNwkCommand(PacketWriter &w, ZbDevice &device, zb::NwkCommand command) {
 		zb::NwkFrameControl nwkFrameControl = zb::NwkFrameControl::TYPE_COMMAND
@@ -454,9 +545,20 @@ private:
 		zcl::Cluster cluster, Message &message, ZbEndpoint *endpoint);
 	void writeFooter(PacketWriter &w, Radio::SendFlags sendFlags);
 
+	void writeZclDefaultResponse(PacketWriter &w, ZbDevice &device, uint8_t dstEndpoint, zcl::Cluster clusterId,
+		zcl::Profile profile, uint8_t srcEndpoint, uint8_t zclCounter, uint8_t command);
+
 	[[nodiscard]] AwaitableCoroutine readAttribute(uint8_t (&packet)[MESSAGE_LENGTH], ZbDevice &device,
 		uint8_t dstEndpoint, zcl::Cluster clusterId, zcl::Profile profile, uint8_t srcEndpoint, uint16_t attribute);
 
+	// bind the reported clusters of the device to our endpoint and configure reporting of their attributes, sets the
+	// status of each reported attribute
+	[[nodiscard]] AwaitableCoroutine configureReporting(uint8_t (&packet)[MESSAGE_LENGTH], ZbDevice &device,
+		ZbEndpoint &endpoint);
+
+	// configure reporting of a commissioned endpoint after its reporting configuration was changed
+	[[nodiscard]] AwaitableCoroutine reconfigureReporting(uint8_t id);
+
 
 	// coroutine that sends link status and many-to-one route request in a regular interval
 	Coroutine broadcast();
@@ -464,6 +566,13 @@ private:
 	// coroutine that sends a beacon on request
 	Coroutine sendBeacon();
 
+	// coroutine that refreshes routes to recently used devices before they age and drops outdated routes
+	Coroutine refreshRoutes();
+
+	// statistics of the route cache
+	int routeHitCount = 0;
+	int routeMissCount = 0;
+
 	// beacon coroutine waits on this barrier until a beacon request arrives
 	Barrier<> beaconBarrier;
 
@@ -475,10 +584,30 @@ private:
 	void handleGp(PacketReader &r, GpDevice &device);
 	void handleGpCommission(uint32_t deviceId, PacketReader& r);
 
+	// cache of recently received green power frames for dropping duplicates before decryption
+	bool isGpDuplicate(uint32_t deviceId, uint32_t securityCounter) const;
+	void addGpFrame(uint32_t deviceId, uint32_t securityCounter);
+	struct GpFrame {
+		uint32_t deviceId;
+		uint32_t securityCounter;
+	};
+	static constexpr int GP_FRAME_CACHE_SIZE = 8;
+	GpFrame gpFrameCache[GP_FRAME_CACHE_SIZE];
+	int gpFrameIndex = 0;
+
+	// number of valid entries in the cache, the cache gets filled from the start
+	int gpFrameCount = 0;
+
+	// number of duplicate frames that were dropped without decryption
+	int gpDuplicateCount = 0;
+
 	//void handleAps(PacketReader &r, ZbDevice &device, uint8_t const *extendedSource);
 	//void handleZdp(PacketReader &r, ZbDevice &device);
 	void handleZcl(PacketReader &r, ZbDevice &device, uint8_t destinationEndpoint);
 
+	// publish the attributes of a report attributes command to the plugs of the endpoint
+	static void handleZclReport(PacketReader &r, ZbEndpoint &endpoint, zcl::Cluster cluster);
+
 	// coroutine for handling association requests from new devices
 	[[nodiscard]] AwaitableCoroutine handleZbCommission(uint64_t deviceAddress, Radio::SendFlags sendFlags);
 
@@ -489,6 +618,7 @@ private:
 	bool commissioning = false;
 
 	AwaitableCoroutine commissionCoroutine;
+	AwaitableCoroutine reportingCoroutine;
 	ZbDevice *tempDevice;
 
 
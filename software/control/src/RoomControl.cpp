@@ -149,36 +149,11 @@ RoomControl::RoomControl(Drivers &drivers)
 
 	applyConfiguration();
 
-	// load connections
-	for (uint8_t interfaceIndex = 0; interfaceIndex < INTERFACE_COUNT; ++interfaceIndex) {
-		// iterate over all devices in the interface
-		auto &interface = *this->interfaces[interfaceIndex];
-		auto deviceIds = interface.getElementIds();
-		for (auto deviceId: deviceIds) {
-			// storage id is generated from interface index and device id
-			int const storageId = STORAGE_ID_CONNECTION | (interfaceIndex << 8) | deviceId;
-
-			// determine size
-			int size = drivers.storage.getSizeBlocking(storageId);
-			uint8_t count = size / sizeof(Connection);
-			if (count == 0)
-				continue;
-
-			// allocate and read connection data
-			auto connectionData = reinterpret_cast<Connection *>(malloc(size));
-			drivers.storage.readBlocking(storageId, size, connectionData);
-
-			// allocate subscribers
-			auto subscribers = new Subscriber[count];
-
-			// create new connections for the device
-			auto connections = new Connections{this->connectionsList, interfaceIndex, deviceId, count,
-				connectionData, subscribers};
-			this->connectionsList = connections;
+	// time stamps for the flight recorder
+	FlightRecorder::clock = []() {return Timer::now().value;};
 
-			connect(connections);
-		}
-	}
+	// load connections
+	loadConnections();
 
 	// load display listeners
 	for (uint8_t interfaceIndex = 0; interfaceIndex < INTERFACE_COUNT; ++interfaceIndex) {
@@ -260,11 +235,13 @@ void RoomControl::connect(Connections *connections) {
 
 		// initialize subscriber
 		subscriber.data = data;
+		subscriber.interfaceId = connections->interfaceIndex;
 		subscriber.elementId = connections->elementId;
 		subscriber.connectionIndex = connectionIndex;
 		subscriber.target = interface.getSubscriberTarget(connections->elementId, data->destination.plugIndex);
+		subscriber.converter.init(subscriber.target.type, data->convertOptions);
 
-		// subscribe
+		// subscribe, the dispatch table of the source element gets rebuilt on the next publish
 		if (data->source.interfaceId < INTERFACE_COUNT) {
 			auto &sourceInterface = *this->interfaces[data->source.interfaceId];
 			sourceInterface.subscribe(subscriber);
@@ -272,6 +249,85 @@ void RoomControl::connect(Connections *connections) {
 	}
 }
 
+void RoomControl::loadConnections() {
+	// header of the connections of one element in the arena
+	struct Header {
+		uint16_t storageId;
+		uint16_t count;
+	};
+
+	// read connections of all interfaces in one pass over the storage into an arena, each preceded by a header
+	uint8_t *arena = nullptr;
+	int arenaSize = 0;
+	int arenaCapacity = 0;
+	int elementCount = 0;
+	int totalCount = 0;
+	this->storage.visitBlocking(STORAGE_ID_CONNECTION, 0xf000, [&](int storageId, int size) -> void * {
+		// storage id is generated from interface index and element id
+		int interfaceIndex = (storageId >> 8) & 0x0f;
+		uint8_t elementId = storageId;
+		int count = size / sizeof(Connection);
+		if (interfaceIndex >= INTERFACE_COUNT || count == 0)
+			return nullptr;
+
+		// skip orphaned connections of elements that do not exist
+		bool found = false;
+		for (auto id : this->interfaces[interfaceIndex]->getElementIds()) {
+			if (id == elementId) {
+				found = true;
+				break;
+			}
+		}
+		if (!found)
+			return nullptr;
+
+		// grow arena if necessary
+		int entrySize = sizeof(Header) + count * sizeof(Connection);
+		if (arenaSize + entrySize > arenaCapacity) {
+			arenaCapacity = max(arenaCapacity * 2, arenaSize + entrySize);
+			arena = reinterpret_cast<uint8_t *>(realloc(arena, arenaCapacity));
+		}
+
+		auto header = reinterpret_cast<Header *>(arena + arenaSize);
+		header->storageId = storageId;
+		header->count = count;
+		arenaSize += entrySize;
+		++elementCount;
+		totalCount += count;
+
+		// read connection data behind the header
+		return header + 1;
+	});
+	if (elementCount == 0) {
+		free(arena);
+		return;
+	}
+
+	// shrink arena to its final size so that it does not move any more
+	arena = reinterpret_cast<uint8_t *>(realloc(arena, arenaSize));
+
+	// allocate subscribers and lists of connections for all elements at once
+	auto subscribers = new Subscriber[totalCount];
+	auto connectionsArray = new Connections[elementCount];
+
+	// create and connect connections
+	int offset = 0;
+	for (int i = 0; i < elementCount; ++i) {
+		auto header = reinterpret_cast<Header *>(arena + offset);
+		auto data = reinterpret_cast<Connection *>(header + 1);
+		uint8_t count = header->count;
+
+		auto connections = &connectionsArray[i];
+		*connections = {this->connectionsList, uint8_t((header->storageId >> 8) & 0x0f), uint8_t(header->storageId),
+			count, data, subscribers, true};
+		this->connectionsList = connections;
+		connect(connections);
+
+		subscribers += count;
+		offset += sizeof(Header) + count * sizeof(Connection);
+	}
+}
+
 RoomControl::TempConnections RoomControl::getConnections(uint8_t interfaceIndex, uint8_t deviceId) {
 	TempConnections tc;
 	auto p = &this->connectionsList;
@@ -307,21 +363,32 @@ void RoomControl::writeConnections(uint8_t interfaceIndex, uint8_t deviceId, Tem
 		auto subscribers = new Subscriber[count];
 
 		// create new connections
-		connections = new Connections{this->connectionsList, interfaceIndex, deviceId, count, connectionData, subscribers};
+		connections = new Connections{this->connectionsList, interfaceIndex, deviceId, count, connectionData, subscribers,
+			false};
 		this->connectionsList = connections;
 	} else {
 		// existing connections
 		connections = *tc.p;
 
 		if (count != connections->count) {
-			connections->count = count;
-
-			// reallocate connection data
-			connections->data = reinterpret_cast<Connection *>(realloc(connections->data, size));
+			if (connections->inArena) {
+				// unsubscribe and leave data and subscribers in the arena
+				for (int i = 0; i < connections->count; ++i)
+					connections->subscribers[i].remove();
+
+				// allocate connection data and subscribers
+				connections->data = reinterpret_cast<Connection *>(malloc(size));
+				connections->subscribers = new Subscriber[count];
+				connections->inArena = false;
+			} else {
+				// reallocate connection data
+				connections->data = reinterpret_cast<Connection *>(realloc(connections->data, size));
 
-			// reallocate subscribers
-			delete [] connections->subscribers;
-			connections->subscribers = new Subscriber[count];
+				// reallocate subscribers
+				delete [] connections->subscribers;
+				connections->subscribers = new Subscriber[count];
+			}
+			connections->count = count;
 		}
 	}
 
@@ -344,11 +411,17 @@ void RoomControl::eraseConnections(uint8_t interfaceIndex, uint8_t deviceId, Tem
 	// remove from linked list
 	*tc.p = connections->next;
 
-	// delete connection data
-	free(connections->data);
+	if (connections->inArena) {
+		// unsubscribe and leave data and subscribers in the arena
+		for (int i = 0; i < connections->count; ++i)
+			connections->subscribers[i].remove();
+	} else {
+		// delete connection data
+		free(connections->data);
 
-	// delete subscribers (automatically unsubscribe themselves)
-	delete [] connections->subscribers;
+		// delete subscribers (automatically unsubscribe themselves)
+		delete [] connections->subscribers;
+	}
 
 	// erase from flash
 	int const storageId = STORAGE_ID_CONNECTION | (interfaceIndex << 8) | deviceId;
@@ -1232,6 +1305,8 @@ AwaitableCoroutine RoomControl::mainMenu() {
 			co_await alarmsMenu();
 		if (menu.entry("Functions"))
 			co_await functionsMenu();
+		if (menu.entry("Flight Recorder"))
+			co_await flightRecorderMenu();
 		if (menu.entry("Exit"))
 			break;
 
@@ -1296,6 +1371,8 @@ AwaitableCoroutine RoomControl::deviceMenu(int interfaceIndex, uint8_t id) {
 			co_await connectionsMenu(interface.getPlugs(id), tempConnections);
 		if (menu.entry("Plugs"))
 			co_await plugsMenu(interface, id, tempDisplaySources);
+		if (interfaceIndex == RADIO_INTERFACE && menu.entry("Reporting"))
+			co_await reportingMenu(id);
 		if (menu.entry("Message Logger"))
 			co_await messageLogger(interface, id);
 		if (menu.entry("Message Generator"))
@@ -2239,6 +2316,79 @@ AwaitableCoroutine RoomControl::plugsMenu(Interface &interface, uint8_t deviceId
 	}
 }
 
+AwaitableCoroutine RoomControl::reportingMenu(uint8_t deviceId) {
+	Menu menu(this->decoder, this->swapChain);
+	while (true) {
+		// list the plugs that are reported by the device
+		auto plugs = this->radioInterface.getPlugs(deviceId);
+		for (int plugIndex = 0; plugIndex < plugs.count(); ++plugIndex) {
+			auto reporting = this->radioInterface.getReporting(deviceId, plugIndex);
+			if (reporting == nullptr)
+				continue;
+			auto stream = menu.stream();
+			stream << dec(plugIndex) << ": " << getTypeLabel(plugs[plugIndex]);
+			if (reporting->status != zcl::Status::SUCCESS)
+				stream << " Error " << hex(uint8_t(reporting->status));
+			if (menu.entry())
+				co_await reportingMenu(deviceId, plugIndex);
+		}
+		menu.line();
+		if (menu.entry("Exit"))
+			break;
+
+		// show menu
+		co_await menu.show();
+	}
+}
+
+AwaitableCoroutine RoomControl::reportingMenu(uint8_t deviceId, uint8_t plugIndex) {
+	auto r = this->radioInterface.getReporting(deviceId, plugIndex);
+	if (r == nullptr)
+		co_return;
+	auto reporting = *r;
+
+	Menu menu(this->decoder, this->swapChain);
+	while (true) {
+		int delta = menu.getDelta();
+		{
+			bool edit = menu.getEdit(1) == 1;
+			if (edit)
+				reporting.minInterval = clamp(reporting.minInterval + delta, 0, 3600);
+			auto stream = menu.stream();
+			stream << "Min Interval " << underline(dec(reporting.minInterval), edit) << 's';
+			menu.entry();
+		}
+		{
+			// 0xffff disables periodic reports
+			bool edit = menu.getEdit(1) == 1;
+			if (edit)
+				reporting.maxInterval = clamp(reporting.maxInterval + delta * 10, 0, 0xffff);
+			auto stream = menu.stream();
+			stream << "Max Interval " << underline(dec(reporting.maxInterval), edit) << 's';
+			menu.entry();
+		}
+		{
+			// minimum change in units of the attribute, e.g. 1/100 Celsius for a temperature
+			bool edit = menu.getEdit(1) == 1;
+			if (edit)
+				reporting.reportableChange = clamp(reporting.reportableChange + delta, 0, 0xffff);
+			auto stream = menu.stream();
+			stream << "Reportable Change " << underline(dec(reporting.reportableChange), edit);
+			menu.entry();
+		}
+		if (menu.entry("Cancel"))
+			break;
+		if (menu.entry("Save")) {
+			// store and send to the device
+			this->radioInterface.setReporting(deviceId, plugIndex, reporting);
+			break;
+		}
+
+		// show menu
+		co_await menu.show();
+	}
+}
+
 AwaitableCoroutine RoomControl::messageLogger(Interface &interface, uint8_t deviceId) {
 	ListenerBarrier barrier;
 
@@ -2285,6 +2435,61 @@ AwaitableCoroutine RoomControl::messageLogger(Interface &interface, uint8_t devi
 	}
 }
 
+AwaitableCoroutine RoomControl::flightRecorderMenu() {
+	Menu menu(this->decoder, this->swapChain);
+#ifdef PLATFORM_POSIX
+	// result of the last save to file: 0 not saved yet, 1 saved, -1 failed
+	int saveResult = 0;
+#endif
+	while (true) {
+		menu.stream() << dec(FlightRecorder::getCount()) << " Records";
+		menu.label();
+		menu.line();
+		if (menu.entry("Dump to Terminal"))
+			FlightRecorder::dump(Terminal::out);
+#ifdef PLATFORM_POSIX
+		if (menu.entry("Save to File"))
+			saveResult = FlightRecorder::save(FlightRecorder::FILE_NAME) ? 1 : -1;
+		if (saveResult != 0) {
+			menu.stream() << (saveResult > 0 ? "Saved to " : "Save failed: ") << str(FlightRecorder::FILE_NAME);
+			menu.label();
+		}
+#endif
+		if (menu.entry("Clear"))
+			FlightRecorder::clear();
+		if (menu.entry("Exit"))
+			break;
+
+		// show menu and update record count until timeout
+		co_await select(menu.show(), Timer::sleep(250ms));
+	}
+}
+
+Coroutine RoomControl::replay(Array<FlightRecorder::Record const> records, int speed) {
+	if (records.count() == 0)
+		co_return;
+	auto start = Timer::now();
+	uint32_t startTime = records[0].time;
+	for (auto &record : records) {
+		// wait until the time of the record relative to the first record, accelerated by speed
+		co_await Timer::sleep(start + SystemDuration{int32_t((record.time - startTime) / speed)});
+		if (record.interfaceId >= INTERFACE_COUNT)
+			continue;
+
+		// deliver the recorded message to the destination plug
+		auto target = this->interfaces[record.interfaceId]->getSubscriberTarget(record.elementId, record.plugIndex);
+		if (target.barrier == nullptr)
+			continue;
+		target.barrier->resumeFirst([&record](SubscriberParameters &p) {
+			p.info.connectionIndex = record.connectionIndex;
+			p.info.elementId = record.elementId;
+			p.info.plugIndex = record.plugIndex;
+			*reinterpret_cast<Message *>(p.message) = record.message;
+			return true;
+		});
+	}
+}
+
 static int getComponentCount(MessageType messageType) {
 	return (messageType & MessageType::CATEGORY) == MessageType::LIGHTING ? 2 : 1;
 }
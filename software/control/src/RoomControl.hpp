@@ -8,6 +8,7 @@
 #include "SwapChain.hpp"
 #include "Menu.hpp"
 #include <MqttSnBroker.hpp> // include at first because of strange compiler error
+#include <FlightRecorder.hpp>
 #include <ClockTime.hpp>
 #include <Coroutine.hpp>
 #include <StringBuffer.hpp>
@@ -32,6 +33,13 @@ public:
 
 	~RoomControl();
 
+	/**
+	 * Replay recorded message deliveries of the flight recorder, e.g. in the emulator for profiling
+	 * @param records records, must stay valid until the replay has finished
+	 * @param speed speed factor, 1 for original speed
+	 */
+	Coroutine replay(Array<FlightRecorder::Record const> records, int speed);
+
 
 
 
@@ -85,6 +93,9 @@ public:
 		uint8_t count;
 		Connection *data;
 		Subscriber *subscribers;
+
+		// true if data and subscribers are part of the arena that gets allocated when loading on startup
+		bool inArena;
 	};
 
 	// temporary list of connections to one destination device, used while editing
@@ -106,6 +117,7 @@ public:
 		}
 	};
 
+	void loadConnections();
 	void connect(Connections *connections);
 	TempConnections getConnections(uint8_t interfaceIndex, uint8_t deviceId);
 	void writeConnections(uint8_t interfaceIndex, uint8_t deviceId, TempConnections &tc);
@@ -258,7 +270,10 @@ public:
 
 	// helpers
 	[[nodiscard]] AwaitableCoroutine plugsMenu(Interface &interface, uint8_t deviceId, TempDisplaySources &tempDisplaySources);
+	[[nodiscard]] AwaitableCoroutine reportingMenu(uint8_t deviceId);
+	[[nodiscard]] AwaitableCoroutine reportingMenu(uint8_t deviceId, uint8_t plugIndex);
 	[[nodiscard]] AwaitableCoroutine messageLogger(Interface &interface, uint8_t deviceId);
 	[[nodiscard]] AwaitableCoroutine messageGenerator(Interface &interface, uint8_t deviceId);
+	[[nodiscard]] AwaitableCoroutine flightRecorderMenu();
 
 };
@@ -4,6 +4,9 @@
 AwaitableCoroutine SSD1309::init() {
 	uint8_t command[2];
 
+	// content of display ram is unknown
+	this->shownValid = false;
+
 	// command unlock
 	command[0] = 0xFD;
 	command[1] = 0x12;
@@ -28,6 +31,11 @@ AwaitableCoroutine SSD1309::init() {
 	command[1] = 0x00;
 	co_await this->spi.writeCommand(2, command);
 
+	// set memory addressing mode to horizontal for set() and update()
+	command[0] = 0x20;
+	command[1] = 0x00;
+	co_await this->spi.writeCommand(2, command);
+
 	// set display start line
 	command[0] = 0x40;
 	co_await this->spi.writeCommand(1, command);
@@ -87,3 +95,59 @@ AwaitableCoroutine SSD1309::setContrast(uint8_t contrast) {
 	uint8_t command[2] = {0x81, contrast};
 	co_await this->spi.writeCommand(2, command);
 }
+
+AwaitableCoroutine SSD1309::set(Bitmap<DISPLAY_WIDTH, DISPLAY_HEIGHT> const &bitmap) {
+	constexpr int PAGE_COUNT = DISPLAY_HEIGHT / 8;
+
+	// transfer whole bitmap
+	co_await setWindow(0, DISPLAY_WIDTH - 1, 0, PAGE_COUNT - 1);
+	co_await this->spi.writeData(array::count(bitmap.data), bitmap.data);
+	this->transferCount += array::count(this->windowCommand) + array::count(bitmap.data);
+
+	// keep a copy of the display content
+	this->shown.copy(bitmap);
+	this->shownValid = true;
+}
+
+AwaitableCoroutine SSD1309::update(Bitmap<DISPLAY_WIDTH, DISPLAY_HEIGHT> const &bitmap) {
+	constexpr int PAGE_COUNT = DISPLAY_HEIGHT / 8;
+
+	if (!this->shownValid) {
+		co_await set(bitmap);
+		co_return;
+	}
+
+	for (int page = 0; page < PAGE_COUNT; ++page) {
+		auto data = bitmap.data + page * DISPLAY_WIDTH;
+		auto shown = this->shown.data + page * DISPLAY_WIDTH;
+
+		// find changed column range
+		int column1 = 0;
+		while (column1 < DISPLAY_WIDTH && data[column1] == shown[column1])
+			++column1;
+		if (column1 == DISPLAY_WIDTH)
+			continue;
+		int column2 = DISPLAY_WIDTH - 1;
+		while (data[column2] == shown[column2])
+			--column2;
+		int count = column2 - column1 + 1;
+
+		// transfer changed column range
+		co_await setWindow(column1, column2, page, page);
+		co_await this->spi.writeData(count, data + column1);
+		this->transferCount += array::count(this->windowCommand) + count;
+
+		array::copy(count, shown + column1, data + column1);
+	}
+}
+
+Awaitable<SpiMaster::Parameters> SSD1309::setWindow(int column1, int column2, int page1, int page2) {
+	auto &command = this->windowCommand;
+	command[0] = 0x21;
+	command[1] = column1;
+	command[2] = column2;
+	command[3] = 0x22;
+	command[4] = page1;
+	command[5] = page2;
+	return this->spi.writeCommand(array::count(command), command);
+}
@@ -48,11 +48,30 @@ public:
 	 * @param bitmap bitmap to display
 	 * @return use co_await on return value to await end of operation
 	 */
-	auto set(Bitmap<DISPLAY_WIDTH, DISPLAY_HEIGHT> const &bitmap) {
-		return this->spi.writeData(array::count(bitmap.data), bitmap.data);
-	}
+	[[nodiscard]] AwaitableCoroutine set(Bitmap<DISPLAY_WIDTH, DISPLAY_HEIGHT> const &bitmap);
+
+	/**
+	 * Update content of display. Only the changed column range of each page (8 rows) gets transferred, the whole
+	 * display is transferred if the current content is not known, e.g. after init()
+	 * @param bitmap bitmap to display, must not be modified until the operation ends
+	 * @return use co_await on return value to await end of operation
+	 */
+	[[nodiscard]] AwaitableCoroutine update(Bitmap<DISPLAY_WIDTH, DISPLAY_HEIGHT> const &bitmap);
+
+	// statistics: number of bytes (commands and data) transferred by set() and update()
+	int transferCount = 0;
 
 protected:
+	// set column and page window of the display ram, data wraps around inside the window
+	[[nodiscard]] Awaitable<SpiMaster::Parameters> setWindow(int column1, int column2, int page1, int page2);
+
 	SpiMaster &spi;
 	bool enabled = false;
+
+	// content of display ram
+	Bitmap<DISPLAY_WIDTH, DISPLAY_HEIGHT> shown;
+	bool shownValid = false;
+
+	// buffer for window command
+	uint8_t windowCommand[6];
 };
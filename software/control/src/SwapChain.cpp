@@ -49,8 +49,8 @@ Coroutine SwapChain::transfer() {
 			auto bitmap = this->showList;
 			this->showList = nullptr;
 			
-			// transfer bitmap to display (a new bitmap can be added to the render list while waiting)
-			co_await this->display.set(*bitmap);
+			// transfer changed parts of bitmap to display (a new bitmap can be added to the render list while waiting)
+			co_await this->display.update(*bitmap);
 			
 			// but bitmap back to free list
 			put(bitmap);
@@ -7,10 +7,16 @@
 #include <Debug.hpp>
 #include <Loop.hpp>
 #include <Sound.hpp>
+#include <convert.hpp>
 
 
 /**
- * Emulator main, start without parameters
+ * Emulator main, start without parameters or with a recording of the flight recorder to replay:
+ * control [<recording> [<speed>]]
+ * On exit the flight recorder gets saved to flightRecorder.rec which can be replayed in the same way. This is skipped
+ * after a replay so that the replayed recording does not get overwritten.
+ * Without a radio connected via USB, the simulated radio medium can be configured by environment variables, see
+ * emu/Radio.cpp (e.g. RADIO_LIGHTS=100 control)
  */
 int main(int argc, const char **argv) {
 	// init drivers
@@ -47,7 +53,25 @@ int main(int argc, const char **argv) {
 	// the room control application
 	RoomControl roomControl(drivers);
 
+	// replay a recording of the flight recorder, optionally accelerated
+	FlightRecorder::Record *records = nullptr;
+	if (argc >= 2) {
+		int count = FlightRecorder::load(argv[1], records);
+		if (count < 0) {
+			Terminal::err << "error: can't load recording " << argv[1] << '\n';
+			return 1;
+		}
+		int speed = argc >= 3 ? parseInt(String(argv[2])).get(1) : 1;
+		roomControl.replay(Array<FlightRecorder::Record const>(count, records), max(speed, 1));
+	}
+
 	Loop::run();
 
+	// save the flight recorder so that the last message deliveries can be inspected or replayed, not after a replay
+	if (records == nullptr && !FlightRecorder::save(FlightRecorder::FILE_NAME))
+		Terminal::err << "error: can't save recording " << FlightRecorder::FILE_NAME << '\n';
+
+	delete [] records;
+
 	return 0;
 }
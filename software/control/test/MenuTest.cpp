@@ -0,0 +1,195 @@
+#include "MenuReference.hpp"
+#include <Menu.hpp>
+#include <Input.hpp>
+#include <StringOperators.hpp>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+
+/*
+	Test for the retained rendering of Menu: A menu coroutine gets driven by random wheel and button events, covering
+	scrolling, sections, dividers, markup and activation. After each event the display RAM is compared byte for byte
+	to the display RAM of the reference implementation that draws each frame immediately.
+*/
+
+constexpr int STEP_COUNT = 3000;
+
+// SPI master that emulates the display RAM of the SSD1309 in horizontal addressing mode
+class DisplayMock : public SpiMaster {
+public:
+	Awaitable<Parameters> transfer(int writeCount, void const *writeData, int readCount, void *readData) override {
+		return {this->waitlist, nullptr, writeCount, writeData, readCount, readData};
+	}
+
+	void transferBlocking(int writeCount, void const *writeData, int readCount, void *readData) override {
+		bool command = writeCount < 0;
+		int count = writeCount & 0x7fffffff;
+		auto data = reinterpret_cast<uint8_t const *>(writeData);
+		this->transferCount += count;
+		if (command) {
+			for (int i = 0; i < count; ++i) {
+				switch (data[i]) {
+				case 0x21:
+					// set column address
+					this->column = this->column1 = data[i + 1];
+					this->column2 = data[i + 2];
+					i += 2;
+					break;
+				case 0x22:
+					// set page address
+					this->page = this->page1 = data[i + 1];
+					this->page2 = data[i + 2];
+					i += 2;
+					break;
+				case 0x20: case 0x81: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB: case 0xFD:
+					// commands with one parameter
+					++i;
+					break;
+				}
+			}
+		} else {
+			for (int i = 0; i < count; ++i) {
+				this->ram[this->page * DISPLAY_WIDTH + this->column] = data[i];
+				if (this->column == this->column2) {
+					this->column = this->column1;
+					this->page = this->page == this->page2 ? this->page1 : this->page + 1;
+				} else {
+					++this->column;
+				}
+			}
+		}
+	}
+
+	// complete all pending transfers
+	void run() {
+		while (!this->waitlist.isEmpty()) {
+			this->waitlist.resumeFirst([this](Parameters &p) {
+				transferBlocking(p.writeCount, p.writeData, p.readCount, p.readData);
+				return true;
+			});
+		}
+	}
+
+	Waitlist<Parameters> waitlist;
+	uint8_t ram[DISPLAY_WIDTH * DISPLAY_HEIGHT / 8] = {};
+	int column1 = 0;
+	int column2 = DISPLAY_WIDTH - 1;
+	int page1 = 0;
+	int page2 = DISPLAY_HEIGHT / 8 - 1;
+	int column = 0;
+	int page = 0;
+	int transferCount = 0;
+};
+
+// incremental encoder that gets moved by the test
+class DecoderMock : public QuadratureDecoder {
+public:
+	Awaitable<Parameters> change(int8_t &delta) override {
+		return {this->waitlist, delta};
+	}
+
+	void move(int delta) {
+		this->waitlist.resumeFirst([delta](Parameters &p) {
+			p.delta = delta;
+			return true;
+		});
+	}
+
+	Waitlist<Parameters> waitlist;
+};
+
+QuadratureDecoder::~QuadratureDecoder() {
+}
+
+// wheel button that gets pressed by the test
+namespace Input {
+Waitlist<Parameters> waitlist;
+
+Awaitable<Parameters> trigger(uint32_t risingFlags, uint32_t fallingFlags, int &index, bool &value) {
+	return {waitlist, risingFlags, fallingFlags, index, value};
+}
+
+void press() {
+	waitlist.resumeAll([](Parameters &p) {
+		p.index = INPUT_WHEEL_BUTTON;
+		p.value = true;
+		return true;
+	});
+}
+} // namespace Input
+
+
+// menu that changes randomly every few frames, some lines change on every frame
+template <typename M>
+Coroutine menuLoop(M &menu, int &frameCount) {
+	// also contains strings with equal length and hash (djb2) such as "0a" and "1@"
+	char const *words[] = {"Local Devices", "Alarm", "Exit", "Plug Count", "12:30", "0a", "1@", "Temperature 21.5"};
+	while (true) {
+		std::mt19937 random(frameCount / 4);
+		int count = 3 + random() % 9;
+		for (int i = 0; i < count; ++i) {
+			int kind = random() % 10;
+			if (kind == 0)
+				menu.beginSection();
+			if (kind == 1)
+				menu.endSection();
+			if (kind == 2)
+				menu.line();
+			auto stream = menu.stream();
+			stream << words[random() % 8];
+			if (random() % 3 == 0)
+				stream << ' ' << underline(dec(frameCount % 7), random() % 2 == 0);
+			if (random() % 4 == 0)
+				stream << ' ' << invert(str(words[random() % 8]));
+			if (random() % 5 == 0)
+				stream << ' ' << words[5 + frameCount % 2];
+			if (kind == 3)
+				menu.label();
+			else
+				menu.entry();
+		}
+		++frameCount;
+		co_await menu.show();
+	}
+}
+
+int main() {
+	// menu with retained rendering
+	DisplayMock display;
+	SwapChain swapChain(display);
+	DecoderMock decoder;
+	Menu menu(decoder, swapChain);
+	int frameCount = 0;
+	menuLoop(menu, frameCount);
+
+	// reference menu
+	DisplayMock referenceDisplay;
+	SwapChain referenceSwapChain(referenceDisplay);
+	DecoderMock referenceDecoder;
+	MenuReference referenceMenu(referenceDecoder, referenceSwapChain);
+	int referenceFrameCount = 0;
+	menuLoop(referenceMenu, referenceFrameCount);
+
+	std::mt19937 random(7);
+	for (int step = 0; step < STEP_COUNT; ++step) {
+		display.run();
+		referenceDisplay.run();
+		if (memcmp(display.ram, referenceDisplay.ram, sizeof(display.ram)) != 0) {
+			printf("display content differs from reference in step %d\n", step);
+			return 1;
+		}
+
+		// move the wheel or press the button
+		if (random() % 10 < 7) {
+			int delta = int(random() % 5) - 2;
+			decoder.move(delta);
+			referenceDecoder.move(delta);
+		} else {
+			Input::press();
+		}
+	}
+	printf("%d frames, %d bytes transferred (reference: %d frames, %d bytes)\n", frameCount, display.transferCount,
+		referenceFrameCount, referenceDisplay.transferCount);
+	return 0;
+}
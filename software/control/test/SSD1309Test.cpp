@@ -3,6 +3,8 @@
 #include <QuadratureDecoder.hpp>
 #include <Debug.hpp>
 #include <Loop.hpp>
+#include <Terminal.hpp>
+#include <StringOperators.hpp>
 #include <boardConfig.hpp>
 
 
@@ -14,16 +16,25 @@ Coroutine draw(SpiMaster &spi) {
 	Bitmap<DISPLAY_WIDTH, DISPLAY_HEIGHT> bitmap;
 	int x = 0;
 	int y = 0;
+	int frameCount = 0;
 	while (true) {
 		bitmap.clear();
 		bitmap.drawRectangle(x, y, 10, 10);
 		x = (x + 1) & (DISPLAY_WIDTH - 1);
 		y = (y + 1) & (DISPLAY_HEIGHT - 1);
 		
-		co_await display.set(bitmap);
+		co_await display.update(bitmap);
 		co_await Timer::sleep(200ms);
 		
 		Debug::toggleRedLed();
+
+		// benchmark: bytes transferred per frame by update() compared to a full frame
+		if (++frameCount == 64) {
+			Terminal::out << "bytes per frame: " << dec(display.transferCount / frameCount) << " (full frame: "
+				<< dec(DISPLAY_WIDTH * DISPLAY_HEIGHT / 8) << ")\n";
+			display.transferCount = 0;
+			frameCount = 0;
+		}
 	}
 }
 
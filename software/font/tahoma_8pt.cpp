@@ -4,1361 +4,501 @@
  *  Created on: Jan 3, 2015
  *      Author: Baoshi
  */
+// generated by transpose.py from tahoma_8pt.dotfactory.c, do not edit
 #include "Font.hpp"
 
-/*
-**  Font data for Tahoma 8pt
-*/
-
-/* Character bitmaps for Tahoma 8pt */
+/* Character bitmaps, organized in pages of 8 rows where each byte is a column */
 const uint8_t tahoma_8pt_bitmaps[] =
 {
     /* @0 ' ' (1 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-
-    /* @11 '!' (1 pixels wide) */
-    0x00, //
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x00, //
-    0x80, // #
-    0x00, //
-    0x00, //
-
-    /* @22 '"' (3 pixels wide) */
-    0xA0, // # #
-    0xA0, // # #
-    0xA0, // # #
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-
-    /* @33 '#' (7 pixels wide) */
-    0x00, //
-    0x14, //    # #
-    0x14, //    # #
-    0x7E, //  ######
-    0x28, //   # #
-    0x28, //   # #
-    0xFC, // ######
-    0x50, //  # #
-    0x50, //  # #
-    0x00, //
-    0x00, //
-
-    /* @44 '$' (5 pixels wide) */
-    0x20, //   #
-    0x20, //   #
-    0x78, //  ####
-    0xA0, // # #
-    0xA0, // # #
-    0x70, //  ###
-    0x28, //   # #
-    0x28, //   # #
-    0xF0, // ####
-    0x20, //   #
-    0x20, //   #
-
-    /* @55 '%' (10 pixels wide) */
-    0x00, 0x00, //
-    0x62, 0x00, //  ##   #
-    0x92, 0x00, // #  #  #
-    0x94, 0x00, // #  # #
-    0x64, 0x00, //  ##  #
-    0x09, 0x80, //     #  ##
-    0x0A, 0x40, //     # #  #
-    0x12, 0x40, //    #  #  #
-    0x11, 0x80, //    #   ##
-    0x00, 0x00, //
-    0x00, 0x00, //
-
-    /* @77 '&' (7 pixels wide) */
-    0x00, //
-    0x60, //  ##
-    0x90, // #  #
-    0x90, // #  #
-    0x64, //  ##  #
-    0x94, // #  # #
-    0x88, // #   #
-    0x8C, // #   ##
-    0x72, //  ###  #
-    0x00, //
-    0x00, //
-
-    /* @88 ''' (1 pixels wide) */
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-
-    /* @99 '(' (3 pixels wide) */
-    0x20, //   #
-    0x40, //  #
-    0x40, //  #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x40, //  #
-    0x40, //  #
-    0x20, //   #
-
-    /* @110 ')' (3 pixels wide) */
-    0x80, // #
-    0x40, //  #
-    0x40, //  #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x40, //  #
-    0x40, //  #
-    0x80, // #
-
-    /* @121 '*' (5 pixels wide) */
-    0x20, //   #
-    0xA8, // # # #
-    0x70, //  ###
-    0xA8, // # # #
-    0x20, //   #
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-
-    /* @132 '+' (7 pixels wide) */
-    0x00, //
-    0x00, //
-    0x10, //    #
-    0x10, //    #
-    0x10, //    #
-    0xFE, // #######
-    0x10, //    #
-    0x10, //    #
-    0x10, //    #
-    0x00, //
-    0x00, //
-
-    /* @143 ',' (2 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x80, // #
-
-    /* @154 '-' (3 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0xE0, // ###
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-
-    /* @165 '.' (1 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x80, // #
-    0x80, // #
-    0x00, //
-    0x00, //
-
-    /* @176 '/' (3 pixels wide) */
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-
-    /* @187 '0' (5 pixels wide) */
-    0x00, //
-    0x70, //  ###
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x70, //  ###
-    0x00, //
-    0x00, //
-
-    /* @198 '1' (3 pixels wide) */
-    0x00, //
-    0x40, //  #
-    0xC0, // ##
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0xE0, // ###
-    0x00, //
-    0x00, //
-
-    /* @209 '2' (5 pixels wide) */
-    0x00, //
-    0x70, //  ###
-    0x88, // #   #
-    0x08, //     #
-    0x10, //    #
-    0x20, //   #
-    0x40, //  #
-    0x80, // #
-    0xF8, // #####
-    0x00, //
-    0x00, //
-
-    /* @220 '3' (5 pixels wide) */
-    0x00, //
-    0x70, //  ###
-    0x88, // #   #
-    0x08, //     #
-    0x30, //   ##
-    0x08, //     #
-    0x08, //     #
-    0x88, // #   #
-    0x70, //  ###
-    0x00, //
-    0x00, //
-
-    /* @231 '4' (5 pixels wide) */
-    0x00, //
-    0x10, //    #
-    0x30, //   ##
-    0x50, //  # #
-    0x90, // #  #
-    0xF8, // #####
-    0x10, //    #
-    0x10, //    #
-    0x10, //    #
-    0x00, //
-    0x00, //
-
-    /* @242 '5' (5 pixels wide) */
-    0x00, //
-    0xF8, // #####
-    0x80, // #
-    0x80, // #
-    0xF0, // ####
-    0x08, //     #
-    0x08, //     #
-    0x88, // #   #
-    0x70, //  ###
-    0x00, //
-    0x00, //
-
-    /* @253 '6' (5 pixels wide) */
-    0x00, //
-    0x30, //   ##
-    0x40, //  #
-    0x80, // #
-    0xF0, // ####
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x70, //  ###
-    0x00, //
-    0x00, //
-
-    /* @264 '7' (5 pixels wide) */
-    0x00, //
-    0xF8, // #####
-    0x08, //     #
-    0x10, //    #
-    0x10, //    #
-    0x20, //   #
-    0x20, //   #
-    0x40, //  #
-    0x40, //  #
-    0x00, //
-    0x00, //
-
-    /* @275 '8' (5 pixels wide) */
-    0x00, //
-    0x70, //  ###
-    0x88, // #   #
-    0x88, // #   #
-    0x70, //  ###
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x70, //  ###
-    0x00, //
-    0x00, //
-
-    /* @286 '9' (5 pixels wide) */
-    0x00, //
-    0x70, //  ###
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x78, //  ####
-    0x08, //     #
-    0x10, //    #
-    0x60, //  ##
-    0x00, //
-    0x00, //
-
-    /* @297 ':' (1 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x80, // #
-    0x80, // #
-    0x00, //
-    0x00, //
-    0x80, // #
-    0x80, // #
-    0x00, //
-    0x00, //
-
-    /* @308 ';' (2 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x40, //  #
-    0x40, //  #
-    0x00, //
-    0x00, //
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x80, // #
-
-    /* @319 '<' (6 pixels wide) */
-    0x00, //
-    0x00, //
-    0x04, //      #
-    0x18, //    ##
-    0x60, //  ##
-    0x80, // #
-    0x60, //  ##
-    0x18, //    ##
-    0x04, //      #
-    0x00, //
-    0x00, //
-
-    /* @330 '=' (7 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0xFE, // #######
-    0x00, //
-    0xFE, // #######
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-
-    /* @341 '>' (6 pixels wide) */
-    0x00, //
-    0x00, //
-    0x80, // #
-    0x60, //  ##
-    0x18, //    ##
-    0x04, //      #
-    0x18, //    ##
-    0x60, //  ##
-    0x80, // #
-    0x00, //
-    0x00, //
-
-    /* @352 '?' (4 pixels wide) */
-    0x00, //
-    0xE0, // ###
-    0x10, //    #
-    0x10, //    #
-    0x20, //   #
-    0x40, //  #
-    0x40, //  #
-    0x00, //
-    0x40, //  #
-    0x00, //
-    0x00, //
-
-    /* @363 '@' (9 pixels wide) */
-    0x00, 0x00, //
-    0x3E, 0x00, //   #####
-    0x41, 0x00, //  #     #
-    0x9C, 0x80, // #  ###  #
-    0xA4, 0x80, // # #  #  #
-    0xA4, 0x80, // # #  #  #
-    0xA4, 0x80, // # #  #  #
-    0x9F, 0x00, // #  #####
-    0x40, 0x00, //  #
-    0x3C, 0x00, //   ####
-    0x00, 0x00, //
-
-    /* @385 'A' (6 pixels wide) */
-    0x00, //
-    0x30, //   ##
-    0x30, //   ##
-    0x48, //  #  #
-    0x48, //  #  #
-    0x48, //  #  #
-    0xFC, // ######
-    0x84, // #    #
-    0x84, // #    #
-    0x00, //
-    0x00, //
-
-    /* @396 'B' (5 pixels wide) */
-    0x00, //
-    0xF0, // ####
-    0x88, // #   #
-    0x88, // #   #
-    0xF0, // ####
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0xF0, // ####
-    0x00, //
-    0x00, //
-
-    /* @407 'C' (6 pixels wide) */
-    0x00, //
-    0x3C, //   ####
-    0x40, //  #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x40, //  #
-    0x3C, //   ####
-    0x00, //
-    0x00, //
-
-    /* @418 'D' (6 pixels wide) */
-    0x00, //
-    0xF0, // ####
-    0x88, // #   #
-    0x84, // #    #
-    0x84, // #    #
-    0x84, // #    #
-    0x84, // #    #
-    0x88, // #   #
-    0xF0, // ####
-    0x00, //
-    0x00, //
-
-    /* @429 'E' (5 pixels wide) */
-    0x00, //
-    0xF8, // #####
-    0x80, // #
-    0x80, // #
-    0xF0, // ####
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0xF8, // #####
-    0x00, //
-    0x00, //
-
-    /* @440 'F' (5 pixels wide) */
-    0x00, //
-    0xF8, // #####
-    0x80, // #
-    0x80, // #
-    0xF8, // #####
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x00, //
-    0x00, //
-
-    /* @451 'G' (6 pixels wide) */
-    0x00, //
-    0x3C, //   ####
-    0x40, //  #
-    0x80, // #
-    0x80, // #
-    0x9C, // #  ###
-    0x84, // #    #
-    0x44, //  #   #
-    0x3C, //   ####
-    0x00, //
-    0x00, //
-
-    /* @462 'H' (6 pixels wide) */
-    0x00, //
-    0x84, // #    #
-    0x84, // #    #
-    0x84, // #    #
-    0xFC, // ######
-    0x84, // #    #
-    0x84, // #    #
-    0x84, // #    #
-    0x84, // #    #
-    0x00, //
-    0x00, //
-
-    /* @473 'I' (3 pixels wide) */
-    0x00, //
-    0xE0, // ###
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0xE0, // ###
-    0x00, //
-    0x00, //
-
-    /* @484 'J' (4 pixels wide) */
-    0x00, //
-    0x70, //  ###
-    0x10, //    #
-    0x10, //    #
-    0x10, //    #
-    0x10, //    #
-    0x10, //    #
-    0x10, //    #
-    0xE0, // ###
-    0x00, //
-    0x00, //
-
-    /* @495 'K' (5 pixels wide) */
-    0x00, //
-    0x88, // #   #
-    0x90, // #  #
-    0xA0, // # #
-    0xC0, // ##
-    0xC0, // ##
-    0xA0, // # #
-    0x90, // #  #
-    0x88, // #   #
-    0x00, //
-    0x00, //
-
-    /* @506 'L' (4 pixels wide) */
-    0x00, //
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0xF0, // ####
-    0x00, //
-    0x00, //
-
-    /* @517 'M' (7 pixels wide) */
-    0x00, //
-    0xC6, // ##   ##
-    0xC6, // ##   ##
-    0xAA, // # # # #
-    0xAA, // # # # #
-    0x92, // #  #  #
-    0x92, // #  #  #
-    0x82, // #     #
-    0x82, // #     #
-    0x00, //
-    0x00, //
-
-    /* @528 'N' (6 pixels wide) */
-    0x00, //
-    0xC4, // ##   #
-    0xC4, // ##   #
-    0xA4, // # #  #
-    0xA4, // # #  #
-    0x94, // #  # #
-    0x94, // #  # #
-    0x8C, // #   ##
-    0x8C, // #   ##
-    0x00, //
-    0x00, //
-
-    /* @539 'O' (7 pixels wide) */
-    0x00, //
-    0x38, //   ###
-    0x44, //  #   #
-    0x82, // #     #
-    0x82, // #     #
-    0x82, // #     #
-    0x82, // #     #
-    0x44, //  #   #
-    0x38, //   ###
-    0x00, //
-    0x00, //
-
-    /* @550 'P' (5 pixels wide) */
-    0x00, //
-    0xF0, // ####
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0xF0, // ####
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x00, //
-    0x00, //
-
-    /* @561 'Q' (7 pixels wide) */
-    0x00, //
-    0x38, //   ###
-    0x44, //  #   #
-    0x82, // #     #
-    0x82, // #     #
-    0x82, // #     #
-    0x82, // #     #
-    0x44, //  #   #
-    0x38, //   ###
-    0x08, //     #
-    0x06, //      ##
-
-    /* @572 'R' (6 pixels wide) */
-    0x00, //
-    0xF0, // ####
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0xF0, // ####
-    0x90, // #  #
-    0x88, // #   #
-    0x84, // #    #
-    0x00, //
-    0x00, //
-
-    /* @583 'S' (5 pixels wide) */
-    0x00, //
-    0x78, //  ####
-    0x80, // #
-    0x80, // #
-    0x70, //  ###
-    0x08, //     #
-    0x08, //     #
-    0x08, //     #
-    0xF0, // ####
-    0x00, //
-    0x00, //
-
-    /* @594 'T' (5 pixels wide) */
-    0x00, //
-    0xF8, // #####
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x00, //
-    0x00, //
-
-    /* @605 'U' (6 pixels wide) */
-    0x00, //
-    0x84, // #    #
-    0x84, // #    #
-    0x84, // #    #
-    0x84, // #    #
-    0x84, // #    #
-    0x84, // #    #
-    0x84, // #    #
-    0x78, //  ####
-    0x00, //
-    0x00, //
-
-    /* @616 'V' (5 pixels wide) */
-    0x00, //
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x50, //  # #
-    0x50, //  # #
-    0x50, //  # #
-    0x20, //   #
-    0x20, //   #
-    0x00, //
-    0x00, //
-
-    /* @627 'W' (9 pixels wide) */
-    0x00, 0x00, //
-    0x88, 0x80, // #   #   #
-    0x88, 0x80, // #   #   #
-    0x88, 0x80, // #   #   #
-    0x55, 0x00, //  # # # #
-    0x55, 0x00, //  # # # #
-    0x55, 0x00, //  # # # #
-    0x22, 0x00, //   #   #
-    0x22, 0x00, //   #   #
-    0x00, 0x00, //
-    0x00, 0x00, //
-
-    /* @649 'X' (5 pixels wide) */
-    0x00, //
-    0x88, // #   #
-    0x88, // #   #
-    0x50, //  # #
-    0x20, //   #
-    0x20, //   #
-    0x50, //  # #
-    0x88, // #   #
-    0x88, // #   #
-    0x00, //
-    0x00, //
-
-    /* @660 'Y' (5 pixels wide) */
-    0x00, //
-    0x88, // #   #
-    0x88, // #   #
-    0x50, //  # #
-    0x50, //  # #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x00, //
-    0x00, //
-
-    /* @671 'Z' (5 pixels wide) */
-    0x00, //
-    0xF8, // #####
-    0x08, //     #
-    0x10, //    #
-    0x20, //   #
-    0x20, //   #
-    0x40, //  #
-    0x80, // #
-    0xF8, // #####
-    0x00, //
-    0x00, //
-
-    /* @682 '[' (3 pixels wide) */
-    0xE0, // ###
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0xE0, // ###
-
-    /* @693 '\' (3 pixels wide) */
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-
-    /* @704 ']' (3 pixels wide) */
-    0xE0, // ###
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0xE0, // ###
-
-    /* @715 '^' (7 pixels wide) */
-    0x00, //
-    0x10, //    #
-    0x28, //   # #
-    0x44, //  #   #
-    0x82, // #     #
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-
-    /* @726 '_' (6 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0xFC, // ######
-
-    /* @737 '`' (2 pixels wide) */
-    0x80, // #
-    0x40, //  #
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-
-    /* @748 'a' (5 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x70, //  ###
-    0x08, //     #
-    0x78, //  ####
-    0x88, // #   #
-    0x88, // #   #
-    0x78, //  ####
-    0x00, //
-    0x00, //
-
-    /* @759 'b' (5 pixels wide) */
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0xF0, // ####
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0xF0, // ####
-    0x00, //
-    0x00, //
-
-    /* @770 'c' (4 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x70, //  ###
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x70, //  ###
-    0x00, //
-    0x00, //
-
-    /* @781 'd' (5 pixels wide) */
-    0x08, //     #
-    0x08, //     #
-    0x08, //     #
-    0x78, //  ####
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x78, //  ####
-    0x00, //
-    0x00, //
-
-    /* @792 'e' (5 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x70, //  ###
-    0x88, // #   #
-    0xF8, // #####
-    0x80, // #
-    0x88, // #   #
-    0x70, //  ###
-    0x00, //
-    0x00, //
-
-    /* @803 'f' (3 pixels wide) */
-    0x60, //  ##
-    0x80, // #
-    0x80, // #
-    0xE0, // ###
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x00, //
-    0x00, //
-
-    /* @814 'g' (5 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x78, //  ####
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x78, //  ####
-    0x08, //     #
-    0x70, //  ###
-
-    /* @825 'h' (5 pixels wide) */
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0xF0, // ####
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x00, //
-    0x00, //
-
-    /* @836 'i' (1 pixels wide) */
-    0x00, //
-    0x80, // #
-    0x00, //
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x00, //
-    0x00, //
-
-    /* @847 'j' (2 pixels wide) */
-    0x00, //
-    0x40, //  #
-    0x00, //
-    0xC0, // ##
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x80, // #
-
-    /* @858 'k' (5 pixels wide) */
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x90, // #  #
-    0xA0, // # #
-    0xC0, // ##
-    0xA0, // # #
-    0x90, // #  #
-    0x88, // #   #
-    0x00, //
-    0x00, //
-
-    /* @869 'l' (1 pixels wide) */
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x00, //
-    0x00, //
-
-    /* @880 'm' (7 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0xEC, // ### ##
-    0x92, // #  #  #
-    0x92, // #  #  #
-    0x92, // #  #  #
-    0x92, // #  #  #
-    0x92, // #  #  #
-    0x00, //
-    0x00, //
-
-    /* @891 'n' (5 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0xF0, // ####
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x00, //
-    0x00, //
-
-    /* @902 'o' (5 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x70, //  ###
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x70, //  ###
-    0x00, //
-    0x00, //
-
-    /* @913 'p' (5 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0xF0, // ####
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0xF0, // ####
-    0x80, // #
-    0x80, // #
-
-    /* @924 'q' (5 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x78, //  ####
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x78, //  ####
-    0x08, //     #
-    0x08, //     #
-
-    /* @935 'r' (3 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0xA0, // # #
-    0xC0, // ##
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x00, //
-    0x00, //
-
-    /* @946 's' (4 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x70, //  ###
-    0x80, // #
-    0xC0, // ##
-    0x30, //   ##
-    0x10, //    #
-    0xE0, // ###
-    0x00, //
-    0x00, //
-
-    /* @957 't' (3 pixels wide) */
-    0x00, //
-    0x80, // #
-    0x80, // #
-    0xE0, // ###
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x60, //  ##
-    0x00, //
-    0x00, //
-
-    /* @968 'u' (5 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x88, // #   #
-    0x78, //  ####
-    0x00, //
-    0x00, //
-
-    /* @979 'v' (5 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x88, // #   #
-    0x88, // #   #
-    0x50, //  # #
-    0x50, //  # #
-    0x20, //   #
-    0x20, //   #
-    0x00, //
-    0x00, //
-
-    /* @990 'w' (7 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x92, // #  #  #
-    0x92, // #  #  #
-    0xAA, // # # # #
-    0xAA, // # # # #
-    0x44, //  #   #
-    0x44, //  #   #
-    0x00, //
-    0x00, //
-
-    /* @1001 'x' (5 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x88, // #   #
-    0x50, //  # #
-    0x20, //   #
-    0x20, //   #
-    0x50, //  # #
-    0x88, // #   #
-    0x00, //
-    0x00, //
-
-    /* @1012 'y' (5 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x88, // #   #
-    0x88, // #   #
-    0x50, //  # #
-    0x50, //  # #
-    0x20, //   #
-    0x20, //   #
-    0x40, //  #
-    0x40, //  #
-
-    /* @1023 'z' (4 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0xF0, // ####
-    0x10, //    #
-    0x20, //   #
-    0x40, //  #
-    0x80, // #
-    0xF0, // ####
-    0x00, //
-    0x00, //
-
-    /* @1034 '{' (4 pixels wide) */
-    0x10, //    #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0xC0, // ##
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x20, //   #
-    0x10, //    #
-
-    /* @1045 '|' (1 pixels wide) */
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-    0x80, // #
-
-    /* @1056 '}' (4 pixels wide) */
-    0x80, // #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x30, //   ##
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x40, //  #
-    0x80, // #
-
-    /* @1067 '~' (7 pixels wide) */
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
-    0x62, //  ##   #
-    0x92, // #  #  #
-    0x8C, // #   ##
-    0x00, //
-    0x00, //
-    0x00, //
-    0x00, //
+    0x00, // page 0
+    0x00, // page 1
+
+    /* @2 '!' (1 pixels wide) */
+    0x7E, // page 0
+    0x01, // page 1
+
+    /* @4 '"' (3 pixels wide) */
+    0x07, 0x00, 0x07, // page 0
+    0x00, 0x00, 0x00, // page 1
+
+    /* @10 '#' (7 pixels wide) */
+    0x40, 0xC8, 0x78, 0xCE, 0x78, 0x4E, 0x08, // page 0
+    0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, // page 1
+
+    /* @24 '$' (5 pixels wide) */
+    0x18, 0x24, 0xFF, 0x24, 0xC4, // page 0
+    0x01, 0x01, 0x07, 0x01, 0x00, // page 1
+
+    /* @34 '%' (10 pixels wide) */
+    0x0C, 0x12, 0x12, 0x8C, 0x60, 0x18, 0xC6, 0x20, 0x20, 0xC0, // page 0
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, // page 1
+
+    /* @54 '&' (7 pixels wide) */
+    0xEC, 0x12, 0x12, 0x2C, 0xC0, 0xB0, 0x00, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, // page 1
+
+    /* @68 ''' (1 pixels wide) */
+    0x07, // page 0
+    0x00, // page 1
+
+    /* @70 '(' (3 pixels wide) */
+    0xF8, 0x06, 0x01, // page 0
+    0x00, 0x03, 0x04, // page 1
+
+    /* @76 ')' (3 pixels wide) */
+    0x01, 0x06, 0xF8, // page 0
+    0x04, 0x03, 0x00, // page 1
+
+    /* @82 '*' (5 pixels wide) */
+    0x0A, 0x04, 0x1F, 0x04, 0x0A, // page 0
+    0x00, 0x00, 0x00, 0x00, 0x00, // page 1
+
+    /* @92 '+' (7 pixels wide) */
+    0x20, 0x20, 0x20, 0xFC, 0x20, 0x20, 0x20, // page 0
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, // page 1
+
+    /* @106 ',' (2 pixels wide) */
+    0x00, 0x80, // page 0
+    0x04, 0x03, // page 1
+
+    /* @110 '-' (3 pixels wide) */
+    0x20, 0x20, 0x20, // page 0
+    0x00, 0x00, 0x00, // page 1
+
+    /* @116 '.' (1 pixels wide) */
+    0x80, // page 0
+    0x01, // page 1
+
+    /* @118 '/' (3 pixels wide) */
+    0x00, 0xF8, 0x07, // page 0
+    0x07, 0x00, 0x00, // page 1
+
+    /* @124 '0' (5 pixels wide) */
+    0xFC, 0x02, 0x02, 0x02, 0xFC, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @134 '1' (3 pixels wide) */
+    0x04, 0xFE, 0x00, // page 0
+    0x01, 0x01, 0x01, // page 1
+
+    /* @140 '2' (5 pixels wide) */
+    0x84, 0x42, 0x22, 0x12, 0x0C, // page 0
+    0x01, 0x01, 0x01, 0x01, 0x01, // page 1
+
+    /* @150 '3' (5 pixels wide) */
+    0x84, 0x02, 0x12, 0x12, 0xEC, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @160 '4' (5 pixels wide) */
+    0x30, 0x28, 0x24, 0xFE, 0x20, // page 0
+    0x00, 0x00, 0x00, 0x01, 0x00, // page 1
+
+    /* @170 '5' (5 pixels wide) */
+    0x9E, 0x12, 0x12, 0x12, 0xE2, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @180 '6' (5 pixels wide) */
+    0xF8, 0x14, 0x12, 0x12, 0xE0, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @190 '7' (5 pixels wide) */
+    0x02, 0x82, 0x62, 0x1A, 0x06, // page 0
+    0x00, 0x01, 0x00, 0x00, 0x00, // page 1
+
+    /* @200 '8' (5 pixels wide) */
+    0xEC, 0x12, 0x12, 0x12, 0xEC, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @210 '9' (5 pixels wide) */
+    0x1C, 0x22, 0x22, 0xA2, 0x7C, // page 0
+    0x00, 0x01, 0x01, 0x00, 0x00, // page 1
+
+    /* @220 ':' (1 pixels wide) */
+    0x98, // page 0
+    0x01, // page 1
+
+    /* @222 ';' (2 pixels wide) */
+    0x00, 0x98, // page 0
+    0x04, 0x03, // page 1
+
+    /* @226 '<' (6 pixels wide) */
+    0x20, 0x50, 0x50, 0x88, 0x88, 0x04, // page 0
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, // page 1
+
+    /* @238 '=' (7 pixels wide) */
+    0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, // page 0
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // page 1
+
+    /* @252 '>' (6 pixels wide) */
+    0x04, 0x88, 0x88, 0x50, 0x50, 0x20, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, // page 1
+
+    /* @264 '?' (4 pixels wide) */
+    0x02, 0x62, 0x12, 0x0C, // page 0
+    0x00, 0x01, 0x00, 0x00, // page 1
+
+    /* @272 '@' (9 pixels wide) */
+    0xF8, 0x04, 0x72, 0x8A, 0x8A, 0xFA, 0x82, 0x84, 0x78, // page 0
+    0x00, 0x01, 0x02, 0x02, 0x02, 0x02, 0x00, 0x00, 0x00, // page 1
+
+    /* @290 'A' (6 pixels wide) */
+    0xC0, 0x78, 0x46, 0x46, 0x78, 0xC0, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x01, // page 1
+
+    /* @302 'B' (5 pixels wide) */
+    0xFE, 0x12, 0x12, 0x12, 0xEC, // page 0
+    0x01, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @312 'C' (6 pixels wide) */
+    0x78, 0x84, 0x02, 0x02, 0x02, 0x02, // page 0
+    0x00, 0x00, 0x01, 0x01, 0x01, 0x01, // page 1
+
+    /* @324 'D' (6 pixels wide) */
+    0xFE, 0x02, 0x02, 0x02, 0x84, 0x78, // page 0
+    0x01, 0x01, 0x01, 0x01, 0x00, 0x00, // page 1
+
+    /* @336 'E' (5 pixels wide) */
+    0xFE, 0x12, 0x12, 0x12, 0x02, // page 0
+    0x01, 0x01, 0x01, 0x01, 0x01, // page 1
+
+    /* @346 'F' (5 pixels wide) */
+    0xFE, 0x12, 0x12, 0x12, 0x12, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x00, // page 1
+
+    /* @356 'G' (6 pixels wide) */
+    0x78, 0x84, 0x02, 0x22, 0x22, 0xE2, // page 0
+    0x00, 0x00, 0x01, 0x01, 0x01, 0x01, // page 1
+
+    /* @368 'H' (6 pixels wide) */
+    0xFE, 0x10, 0x10, 0x10, 0x10, 0xFE, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x01, // page 1
+
+    /* @380 'I' (3 pixels wide) */
+    0x02, 0xFE, 0x02, // page 0
+    0x01, 0x01, 0x01, // page 1
+
+    /* @386 'J' (4 pixels wide) */
+    0x00, 0x02, 0x02, 0xFE, // page 0
+    0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @394 'K' (5 pixels wide) */
+    0xFE, 0x30, 0x48, 0x84, 0x02, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x01, // page 1
+
+    /* @404 'L' (4 pixels wide) */
+    0xFE, 0x00, 0x00, 0x00, // page 0
+    0x01, 0x01, 0x01, 0x01, // page 1
+
+    /* @412 'M' (7 pixels wide) */
+    0xFE, 0x06, 0x18, 0x60, 0x18, 0x06, 0xFE, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, // page 1
+
+    /* @426 'N' (6 pixels wide) */
+    0xFE, 0x06, 0x18, 0x60, 0x80, 0xFE, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x01, 0x01, // page 1
+
+    /* @438 'O' (7 pixels wide) */
+    0x78, 0x84, 0x02, 0x02, 0x02, 0x84, 0x78, // page 0
+    0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, // page 1
+
+    /* @452 'P' (5 pixels wide) */
+    0xFE, 0x22, 0x22, 0x22, 0x1C, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x00, // page 1
+
+    /* @462 'Q' (7 pixels wide) */
+    0x78, 0x84, 0x02, 0x02, 0x02, 0x84, 0x78, // page 0
+    0x00, 0x00, 0x01, 0x01, 0x03, 0x04, 0x04, // page 1
+
+    /* @476 'R' (6 pixels wide) */
+    0xFE, 0x22, 0x22, 0x62, 0x9C, 0x00, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x01, // page 1
+
+    /* @488 'S' (5 pixels wide) */
+    0x0C, 0x12, 0x12, 0x12, 0xE2, // page 0
+    0x01, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @498 'T' (5 pixels wide) */
+    0x02, 0x02, 0xFE, 0x02, 0x02, // page 0
+    0x00, 0x00, 0x01, 0x00, 0x00, // page 1
+
+    /* @508 'U' (6 pixels wide) */
+    0xFE, 0x00, 0x00, 0x00, 0x00, 0xFE, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @520 'V' (5 pixels wide) */
+    0x0E, 0x70, 0x80, 0x70, 0x0E, // page 0
+    0x00, 0x00, 0x01, 0x00, 0x00, // page 1
+
+    /* @530 'W' (9 pixels wide) */
+    0x0E, 0x70, 0x80, 0x70, 0x0E, 0x70, 0x80, 0x70, 0x0E, // page 0
+    0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, // page 1
+
+    /* @548 'X' (5 pixels wide) */
+    0x86, 0x48, 0x30, 0x48, 0x86, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x01, // page 1
+
+    /* @558 'Y' (5 pixels wide) */
+    0x06, 0x18, 0xE0, 0x18, 0x06, // page 0
+    0x00, 0x00, 0x01, 0x00, 0x00, // page 1
+
+    /* @568 'Z' (5 pixels wide) */
+    0x82, 0x42, 0x32, 0x0A, 0x06, // page 0
+    0x01, 0x01, 0x01, 0x01, 0x01, // page 1
+
+    /* @578 '[' (3 pixels wide) */
+    0xFF, 0x01, 0x01, // page 0
+    0x07, 0x04, 0x04, // page 1
+
+    /* @584 '\' (3 pixels wide) */
+    0x07, 0xF8, 0x00, // page 0
+    0x00, 0x00, 0x07, // page 1
+
+    /* @590 ']' (3 pixels wide) */
+    0x01, 0x01, 0xFF, // page 0
+    0x04, 0x04, 0x07, // page 1
+
+    /* @596 '^' (7 pixels wide) */
+    0x10, 0x08, 0x04, 0x02, 0x04, 0x08, 0x10, // page 0
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // page 1
+
+    /* @610 '_' (6 pixels wide) */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // page 0
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, // page 1
+
+    /* @622 '`' (2 pixels wide) */
+    0x01, 0x02, // page 0
+    0x00, 0x00, // page 1
+
+    /* @626 'a' (5 pixels wide) */
+    0xC0, 0x28, 0x28, 0x28, 0xF0, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x01, // page 1
+
+    /* @636 'b' (5 pixels wide) */
+    0xFF, 0x08, 0x08, 0x08, 0xF0, // page 0
+    0x01, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @646 'c' (4 pixels wide) */
+    0xF0, 0x08, 0x08, 0x08, // page 0
+    0x00, 0x01, 0x01, 0x01, // page 1
+
+    /* @654 'd' (5 pixels wide) */
+    0xF0, 0x08, 0x08, 0x08, 0xFF, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x01, // page 1
+
+    /* @664 'e' (5 pixels wide) */
+    0xF0, 0x28, 0x28, 0x28, 0xB0, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @674 'f' (3 pixels wide) */
+    0xFE, 0x09, 0x09, // page 0
+    0x01, 0x00, 0x00, // page 1
+
+    /* @680 'g' (5 pixels wide) */
+    0xF0, 0x08, 0x08, 0x08, 0xF8, // page 0
+    0x00, 0x05, 0x05, 0x05, 0x03, // page 1
+
+    /* @690 'h' (5 pixels wide) */
+    0xFF, 0x08, 0x08, 0x08, 0xF0, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x01, // page 1
+
+    /* @700 'i' (1 pixels wide) */
+    0xFA, // page 0
+    0x01, // page 1
+
+    /* @702 'j' (2 pixels wide) */
+    0x08, 0xFA, // page 0
+    0x04, 0x03, // page 1
+
+    /* @706 'k' (5 pixels wide) */
+    0xFF, 0x20, 0x50, 0x88, 0x00, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x01, // page 1
+
+    /* @716 'l' (1 pixels wide) */
+    0xFF, // page 0
+    0x01, // page 1
+
+    /* @718 'm' (7 pixels wide) */
+    0xF8, 0x08, 0x08, 0xF0, 0x08, 0x08, 0xF0, // page 0
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, // page 1
+
+    /* @732 'n' (5 pixels wide) */
+    0xF8, 0x08, 0x08, 0x08, 0xF0, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x01, // page 1
+
+    /* @742 'o' (5 pixels wide) */
+    0xF0, 0x08, 0x08, 0x08, 0xF0, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @752 'p' (5 pixels wide) */
+    0xF8, 0x08, 0x08, 0x08, 0xF0, // page 0
+    0x07, 0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @762 'q' (5 pixels wide) */
+    0xF0, 0x08, 0x08, 0x08, 0xF8, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x07, // page 1
+
+    /* @772 'r' (3 pixels wide) */
+    0xF8, 0x10, 0x08, // page 0
+    0x01, 0x00, 0x00, // page 1
+
+    /* @778 's' (4 pixels wide) */
+    0x30, 0x28, 0x48, 0xC8, // page 0
+    0x01, 0x01, 0x01, 0x00, // page 1
+
+    /* @786 't' (3 pixels wide) */
+    0xFE, 0x08, 0x08, // page 0
+    0x00, 0x01, 0x01, // page 1
+
+    /* @792 'u' (5 pixels wide) */
+    0xF8, 0x00, 0x00, 0x00, 0xF8, // page 0
+    0x00, 0x01, 0x01, 0x01, 0x01, // page 1
+
+    /* @802 'v' (5 pixels wide) */
+    0x18, 0x60, 0x80, 0x60, 0x18, // page 0
+    0x00, 0x00, 0x01, 0x00, 0x00, // page 1
+
+    /* @812 'w' (7 pixels wide) */
+    0x78, 0x80, 0x60, 0x18, 0x60, 0x80, 0x78, // page 0
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, // page 1
+
+    /* @826 'x' (5 pixels wide) */
+    0x08, 0x90, 0x60, 0x90, 0x08, // page 0
+    0x01, 0x00, 0x00, 0x00, 0x01, // page 1
+
+    /* @836 'y' (5 pixels wide) */
+    0x18, 0x60, 0x80, 0x60, 0x18, // page 0
+    0x00, 0x06, 0x01, 0x00, 0x00, // page 1
+
+    /* @846 'z' (4 pixels wide) */
+    0x88, 0x48, 0x28, 0x18, // page 0
+    0x01, 0x01, 0x01, 0x01, // page 1
+
+    /* @854 '{' (4 pixels wide) */
+    0x20, 0x20, 0xDE, 0x01, // page 0
+    0x00, 0x00, 0x03, 0x04, // page 1
+
+    /* @862 '|' (1 pixels wide) */
+    0xFF, // page 0
+    0x07, // page 1
+
+    /* @864 '}' (4 pixels wide) */
+    0x01, 0xDE, 0x20, 0x20, // page 0
+    0x04, 0x03, 0x00, 0x00, // page 1
+
+    /* @872 '~' (7 pixels wide) */
+    0x60, 0x10, 0x10, 0x20, 0x40, 0x40, 0x30, // page 0
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // page 1
 };
 
-/* Character descriptors for Tahoma 8pt */
-/* { [Char width in bits], [Offset into tahoma_8ptCharBitmaps in bytes] } */
+/* Character descriptors */
+/* { [Char width in bits], [Offset into tahoma_8pt_bitmaps in bytes] } */
 const Character tahoma_8pt_descriptors[] =
 {
     {1, 0},         /*   */
-    {1, 11},        /* ! */
-    {3, 22},        /* " */
-    {7, 33},        /* # */
-    {5, 44},        /* $ */
-    {10, 55},       /* % */
-    {7, 77},        /* & */
-    {1, 88},        /* ' */
-    {3, 99},        /* ( */
-    {3, 110},       /* ) */
-    {5, 121},       /* * */
-    {7, 132},       /* + */
-    {2, 143},       /* , */
-    {3, 154},       /* - */
-    {1, 165},       /* . */
-    {3, 176},       /* / */
-    {5, 187},       /* 0 */
-    {3, 198},       /* 1 */
-    {5, 209},       /* 2 */
-    {5, 220},       /* 3 */
-    {5, 231},       /* 4 */
-    {5, 242},       /* 5 */
-    {5, 253},       /* 6 */
-    {5, 264},       /* 7 */
-    {5, 275},       /* 8 */
-    {5, 286},       /* 9 */
-    {1, 297},       /* : */
-    {2, 308},       /* ; */
-    {6, 319},       /* < */
-    {7, 330},       /* = */
-    {6, 341},       /* > */
-    {4, 352},       /* ? */
-    {9, 363},       /* @ */
-    {6, 385},       /* A */
-    {5, 396},       /* B */
-    {6, 407},       /* C */
-    {6, 418},       /* D */
-    {5, 429},       /* E */
-    {5, 440},       /* F */
-    {6, 451},       /* G */
-    {6, 462},       /* H */
-    {3, 473},       /* I */
-    {4, 484},       /* J */
-    {5, 495},       /* K */
-    {4, 506},       /* L */
-    {7, 517},       /* M */
-    {6, 528},       /* N */
-    {7, 539},       /* O */
-    {5, 550},       /* P */
-    {7, 561},       /* Q */
-    {6, 572},       /* R */
-    {5, 583},       /* S */
-    {5, 594},       /* T */
-    {6, 605},       /* U */
-    {5, 616},       /* V */
-    {9, 627},       /* W */
-    {5, 649},       /* X */
-    {5, 660},       /* Y */
-    {5, 671},       /* Z */
-    {3, 682},       /* [ */
-    {3, 693},       /* \ */
-    {3, 704},       /* ] */
-    {7, 715},       /* ^ */
-    {6, 726},       /* _ */
-    {2, 737},       /* ` */
-    {5, 748},       /* a */
-    {5, 759},       /* b */
-    {4, 770},       /* c */
-    {5, 781},       /* d */
-    {5, 792},       /* e */
-    {3, 803},       /* f */
-    {5, 814},       /* g */
-    {5, 825},       /* h */
-    {1, 836},       /* i */
-    {2, 847},       /* j */
-    {5, 858},       /* k */
-    {1, 869},       /* l */
-    {7, 880},       /* m */
-    {5, 891},       /* n */
-    {5, 902},       /* o */
-    {5, 913},       /* p */
-    {5, 924},       /* q */
-    {3, 935},       /* r */
-    {4, 946},       /* s */
-    {3, 957},       /* t */
-    {5, 968},       /* u */
-    {5, 979},       /* v */
-    {7, 990},       /* w */
-    {5, 1001},      /* x */
-    {5, 1012},      /* y */
-    {4, 1023},      /* z */
-    {4, 1034},      /* { */
-    {1, 1045},      /* | */
-    {4, 1056},      /* } */
-    {7, 1067},      /* ~ */
+    {1, 2},         /* ! */
+    {3, 4},         /* " */
+    {7, 10},        /* # */
+    {5, 24},        /* $ */
+    {10, 34},       /* % */
+    {7, 54},        /* & */
+    {1, 68},        /* ' */
+    {3, 70},        /* ( */
+    {3, 76},        /* ) */
+    {5, 82},        /* * */
+    {7, 92},        /* + */
+    {2, 106},       /* , */
+    {3, 110},       /* - */
+    {1, 116},       /* . */
+    {3, 118},       /* / */
+    {5, 124},       /* 0 */
+    {3, 134},       /* 1 */
+    {5, 140},       /* 2 */
+    {5, 150},       /* 3 */
+    {5, 160},       /* 4 */
+    {5, 170},       /* 5 */
+    {5, 180},       /* 6 */
+    {5, 190},       /* 7 */
+    {5, 200},       /* 8 */
+    {5, 210},       /* 9 */
+    {1, 220},       /* : */
+    {2, 222},       /* ; */
+    {6, 226},       /* < */
+    {7, 238},       /* = */
+    {6, 252},       /* > */
+    {4, 264},       /* ? */
+    {9, 272},       /* @ */
+    {6, 290},       /* A */
+    {5, 302},       /* B */
+    {6, 312},       /* C */
+    {6, 324},       /* D */
+    {5, 336},       /* E */
+    {5, 346},       /* F */
+    {6, 356},       /* G */
+    {6, 368},       /* H */
+    {3, 380},       /* I */
+    {4, 386},       /* J */
+    {5, 394},       /* K */
+    {4, 404},       /* L */
+    {7, 412},       /* M */
+    {6, 426},       /* N */
+    {7, 438},       /* O */
+    {5, 452},       /* P */
+    {7, 462},       /* Q */
+    {6, 476},       /* R */
+    {5, 488},       /* S */
+    {5, 498},       /* T */
+    {6, 508},       /* U */
+    {5, 520},       /* V */
+    {9, 530},       /* W */
+    {5, 548},       /* X */
+    {5, 558},       /* Y */
+    {5, 568},       /* Z */
+    {3, 578},       /* [ */
+    {3, 584},       /* \ */
+    {3, 590},       /* ] */
+    {7, 596},       /* ^ */
+    {6, 610},       /* _ */
+    {2, 622},       /* ` */
+    {5, 626},       /* a */
+    {5, 636},       /* b */
+    {4, 646},       /* c */
+    {5, 654},       /* d */
+    {5, 664},       /* e */
+    {3, 674},       /* f */
+    {5, 680},       /* g */
+    {5, 690},       /* h */
+    {1, 700},       /* i */
+    {2, 702},       /* j */
+    {5, 706},       /* k */
+    {1, 716},       /* l */
+    {7, 718},       /* m */
+    {5, 732},       /* n */
+    {5, 742},       /* o */
+    {5, 752},       /* p */
+    {5, 762},       /* q */
+    {3, 772},       /* r */
+    {4, 778},       /* s */
+    {3, 786},       /* t */
+    {5, 792},       /* u */
+    {5, 802},       /* v */
+    {7, 812},       /* w */
+    {5, 826},       /* x */
+    {5, 836},       /* y */
+    {4, 846},       /* z */
+    {4, 854},       /* { */
+    {1, 862},       /* | */
+    {4, 864},       /* } */
+    {7, 872},       /* ~ */
 };
 
-/* Font information for Tahoma 8pt */
+/* Font information */
 Font tahoma_8pt =
 {
     11, /*  Character height */
-    1,  /*  C */
+    1,  /*  Character spacing */
     ' ', /*  Start character */
     '~', /*  End character */
     tahoma_8pt_descriptors, /*  Character descriptor array */
     tahoma_8pt_bitmaps, /*  Character bitmap array */
 };
-
-
@@ -0,0 +1,92 @@
+import re
+import sys
+
+# Converts a font that was exported by The Dot Factory with horizontally organized glyph bitmaps (rows of bytes, MSB
+# is the leftmost pixel) into a font with glyph bitmaps organized in pages of 8 rows where each byte is a column
+# (LSB is the top row), same as Bitmap. This allows Bitmap::drawText() to copy glyphs column by column without
+# transposing each pixel at draw time.
+#
+# usage: python3 transpose.py tahoma_8pt
+# reads tahoma_8pt.dotfactory.c and writes tahoma_8pt.cpp
+
+name = sys.argv[1]
+source = open(name + '.dotfactory.c').read()
+
+# header comment of source
+header = source[:source.index('*/') + 2]
+
+# glyph bitmap data
+bitmapsStart = source.index(name + '_bitmaps[]')
+bitmapsEnd = source.index('};', bitmapsStart)
+data = [int(x, 16) for x in re.findall(r'0x([0-9A-Fa-f]{2})', source[bitmapsStart:bitmapsEnd])]
+
+# character descriptors (width, offset)
+descriptorsStart = source.index(name + '_descriptors[]')
+descriptorsEnd = source.index('};', descriptorsStart)
+descriptors = [(int(w), int(o)) for w, o in re.findall(r'\{(\d+), (\d+)\}', source[descriptorsStart:descriptorsEnd])]
+
+# font info (height, space, first, last)
+fontStart = source.index('Font ' + name)
+info = re.findall(r"^\s*(\d+|'.'),", source[fontStart:], re.MULTILINE)
+height = int(info[0])
+space = int(info[1])
+first = ord(info[2][1])
+last = ord(info[3][1])
+pageCount = (height + 7) // 8
+
+
+# transpose glyphs
+bitmaps = []
+columnDescriptors = []
+columnOffset = 0
+for width, offset in descriptors:
+	stride = (width + 7) // 8
+	glyph = []
+	for page in range(pageCount):
+		columns = []
+		for x in range(width):
+			column = 0
+			for bit in range(8):
+				y = page * 8 + bit
+				if y < height and data[offset + y * stride + (x >> 3)] & (0x80 >> (x & 7)) != 0:
+					column |= 1 << bit
+			columns.append(column)
+		glyph.append(columns)
+	bitmaps.append(glyph)
+	columnDescriptors.append((width, columnOffset))
+	columnOffset += pageCount * width
+
+
+# write font
+file = open(name + '.cpp', 'w')
+file.write(header + '\n')
+file.write(f"// generated by transpose.py from {name}.dotfactory.c, do not edit\n")
+file.write('#include "Font.hpp"\n\n')
+file.write("/* Character bitmaps, organized in pages of 8 rows where each byte is a column */\n")
+file.write(f"const uint8_t {name}_bitmaps[] =\n{{\n")
+for index, glyph in enumerate(bitmaps):
+	ch = chr(first + index)
+	width, offset = columnDescriptors[index]
+	file.write(f"    /* @{offset} '{ch}' ({width} pixels wide) */\n")
+	for page, columns in enumerate(glyph):
+		file.write(f"    {''.join(f'0x{c:02X}, ' for c in columns)}// page {page}\n")
+	if index < len(bitmaps) - 1:
+		file.write('\n')
+file.write('};\n\n')
+file.write("/* Character descriptors */\n")
+file.write(f"/* {{ [Char width in bits], [Offset into {name}_bitmaps in bytes] }} */\n")
+file.write(f"const Character {name}_descriptors[] =\n{{\n")
+for index, (width, offset) in enumerate(columnDescriptors):
+	ch = chr(first + index)
+	file.write(f"    {{{width}, {offset}}},".ljust(20) + f"/* {ch} */\n")
+file.write('};\n\n')
+file.write("/* Font information */\n")
+file.write(f"Font {name} =\n{{\n")
+file.write(f"    {height}, /*  Character height */\n")
+file.write(f"    {space},  /*  Character spacing */\n")
+file.write(f"    '{chr(first)}', /*  Start character */\n")
+file.write(f"    '{chr(last)}', /*  End character */\n")
+file.write(f"    {name}_descriptors, /*  Character descriptor array */\n")
+file.write(f"    {name}_bitmaps, /*  Character bitmap array */\n")
+file.write('};\n')
+file.close()
@@ -0,0 +1,111 @@
+#include "FlightRecorder.hpp"
+#include <StringOperators.hpp>
+#include <util.hpp>
+#ifdef PLATFORM_POSIX
+#include <cstdio>
+#endif
+
+
+namespace FlightRecorder {
+
+Record records[CAPACITY];
+
+// index of the next record to write and total number of records written
+int head = 0;
+uint32_t total = 0;
+
+void record(Subscriber const &subscriber, Message const &message) {
+	auto &record = FlightRecorder::records[FlightRecorder::head];
+	record.time = FlightRecorder::clock != nullptr ? FlightRecorder::clock() : 0;
+	record.message = message;
+	record.source = subscriber.data->source;
+	record.interfaceId = subscriber.interfaceId;
+	record.elementId = subscriber.elementId;
+	record.plugIndex = subscriber.data->destination.plugIndex;
+	record.connectionIndex = subscriber.connectionIndex;
+
+	FlightRecorder::head = FlightRecorder::head == CAPACITY - 1 ? 0 : FlightRecorder::head + 1;
+	++FlightRecorder::total;
+}
+
+int getCount() {
+	return FlightRecorder::total < CAPACITY ? int(FlightRecorder::total) : CAPACITY;
+}
+
+Record const &get(int index) {
+	int i = FlightRecorder::head - getCount() + index;
+	return FlightRecorder::records[i < 0 ? i + CAPACITY : i];
+}
+
+void clear() {
+	FlightRecorder::head = 0;
+	FlightRecorder::total = 0;
+}
+
+void dump(Stream &stream) {
+	int count = getCount();
+	for (int i = 0; i < count; ++i) {
+		auto data = reinterpret_cast<uint8_t const *>(&get(i));
+		stream << "fr ";
+		for (int j = 0; j < int(sizeof(Record)); ++j)
+			stream << hex(data[j]);
+		stream << '\n';
+	}
+}
+
+static int parseHexDigit(char ch) {
+	if (ch >= '0' && ch <= '9')
+		return ch - '0';
+	if (ch >= 'a' && ch <= 'f')
+		return ch - 'a' + 10;
+	if (ch >= 'A' && ch <= 'F')
+		return ch - 'A' + 10;
+	return -1;
+}
+
+bool parse(String line, Record &record) {
+	if (line.length < 3 + int(sizeof(Record)) * 2 || !(line.substring(0, 3) == "fr "))
+		return false;
+	auto data = reinterpret_cast<uint8_t *>(&record);
+	for (int i = 0; i < int(sizeof(Record)); ++i) {
+		int hi = parseHexDigit(line[3 + i * 2]);
+		int lo = parseHexDigit(line[4 + i * 2]);
+		if (hi < 0 || lo < 0)
+			return false;
+		data[i] = hi << 4 | lo;
+	}
+	return true;
+}
+
+#ifdef PLATFORM_POSIX
+bool save(char const *fileName) {
+	FILE *file = fopen(fileName, "wb");
+	if (file == nullptr)
+		return false;
+	int count = getCount();
+	FileHeader header = {FILE_MAGIC, FILE_VERSION, sizeof(Record), uint32_t(count)};
+	bool result = fwrite(&header, sizeof(header), 1, file) == 1;
+	for (int i = 0; i < count && result; ++i)
+		result = fwrite(&get(i), sizeof(Record), 1, file) == 1;
+	fclose(file);
+	return result;
+}
+
+int load(char const *fileName, Record *&records) {
+	FILE *file = fopen(fileName, "rb");
+	if (file == nullptr)
+		return -1;
+	FileHeader header;
+	int count = -1;
+	if (fread(&header, sizeof(header), 1, file) == 1 && header.magic == FILE_MAGIC
+		&& header.version == FILE_VERSION && header.recordSize == sizeof(Record))
+	{
+		records = new Record[header.count];
+		count = int(fread(records, sizeof(Record), header.count, file));
+	}
+	fclose(file);
+	return count;
+}
+#endif
+
+} // namespace FlightRecorder
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Subscriber.hpp"
+#include <Array.hpp>
+#include <Stream.hpp>
+#include <cstdint>
+
+
+/*
+	Flight recorder that records every message delivery of SubscriberList::publish*() into a ring buffer in RAM so that
+	the messages that led to a misbehaviour can be inspected afterwards. A record contains the time, the source plug,
+	the destination plug and the message after conversion to the destination type. Recording is always on and only
+	copies one record per delivery.
+
+	The records can be dumped as text to a Terminal (RTT on nrf52), captured on the host and converted to a recording
+	file with the flightRecorder tool. On POSIX the records can be saved to a file directly, the emulator does this
+	from the menu and on exit. The emulator replays a recording file when started with the file name as parameter.
+*/
+namespace FlightRecorder {
+
+// number of records in the ring buffer
+constexpr int CAPACITY = 256;
+
+// unit of the record time, SystemTime is in milliseconds on all platforms
+constexpr int TICKS_PER_SECOND = 1000;
+
+// file format
+constexpr uint32_t FILE_MAGIC = 0x63655246; // "FRec"
+constexpr uint16_t FILE_VERSION = 1;
+
+/**
+ * Record of one message delivery
+ */
+struct Record {
+	// time in 1/TICKS_PER_SECOND seconds, see SystemTime
+	uint32_t time;
+
+	// message after conversion to the destination type
+	Message message;
+
+	// source plug
+	Source source;
+
+	// destination plug and index of the connection of the destination plug
+	uint8_t interfaceId;
+	uint8_t elementId;
+	uint8_t plugIndex;
+	uint8_t connectionIndex;
+};
+
+// header of a recording file, followed by the records
+struct FileHeader {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t recordSize;
+	uint32_t count;
+};
+
+// clock for the time of the records, set by the application (e.g. to Timer::now()), time is zero if not set
+inline uint32_t (*clock)() = nullptr;
+
+/**
+ * Record a message delivery
+ * @param subscriber subscriber that received the message
+ * @param message message after conversion to the destination type
+ */
+void record(Subscriber const &subscriber, Message const &message);
+
+/**
+ * Get the number of records in the ring buffer
+ * @return number of records, at most CAPACITY
+ */
+int getCount();
+
+/**
+ * Get a record
+ * @param index index of the record, 0 is the oldest record
+ * @return record
+ */
+Record const &get(int index);
+
+/**
+ * Clear all records
+ */
+void clear();
+
+/**
+ * Dump all records as text to a stream, one line per record that starts with "fr " followed by the record in hex
+ * @param stream stream to write to, e.g. Terminal::out
+ */
+void dump(Stream &stream);
+
+/**
+ * Parse a line written by dump()
+ * @param line line of text
+ * @param record record to fill in
+ * @return true if the line contains a record
+ */
+bool parse(String line, Record &record);
+
+#ifdef PLATFORM_POSIX
+// default name of the recording file
+constexpr char const *FILE_NAME = "flightRecorder.rec";
+
+/**
+ * Save all records to a recording file
+ * @param fileName name of the file
+ * @return true on success
+ */
+bool save(char const *fileName);
+
+/**
+ * Load a recording file
+ * @param fileName name of the file
+ * @param records records, allocated with new [], ownership goes to the caller
+ * @return number of records or -1 on error
+ */
+int load(char const *fileName, Record *&records);
+#endif
+
+} // namespace FlightRecorder
@@ -7,168 +7,192 @@ using PlugType = bus::PlugType;
 #include "functions.generated.cpp"
 
 
-bool convertSwitch(MessageType dstType, Message &dst, uint8_t src, ConvertOptions const &convertOptions) {
-	if (src >= 3)
+// conversion kernels
+// ------------------
+
+// classes of destination message types that differ in conversion
+enum class ConvertClass {
+	// can't be converted to
+	NONE,
+
+	// BINARY, TERNARY
+	SWITCH,
+
+	// LEVEL, PHYSICAL, CONCENTRATION
+	VALUE,
+
+	// LIGHTING, has a transition
+	LIGHTING
+};
+
+template <ConvertClass C, bool CMD>
+static bool convertSwitchKernel(Message &dst, uint8_t src, ConvertParameters const &parameters) {
+	if (C == ConvertClass::NONE || src >= 3)
 		return false;
 
-	switch (dstType & PlugType::CATEGORY) {
-	case PlugType::BINARY:
-	case PlugType::TERNARY: {
+	int cmd = parameters.commands[src];
+	if (cmd >= 3)
+		return false; // conversion failed
+	if constexpr (C == ConvertClass::SWITCH) {
 		// switch -> switch
-		int cmd = convertOptions.getCommand(src);
-		if (cmd >= 3)
-			return false; // conversion failed
 		dst.value.u8 = cmd;
-		break;
-	}
-	case PlugType::LEVEL:
-	case PlugType::PHYSICAL:
-	case PlugType::CONCENTRATION: {
-		// switch -> float, use values in convertOptions
-		dst.value.f32 = convertOptions.value.f[src];
-		int cmd = convertOptions.getCommand(src);
-		if (cmd >= 3)
-			return false; // conversion failed
-		if ((dstType & PlugType::CMD) != 0) {
-			dst.command = cmd;
-		}
-		break;
-	}
-	case PlugType::LIGHTING: {
+	} else {
 		// switch -> float, use values in convertOptions
-		dst.value.f32 = convertOptions.value.f[src];
-		int cmd = convertOptions.getCommand(src);
-		if (cmd >= 3)
-			return false; // conversion failed
-		if ((dstType & PlugType::CMD) != 0) {
+		dst.value.f32 = parameters.values[src];
+		if constexpr (CMD) {
 			dst.command = cmd;
-			dst.transition = convertOptions.transition;
+			if constexpr (C == ConvertClass::LIGHTING)
+				dst.transition = parameters.transition;
 		}
-		break;
-	}
-	default:
-		// conversion failed
-		return false;
 	}
 
 	// conversion successful
 	return true;
 }
 
-bool convertInt8(MessageType dstType, Message &dst, int src, ConvertOptions const &convertOptions) {
-	switch (dstType & PlugType::CATEGORY) {
-	case PlugType::LEVEL:
-	case PlugType::PHYSICAL:
-	case PlugType::CONCENTRATION: {
-		// int -> float, use value in convertOptions
-		dst.value.f32 = float(src) * convertOptions.value.f[0];
-		if ((dstType & PlugType::CMD) == 0)
-			return false; // conversion failed, destination must support command
-		dst.command = 1;
-		break;
-	}
-	case PlugType::LIGHTING: {
-		// int -> float, use value in convertOptions
-		dst.value.f32 = float(src) * convertOptions.value.f[0];
-		if ((dstType & PlugType::CMD) == 0)
-			return false; // conversion failed, destination must support command
+template <ConvertClass C, bool CMD>
+static bool convertInt8Kernel(Message &dst, int src, ConvertParameters const &parameters) {
+	// int -> float, use value in convertOptions, destination must support command
+	if constexpr ((C == ConvertClass::VALUE || C == ConvertClass::LIGHTING) && CMD) {
+		dst.value.f32 = float(src) * parameters.values[0];
 		dst.command = 1;
-		dst.transition = convertOptions.transition;
-		break;
-	}
-	default:
-		// conversion failed
-		return false;
+		if constexpr (C == ConvertClass::LIGHTING)
+			dst.transition = parameters.transition;
+		return true;
 	}
 
-	// conversion successful
-	return true;
+	// conversion failed
+	return false;
 }
 
-bool convertFloat(MessageType dstType, Message &dst, float src, ConvertOptions const &convertOptions) {
-	switch (dstType & PlugType::CATEGORY) {
-	case PlugType::BINARY:
-	case PlugType::TERNARY: {
+template <ConvertClass C, bool CMD>
+static bool convertFloatKernel(Message &dst, float src, ConvertParameters const &parameters) {
+	if constexpr (C == ConvertClass::NONE) {
+		// conversion failed
+		return false;
+	} else if constexpr (C == ConvertClass::SWITCH) {
 		// float -> command, compare against threshold values
-		float upper = convertOptions.value.f[0];
-		float lower = convertOptions.value.f[1];
+		float upper = parameters.values[0];
+		float lower = parameters.values[1];
 		int compare = src > upper ? 0 : (src < lower ? 1 : 2);
-		int c = convertOptions.getCommand(compare);
+		int c = parameters.commands[compare];
 		if (c >= 3)
 			return false; // conversion failed
 		dst.value.u8 = c;
-		break;
-	}
-	case PlugType::LEVEL:
-	case PlugType::PHYSICAL:
-	case PlugType::CONCENTRATION:
+	} else {
 		dst.value.f32 = src;
-		if ((dstType & PlugType::CMD) != 0) {
+		if constexpr (CMD) {
 			dst.command = 0; // set
+			if constexpr (C == ConvertClass::LIGHTING)
+				dst.transition = 0;
 		}
-		break;
-	case PlugType::LIGHTING:
-		dst.value.f32 = src;
-		if ((dstType & PlugType::CMD) != 0) {
-			dst.command = 0; // set
-			dst.transition = 0;
-		}
-		break;
-	default:
-		// conversion failed
-		return false;
 	}
 
 	// conversion successful
 	return true;
 }
 
-bool convertFloatCommand(MessageType dstType, Message &dst, float src, uint8_t command,
-	ConvertOptions const &convertOptions)
+template <ConvertClass C, bool CMD>
+static bool convertFloatCommandKernel(Message &dst, float src, uint8_t command, ConvertParameters const &parameters) {
+	if constexpr ((C == ConvertClass::VALUE || C == ConvertClass::LIGHTING) && CMD) {
+		dst.value.f32 = src;
+		dst.command = command;
+		if constexpr (C == ConvertClass::LIGHTING)
+			dst.transition = 0;
+		return true;
+	}
+
+	// conversion failed
+	return false;
+}
+
+template <ConvertClass C, bool CMD>
+static bool convertFloatTransitionKernel(Message &dst, float src, uint8_t command, uint16_t transition,
+	ConvertParameters const &parameters)
 {
-	// sanity check
-	if ((dstType & PlugType::CMD) == 0)
-		return false;
+	if constexpr (C == ConvertClass::LIGHTING && CMD) {
+		dst.value.f32 = src;
+		dst.command = command;
+		dst.transition = transition;
+		return true;
+	}
+
+	// conversion failed
+	return false;
+}
+
+template <ConvertClass C, bool CMD>
+constexpr ConvertFunctions convertFunctions = {
+	convertSwitchKernel<C, CMD>,
+	convertInt8Kernel<C, CMD>,
+	convertFloatKernel<C, CMD>,
+	convertFloatCommandKernel<C, CMD>,
+	convertFloatTransitionKernel<C, CMD>
+};
+
+ConvertFunctions const ConvertFunctions::none = convertFunctions<ConvertClass::NONE, false>;
 
+// get the conversion functions for a destination message type
+static ConvertFunctions const &getConvertFunctions(MessageType dstType) {
+	bool cmd = (dstType & PlugType::CMD) != 0;
 	switch (dstType & PlugType::CATEGORY) {
+	case PlugType::BINARY:
+	case PlugType::TERNARY:
+		return convertFunctions<ConvertClass::SWITCH, false>;
 	case PlugType::LEVEL:
 	case PlugType::PHYSICAL:
 	case PlugType::CONCENTRATION:
-		dst.value.f32 = src;
-		dst.command = command;
-		break;
+		return cmd ? convertFunctions<ConvertClass::VALUE, true> : convertFunctions<ConvertClass::VALUE, false>;
 	case PlugType::LIGHTING:
-		dst.value.f32 = src;
-		dst.command = command;
-		dst.transition = 0;
-		break;
+		return cmd ? convertFunctions<ConvertClass::LIGHTING, true> : convertFunctions<ConvertClass::LIGHTING, false>;
 	default:
-		// conversion failed
-		return false;
+		return ConvertFunctions::none;
 	}
+}
 
-	// conversion successful
-	return true;
+void Converter::init(MessageType dstType, ConvertOptions const &convertOptions) {
+	this->functions = &getConvertFunctions(dstType);
+	for (int i = 0; i < ConvertOptions::MAX_VALUE_COUNT; ++i) {
+		this->parameters.values[i] = convertOptions.value.f[i];
+		this->parameters.commands[i] = convertOptions.getCommand(i);
+	}
+	this->parameters.transition = convertOptions.transition;
 }
 
-bool convertFloatTransition(MessageType dstType, Message &dst, float src, uint8_t command, uint16_t transition,
+
+// conversion without prepared converter
+// -------------------------------------
+
+bool convertSwitch(MessageType dstType, Message &dst, uint8_t src, ConvertOptions const &convertOptions) {
+	Converter converter;
+	converter.init(dstType, convertOptions);
+	return converter.convertSwitch(dst, src);
+}
+
+bool convertInt8(MessageType dstType, Message &dst, int src, ConvertOptions const &convertOptions) {
+	Converter converter;
+	converter.init(dstType, convertOptions);
+	return converter.convertInt8(dst, src);
+}
+
+bool convertFloat(MessageType dstType, Message &dst, float src, ConvertOptions const &convertOptions) {
+	Converter converter;
+	converter.init(dstType, convertOptions);
+	return converter.convertFloat(dst, src);
+}
+
+bool convertFloatCommand(MessageType dstType, Message &dst, float src, uint8_t command,
 	ConvertOptions const &convertOptions)
 {
-	// sanity check
-	if ((dstType & PlugType::CMD) == 0)
-		return false;
-
-	switch (dstType & PlugType::CATEGORY) {
-	case PlugType::LIGHTING:
-		dst.value.f32 = src;
-		dst.command = command;
-		dst.transition = transition;
-		break;
-	default:
-		// conversion failed
-		return false;
-	}
+	Converter converter;
+	converter.init(dstType, convertOptions);
+	return converter.convertFloatCommand(dst, src, command);
+}
 
-	// conversion successful
-	return true;
+bool convertFloatTransition(MessageType dstType, Message &dst, float src, uint8_t command, uint16_t transition,
+	ConvertOptions const &convertOptions)
+{
+	Converter converter;
+	converter.init(dstType, convertOptions);
+	return converter.convertFloatTransition(dst, src, command, transition);
 }
@@ -62,6 +62,75 @@ Usage getUsage(MessageType type);
 
 bool isCompatible(MessageType dstType, MessageType srcType);
 
+
+/**
+ * Convert options in a form that is ready for use by the conversion functions
+ */
+struct ConvertParameters {
+	// values for conversion from switch to set/step value or comparison against a threshold
+	float values[ConvertOptions::MAX_VALUE_COUNT];
+
+	// transition in 1/10s
+	uint16_t transition;
+
+	// mapping from input command to output command, extracted from ConvertOptions::commands
+	uint8_t commands[ConvertOptions::MAX_VALUE_COUNT];
+};
+
+/**
+ * Conversion functions for a class of destination message types, one function for each kind of source message
+ */
+struct ConvertFunctions {
+	bool (*convertSwitch)(Message &dst, uint8_t src, ConvertParameters const &parameters);
+	bool (*convertInt8)(Message &dst, int src, ConvertParameters const &parameters);
+	bool (*convertFloat)(Message &dst, float src, ConvertParameters const &parameters);
+	bool (*convertFloatCommand)(Message &dst, float src, uint8_t command, ConvertParameters const &parameters);
+	bool (*convertFloatTransition)(Message &dst, float src, uint8_t command, uint16_t transition,
+		ConvertParameters const &parameters);
+
+	// functions for destination types that can't be converted to
+	static ConvertFunctions const none;
+};
+
+/**
+ * Message converter for a connection. The conversion functions and parameters get selected once in init() so that
+ * converting a message is a single indirect call
+ */
+class Converter {
+public:
+	/**
+	 * Select conversion functions and prepare the parameters
+	 * @param dstType destination message type
+	 * @param convertOptions convert options of the connection
+	 */
+	void init(MessageType dstType, ConvertOptions const &convertOptions);
+
+	bool convertSwitch(Message &dst, uint8_t src) const {
+		return this->functions->convertSwitch(dst, src, this->parameters);
+	}
+
+	bool convertInt8(Message &dst, int src) const {
+		return this->functions->convertInt8(dst, src, this->parameters);
+	}
+
+	bool convertFloat(Message &dst, float src) const {
+		return this->functions->convertFloat(dst, src, this->parameters);
+	}
+
+	bool convertFloatCommand(Message &dst, float src, uint8_t command) const {
+		return this->functions->convertFloatCommand(dst, src, command, this->parameters);
+	}
+
+	bool convertFloatTransition(Message &dst, float src, uint8_t command, uint16_t transition) const {
+		return this->functions->convertFloatTransition(dst, src, command, transition, this->parameters);
+	}
+
+protected:
+	ConvertFunctions const *functions = &ConvertFunctions::none;
+	ConvertParameters parameters;
+};
+
+// convert messages without a prepared Converter, e.g. for messages that are received only once
 bool convertSwitch(MessageType dstType, Message &dst, uint8_t src, ConvertOptions const &convertOptions);
 bool convertInt8(MessageType dstType, Message &dst, int src, ConvertOptions const &convertOptions);
 bool convertFloat(MessageType dstType, Message &dst, float src, ConvertOptions const &convertOptions);
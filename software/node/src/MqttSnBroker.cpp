@@ -2,6 +2,7 @@
 #include <Timer.hpp>
 #include <StringOperators.hpp>
 #include <appConfig.hpp>
+#include <boardConfig.hpp>
 
 #define DEBUG_PRINT
 
@@ -746,15 +747,19 @@ Coroutine MqttSnBroker::publish() {
 }
 */
 Coroutine MqttSnBroker::receive() {
-	uint8_t message[MAX_MESSAGE_LENGTH];
+	static_assert(PACKET_POOL_SIZE >= MAX_MESSAGE_LENGTH);
 
 	while (true) {
 		auto &thisName = this->connections[0].name;
 
-		// receive a message from the gateway or a client
+		// receive a message from the gateway or a client, the buffer is also used to build responses
 		Network::Endpoint source;
-		int length = MAX_MESSAGE_LENGTH;
-		co_await Network::receive(NETWORK_MQTT, source, length, message);
+		PacketBuffer packet;
+		co_await Network::receive(NETWORK_MQTT, source, packet);
+		if (!packet.isValid())
+			continue;
+		int length = min(packet.getLength(), MAX_MESSAGE_LENGTH);
+		auto &message = *reinterpret_cast<uint8_t (*)[MAX_MESSAGE_LENGTH]>(packet.data());
 
 		// create message reader and check if complete (length of message longer than what was received)
 		PacketReader r(message);
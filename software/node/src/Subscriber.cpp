@@ -1,4 +1,6 @@
 #include "Subscriber.hpp"
+#include "FlightRecorder.hpp"
+#include <util.hpp>
 
 static void setInfo(SubscriberParameters &p, Subscriber const &subscriber) {
 	p.info.connectionIndex = subscriber.connectionIndex;
@@ -7,85 +9,135 @@ static void setInfo(SubscriberParameters &p, Subscriber const &subscriber) {
 	//p.info.type = subscriber.info.type;
 }
 
-void SubscriberList::publishSwitch(uint8_t plugIndex, uint8_t value) {
-	for (auto &subscriber: *this) {
-		// check if this is the right plug
-		if (subscriber.data->source.plugIndex == plugIndex) {
-			// resume subscriber
-			subscriber.target.barrier->resumeFirst([&subscriber, value](SubscriberParameters &p) {
-				setInfo(p, subscriber);
-
-				// convert to destination message type and resume coroutine if conversion was successful
-				auto &dst = *reinterpret_cast<Message *>(p.message);
-				return convertSwitch(subscriber.target.type, dst, value, subscriber.data->convertOptions);
-			});
-		}
+void SubscriberList::rebuild() {
+	delete [] this->table;
+	delete [] this->offsets;
+	this->table = nullptr;
+	this->offsets = nullptr;
+	this->plugCount = 0;
+	this->generation = Subscriber::generation;
+
+	// determine number of plugs and subscribers
+	int count = 0;
+	for (auto &subscriber : *this) {
+		this->plugCount = max(this->plugCount, subscriber.data->source.plugIndex + 1);
+		++count;
 	}
+	if (count == 0)
+		return;
+
+	// count subscribers per plug
+	this->offsets = new uint16_t[this->plugCount + 1];
+	array::fill(this->plugCount + 1, this->offsets, 0);
+	for (auto &subscriber : *this)
+		++this->offsets[subscriber.data->source.plugIndex + 1];
+	for (int i = 0; i < this->plugCount; ++i)
+		this->offsets[i + 1] += this->offsets[i];
+
+	// sort subscribers by plug, keep the order of the list for each plug
+	this->table = new Subscriber*[count];
+	uint16_t positions[256];
+	array::copy(this->plugCount, positions, this->offsets);
+	for (auto &subscriber : *this)
+		this->table[positions[subscriber.data->source.plugIndex]++] = &subscriber;
 }
 
-void SubscriberList::publishInt8(uint8_t plugIndex, int8_t value) {
-	for (auto &subscriber: *this) {
-		// check if this is the right plug
-		if (subscriber.data->source.plugIndex == plugIndex) {
-			// resume subscriber
-			subscriber.target.barrier->resumeFirst([&subscriber, value](SubscriberParameters &p) {
-				setInfo(p, subscriber);
-
-				// convert to destination message type and resume coroutine if conversion was successful
-				auto &dst = *reinterpret_cast<Message *>(p.message);
-				return convertInt8(subscriber.target.type, dst, value, subscriber.data->convertOptions);
-			});
+template <typename F>
+void SubscriberList::publish(uint8_t plugIndex, F const &convert) {
+	if (this->generation != Subscriber::generation)
+		rebuild();
+	if (plugIndex >= this->plugCount)
+		return;
+
+	int begin = this->offsets[plugIndex];
+	int end = this->offsets[plugIndex + 1];
+
+	// serials of the subscribers that were resumed, only checked after a resumed coroutine has changed the
+	// subscriptions. Serials instead of pointers as a subscriber may get destroyed and a new one allocated at its address
+	uint32_t buffer[32];
+	int capacity = max(end - begin, array::count(buffer));
+	uint32_t *resumed = capacity <= array::count(buffer) ? buffer : new uint32_t[capacity];
+	int resumedCount = 0;
+	bool changed = false;
+
+	for (int i = begin; i < end; ++i) {
+		auto &subscriber = *this->table[i];
+		if (changed) {
+			// skip subscribers that were resumed before the subscriptions changed
+			int j = 0;
+			while (j < resumedCount && resumed[j] != subscriber.serial)
+				++j;
+			if (j < resumedCount)
+				continue;
+		}
+		resumed[resumedCount++] = subscriber.serial;
+
+		// resume subscriber
+		subscriber.target.barrier->resumeFirst([&subscriber, &convert](SubscriberParameters &p) {
+			setInfo(p, subscriber);
+
+			// convert to destination message type and resume coroutine if conversion was successful
+			auto &dst = *reinterpret_cast<Message *>(p.message);
+			if (!convert(subscriber, dst))
+				return false;
+			FlightRecorder::record(subscriber, dst);
+			return true;
+		});
+
+		if (this->generation != Subscriber::generation) {
+			// a resumed coroutine has changed the subscriptions: rebuild the table and continue with the subscribers
+			// of the plug that were not resumed yet
+			changed = true;
+			rebuild();
+			if (plugIndex >= this->plugCount)
+				break;
+			i = this->offsets[plugIndex] - 1;
+			end = this->offsets[plugIndex + 1];
+
+			// make sure that the serials of all subscribers of the plug fit
+			int count = resumedCount + end - this->offsets[plugIndex];
+			if (count > capacity) {
+				auto r = new uint32_t[count];
+				array::copy(resumedCount, r, resumed);
+				if (resumed != buffer)
+					delete [] resumed;
+				resumed = r;
+				capacity = count;
+			}
 		}
 	}
+	if (resumed != buffer)
+		delete [] resumed;
+}
+
+void SubscriberList::publishSwitch(uint8_t plugIndex, uint8_t value) {
+	publish(plugIndex, [value](Subscriber const &subscriber, Message &dst) {
+		return subscriber.converter.convertSwitch(dst, value);
+	});
+}
+
+void SubscriberList::publishInt8(uint8_t plugIndex, int8_t value) {
+	publish(plugIndex, [value](Subscriber const &subscriber, Message &dst) {
+		return subscriber.converter.convertInt8(dst, value);
+	});
 }
 
 void SubscriberList::publishFloat(uint8_t plugIndex, float value) {
-	for (auto &subscriber: *this) {
-		// check if this is the right plug
-		if (subscriber.data->source.plugIndex == plugIndex) {
-			// resume subscriber
-			subscriber.target.barrier->resumeFirst([&subscriber, value](SubscriberParameters &p) {
-				setInfo(p, subscriber);
-
-				// convert to destination message type and resume coroutine if conversion was successful
-				auto &dst = *reinterpret_cast<Message *>(p.message);
-				return convertFloat(subscriber.target.type, dst, value, subscriber.data->convertOptions);
-			});
-		}
-	}
+	publish(plugIndex, [value](Subscriber const &subscriber, Message &dst) {
+		return subscriber.converter.convertFloat(dst, value);
+	});
 }
 
 void SubscriberList::publishFloatCommand(uint8_t plugIndex, float value, uint8_t command) {
-	for (auto &subscriber: *this) {
-		// check if this is the right plug
-		if (subscriber.data->source.plugIndex == plugIndex) {
-			// resume subscriber
-			subscriber.target.barrier->resumeFirst([&subscriber, value, command](SubscriberParameters &p) {
-				setInfo(p, subscriber);
-
-				// convert to destination message type and resume coroutine if conversion was successful
-				auto &dst = *reinterpret_cast<Message *>(p.message);
-				return convertFloatCommand(subscriber.target.type, dst, value, command, subscriber.data->convertOptions);
-			});
-		}
-	}
+	publish(plugIndex, [value, command](Subscriber const &subscriber, Message &dst) {
+		return subscriber.converter.convertFloatCommand(dst, value, command);
+	});
 }
 
 void SubscriberList::publishFloatTransition(uint8_t plugIndex, float value, uint8_t command, uint16_t transition) {
-	for (auto &subscriber: *this) {
-		// check if this is the right plug
-		if (subscriber.data->source.plugIndex == plugIndex) {
-			// resume subscriber
-			subscriber.target.barrier->resumeFirst([&subscriber, value, command, transition](SubscriberParameters &p) {
-				setInfo(p, subscriber);
-
-				// convert to destination message type and resume coroutine if conversion was successful
-				auto &dst = *reinterpret_cast<Message *>(p.message);
-				return convertFloatTransition(subscriber.target.type, dst,
-					value, command, transition, subscriber.data->convertOptions);
-			});
-		}
-	}
+	publish(plugIndex, [value, command, transition](Subscriber const &subscriber, Message &dst) {
+		return subscriber.converter.convertFloatTransition(dst, value, command, transition);
+	});
 }
 
 
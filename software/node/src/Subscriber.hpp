@@ -62,20 +62,71 @@ struct SubscriberTarget {
  */
 class Subscriber : public LinkedListNode {
 public:
+	~Subscriber() {++Subscriber::generation;}
+
+	/**
+	 * Remove the subscriber from its list (unsubscribe)
+	 */
+	void remove() noexcept {
+		LinkedListNode::remove();
+		++Subscriber::generation;
+	}
+
 	Connection const *data;
 
+	// destination interface and element, only used for diagnostics (see FlightRecorder)
+	uint8_t interfaceId;
 	uint8_t elementId;
 	uint8_t connectionIndex;
 
 	SubscriberTarget target;
+
+	// converter from the source message to target.type, initialized with the convert options of the connection
+	Converter converter;
+
+	// unique number of the subscriber, identifies it during a publish even if a new subscriber gets the same address
+	uint32_t serial = ++Subscriber::serialCounter;
+
+	// gets incremented when a subscriber is added or removed so that the dispatch tables get rebuilt
+	static inline uint32_t generation = 1;
+
+	// number of subscribers created so far
+	static inline uint32_t serialCounter = 0;
 };
 
 
 /**
- * List of subscribers with methods to publish messages to the subscribers
+ * List of subscribers with methods to publish messages to the subscribers. For publishing, the list keeps a dispatch
+ * table that groups the subscribers by source plug index so that a publish only visits the subscribers of the plug.
+ * The table gets rebuilt on the next publish after subscribers were added or removed anywhere, e.g. in
+ * RoomControl::connect()
  */
 class SubscriberList : public LinkedList<Subscriber> {
 public:
+	SubscriberList() = default;
+	~SubscriberList() {
+		delete [] this->table;
+		delete [] this->offsets;
+	}
+
+	/**
+	 * Add a subscriber to the list
+	 * @param subscriber subscriber to add, data must be set
+	 */
+	void add(Subscriber &subscriber) {
+		LinkedList::add(subscriber);
+		++Subscriber::generation;
+	}
+
+	/**
+	 * Move all subscribers of another list to this list, the other list must be destroyed afterwards
+	 * @param list list to move
+	 */
+	void add(SubscriberList &list) {
+		LinkedList::add(list);
+		++Subscriber::generation;
+	}
+
 	/**
 	 * Publish switch message to subscribers to given plug
 	 * @param plugIndex plug index
@@ -108,6 +159,23 @@ public:
 	 * @param transition transition in 1/10s
 	 */
 	void publishFloatTransition(uint8_t plugIndex, float value, uint8_t command, uint16_t transition);
+
+protected:
+
+	// rebuild the dispatch table from the list
+	void rebuild();
+
+	// resume the subscribers of a plug using the given function to convert the message
+	template <typename F>
+	void publish(uint8_t plugIndex, F const &convert);
+
+	// subscribers sorted by source plug index, table[offsets[p]] to table[offsets[p + 1] - 1] subscribe to plug p
+	Subscriber **table = nullptr;
+	uint16_t *offsets = nullptr;
+	int plugCount = 0;
+
+	// generation of the dispatch table, see Subscriber::generation
+	uint32_t generation = 0;
 };
 
 
@@ -1,503 +1,188 @@
-String getTypeLabel(PlugType type) {
-	switch (type & PlugType::CATEGORY) {
-	case PlugType::BINARY:
-		switch (type & PlugType::BINARY_CATEGORY) {
-		case PlugType::BINARY_BUTTON:
-			switch (type & PlugType::BINARY_BUTTON_CATEGORY) {
-			case PlugType::BINARY_BUTTON_WALL:
-				return "Wall Button";
-			default:
-				return "Button";
-			}
-		case PlugType::BINARY_SWITCH:
-			switch (type & PlugType::BINARY_SWITCH_CATEGORY) {
-			case PlugType::BINARY_SWITCH_WALL:
-				return "Wall Switch";
-			default:
-				return "Switch";
-			}
-		case PlugType::BINARY_POWER:
-			switch (type & PlugType::BINARY_POWER_CATEGORY) {
-			case PlugType::BINARY_POWER_LIGHT:
-				return "Light Power";
-			case PlugType::BINARY_POWER_FREEZER:
-				return "Freezer Power";
-			case PlugType::BINARY_POWER_FRIDGE:
-				return "Fridge Power";
-			case PlugType::BINARY_POWER_AC:
-				return "AC Power";
-			case PlugType::BINARY_POWER_OVEN:
-				return "Oven Power";
-			case PlugType::BINARY_POWER_COOKER:
-				return "Cooker Power";
-			case PlugType::BINARY_POWER_COFFEE:
-				return "Coffee M. Power";
-			case PlugType::BINARY_POWER_DISHWASHER:
-				return "Dishwasher Power";
-			case PlugType::BINARY_POWER_WASHING:
-				return "Washing M. Power";
-			case PlugType::BINARY_POWER_HIFI:
-				return "Hi-Fi Power";
-			case PlugType::BINARY_POWER_TV:
-				return "TV Power";
-			default:
-				return "Power State";
-			}
-		case PlugType::BINARY_OPENING:
-			switch (type & PlugType::BINARY_OPENING_CATEGORY) {
-			case PlugType::BINARY_OPENING_GATE:
-				return "Gate Opening";
-			case PlugType::BINARY_OPENING_DOOR:
-				return "Door Opening";
-			case PlugType::BINARY_OPENING_WINDOW:
-				return "Window Opening";
-			case PlugType::BINARY_OPENING_BLIND:
-				return "Blind Opening";
-			case PlugType::BINARY_OPENING_SLAT:
-				return "Slat Opening";
-			case PlugType::BINARY_OPENING_VALVE:
-				return "Valve Opening";
-			default:
-				return "Opening State";
-			}
-		case PlugType::BINARY_LOCK:
-			switch (type & PlugType::BINARY_LOCK_CATEGORY) {
-			case PlugType::BINARY_LOCK_GATE:
-				return "Gate Lock";
-			case PlugType::BINARY_LOCK_DOOR:
-				return "Door Lock";
-			case PlugType::BINARY_LOCK_WINDOW:
-				return "Window Lock";
-			default:
-				return "Lock";
-			}
-		case PlugType::BINARY_OCCUPANCY:
-			return "Occupancy";
-		case PlugType::BINARY_ALARM:
-			return "Alarm";
-		case PlugType::BINARY_SOUND:
-			switch (type & PlugType::BINARY_SOUND_CATEGORY) {
-			case PlugType::BINARY_SOUND_EVENT:
-				return "Event Sound";
-			case PlugType::BINARY_SOUND_ACTIVATION:
-				return "Activation Sound";
-			case PlugType::BINARY_SOUND_DEACTIVATION:
-				return "Deactivation Sound";
-			case PlugType::BINARY_SOUND_INFORMATION:
-				return "Information Sound";
-			case PlugType::BINARY_SOUND_WARNING:
-				return "Warning Sound";
-			case PlugType::BINARY_SOUND_DOORBELL:
-				return "Doorbell Sound";
-			case PlugType::BINARY_SOUND_CALL:
-				return "Call Sound";
-			case PlugType::BINARY_SOUND_ALARM:
-				return "Alarm Sound";
-			default:
-				return "Sound";
-			}
-		case PlugType::BINARY_ENABLE_CLOSE:
-			return "Enable Close";
-		default:
-			return "Binary";
-		}
-	case PlugType::TERNARY:
-		switch (type & PlugType::TERNARY_CATEGORY) {
-		case PlugType::TERNARY_ROCKER:
-			switch (type & PlugType::TERNARY_ROCKER_CATEGORY) {
-			case PlugType::TERNARY_ROCKER_WALL:
-				return "Wall Rocker";
-			default:
-				return "Rocker";
-			}
-		case PlugType::TERNARY_SWITCH:
-			switch (type & PlugType::TERNARY_SWITCH_CATEGORY) {
-			case PlugType::TERNARY_SWITCH_WALL:
-				return "Wall Switch";
-			default:
-				return "Switch";
-			}
-		case PlugType::TERNARY_OPENING:
-			switch (type & PlugType::TERNARY_OPENING_CATEGORY) {
-			case PlugType::TERNARY_OPENING_GATE:
-				return "Gate Drive";
-			case PlugType::TERNARY_OPENING_DOOR:
-				return "Door Drive";
-			case PlugType::TERNARY_OPENING_WINDOW:
-				return "Window Drive";
-			case PlugType::TERNARY_OPENING_BLIND:
-				return "Blind Drive";
-			case PlugType::TERNARY_OPENING_SLAT:
-				return "Slat Drive";
-			case PlugType::TERNARY_OPENING_VALVE:
-				return "Valve Drive";
-			default:
-				return "Opening Drive";
-			}
-		case PlugType::TERNARY_LOCK:
-			switch (type & PlugType::TERNARY_LOCK_CATEGORY) {
-			case PlugType::TERNARY_LOCK_DOOR:
-				return "Door Lock";
-			case PlugType::TERNARY_LOCK_WINDOW:
-				return "Window Lock";
-			default:
-				return "Lock State";
-			}
-		default:
-			return "Ternary";
-		}
-	case PlugType::MULTISTATE:
-		switch (type & PlugType::MULTISTATE_CATEGORY) {
-		case PlugType::MULTISTATE_THERMOSTAT_MODE:
-			return "Mode";
-		default:
-			return "Multistate";
-		}
-	case PlugType::ENCODER:
-		return "Encoder";
-	case PlugType::ENUM:
-		return "Enum";
-	case PlugType::LEVEL:
-		switch (type & PlugType::LEVEL_CATEGORY) {
-		case PlugType::LEVEL_OPENING:
-			switch (type & PlugType::LEVEL_OPENING_CATEGORY) {
-			case PlugType::LEVEL_OPENING_GATE:
-				return "Gate Level";
-			case PlugType::LEVEL_OPENING_DOOR:
-				return "Door Level";
-			case PlugType::LEVEL_OPENING_WINDOW:
-				return "Window Level";
-			case PlugType::LEVEL_OPENING_BLIND:
-				return "Blind Level";
-			case PlugType::LEVEL_OPENING_SLAT:
-				return "Slat Level";
-			case PlugType::LEVEL_OPENING_VALVE:
-				return "Valve Level";
-			default:
-				return "Opening Level";
-			}
-		case PlugType::LEVEL_BATTERY:
-			return "Battery Level";
-		case PlugType::LEVEL_TANK:
-			return "Tank Level";
-		default:
-			return "Level";
-		}
-	case PlugType::PHYSICAL:
-		switch (type & PlugType::PHYSICAL_CATEGORY) {
-		case PlugType::PHYSICAL_TEMPERATURE:
-			switch (type & PlugType::PHYSICAL_TEMPERATURE_CATEGORY) {
-			case PlugType::PHYSICAL_TEMPERATURE_MEASURED:
-				switch (type & PlugType::PHYSICAL_TEMPERATURE_MEASURED_CATEGORY) {
-				case PlugType::PHYSICAL_TEMPERATURE_MEASURED_FREEZER:
-					return "Measured Temp.";
-				case PlugType::PHYSICAL_TEMPERATURE_MEASURED_FRIDGE:
-					return "Measured Temp.";
-				case PlugType::PHYSICAL_TEMPERATURE_MEASURED_OUTDOOR:
-					return "Measured Temp.";
-				case PlugType::PHYSICAL_TEMPERATURE_MEASURED_ROOM:
-					return "Measured Temp.";
-				case PlugType::PHYSICAL_TEMPERATURE_MEASURED_OVEN:
-					return "Measured Temp.";
-				default:
-					return "Measured Temp.";
-				}
-			case PlugType::PHYSICAL_TEMPERATURE_SETPOINT:
-				switch (type & PlugType::PHYSICAL_TEMPERATURE_SETPOINT_CATEGORY) {
-				case PlugType::PHYSICAL_TEMPERATURE_SETPOINT_FREEZER:
-					return "Setpoint Temp.";
-				case PlugType::PHYSICAL_TEMPERATURE_SETPOINT_FRIDGE:
-					return "Setpoint Temp.";
-				case PlugType::PHYSICAL_TEMPERATURE_SETPOINT_COOLER:
-					return "Setpoint Temp.";
-				case PlugType::PHYSICAL_TEMPERATURE_SETPOINT_HEATER:
-					return "Setpoint Temp.";
-				case PlugType::PHYSICAL_TEMPERATURE_SETPOINT_OVEN:
-					return "Setpoint Temp.";
-				default:
-					return "Setpoint Temp.";
-				}
-			default:
-				return "Temperature";
-			}
-		case PlugType::PHYSICAL_PRESSURE:
-			switch (type & PlugType::PHYSICAL_PRESSURE_CATEGORY) {
-			case PlugType::PHYSICAL_PRESSURE_MEASURED:
-				switch (type & PlugType::PHYSICAL_PRESSURE_MEASURED_CATEGORY) {
-				case PlugType::PHYSICAL_PRESSURE_MEASURED_ATMOSPHERE:
-					return "Measured Pressure";
-				default:
-					return "Measured Pressure";
-				}
-			case PlugType::PHYSICAL_PRESSURE_SETPOINT:
-				return "Pressure Setpoint";
-			default:
-				return "Pressure";
-			}
-		case PlugType::PHYSICAL_VOLTAGE:
-			switch (type & PlugType::PHYSICAL_VOLTAGE_CATEGORY) {
-			case PlugType::PHYSICAL_VOLTAGE_MEASURED:
-				switch (type & PlugType::PHYSICAL_VOLTAGE_MEASURED_CATEGORY) {
-				case PlugType::PHYSICAL_VOLTAGE_MEASURED_LOW:
-					return "Measured Voltage";
-				case PlugType::PHYSICAL_VOLTAGE_MEASURED_MAINS:
-					return "Measured Voltage";
-				case PlugType::PHYSICAL_VOLTAGE_MEASURED_HIGH:
-					return "Measured Voltage";
-				default:
-					return "Measured Voltage";
-				}
-			case PlugType::PHYSICAL_VOLTAGE_SETPOINT:
-				return "Voltage Setpoint";
-			default:
-				return "Voltage";
-			}
-		case PlugType::PHYSICAL_CURRENT:
-			switch (type & PlugType::PHYSICAL_CURRENT_CATEGORY) {
-			case PlugType::PHYSICAL_CURRENT_MEASURED:
-				return "Measured Curent";
-			case PlugType::PHYSICAL_CURRENT_SETPOINT:
-				return "Curent Setpoint";
-			default:
-				return "Current";
-			}
-		case PlugType::PHYSICAL_POWER:
-			switch (type & PlugType::PHYSICAL_POWER_CATEGORY) {
-			case PlugType::PHYSICAL_POWER_MEASURED:
-				return "Measured Power";
-			case PlugType::PHYSICAL_POWER_SETPOINT:
-				return "Power Setpoint";
-			default:
-				return "Power";
-			}
-		case PlugType::PHYSICAL_ILLUMINANCE:
-			return "Illuminance";
-		default:
-			return "Physical";
-		}
-	case PlugType::CONCENTRATION:
-		switch (type & PlugType::CONCENTRATION_CATEGORY) {
-		case PlugType::CONCENTRATION_RELATIVE_HUMIDITY:
-			switch (type & PlugType::CONCENTRATION_RELATIVE_HUMIDITY_CATEGORY) {
-			case PlugType::CONCENTRATION_RELATIVE_HUMIDITY_MEASURED:
-				switch (type & PlugType::CONCENTRATION_RELATIVE_HUMIDITY_MEASURED_CATEGORY) {
-				case PlugType::CONCENTRATION_RELATIVE_HUMIDITY_MEASURED_AIR:
-					return "Measured Humidity";
-				default:
-					return "Measured Humidity";
-				}
-			case PlugType::CONCENTRATION_RELATIVE_HUMIDITY_SETPOINT:
-				return "Setpoint Temp.";
-			default:
-				return "Humidity";
-			}
-		case PlugType::CONCENTRATION_VOC:
-			return "Volatile Organic";
-		case PlugType::CONCENTRATION_CARBON_MONOXIDE:
-			return "Carbon Monox.";
-		case PlugType::CONCENTRATION_CARBON_DIOXIDE:
-			return "Carbon Diox.";
-		default:
-			return "Concentration";
-		}
-	case PlugType::LIGHTING:
-		switch (type & PlugType::LIGHTING_CATEGORY) {
-		case PlugType::LIGHTING_BRIGHTNESS:
-			return "Brightness";
-		case PlugType::LIGHTING_COLOR_TEMPERATURE:
-			return "Color Temp.";
-		case PlugType::LIGHTING_COLOR_PARAMETER:
-			switch (type & PlugType::LIGHTING_COLOR_PARAMETER_CATEGORY) {
-			case PlugType::LIGHTING_COLOR_PARAMETER_CHROMATICITY_X:
-				return "Color X";
-			case PlugType::LIGHTING_COLOR_PARAMETER_CHROMATICITY_Y:
-				return "Color Y";
-			case PlugType::LIGHTING_COLOR_PARAMETER_HUE:
-				return "Hue";
-			case PlugType::LIGHTING_COLOR_PARAMETER_SATURATION:
-				return "Saturation";
-			default:
-				return "Color Parameter";
-			}
-		default:
-			return "Lighting";
-		}
-	case PlugType::METERING:
-		switch (type & PlugType::METERING_CATEGORY) {
-		case PlugType::METERING_ELECTRIC:
-			switch (type & PlugType::METERING_ELECTRIC_CATEGORY) {
-			case PlugType::METERING_ELECTRIC_USAGE:
-				switch (type & PlugType::METERING_ELECTRIC_USAGE_CATEGORY) {
-				case PlugType::METERING_ELECTRIC_USAGE_PEAK:
-					return "Peak Usage";
-				case PlugType::METERING_ELECTRIC_USAGE_OFF_PEAK:
-					return "Off-Peak Usage";
-				default:
-					return "Energy Usage";
-				}
-			case PlugType::METERING_ELECTRIC_SUPPLY:
-				switch (type & PlugType::METERING_ELECTRIC_SUPPLY_CATEGORY) {
-				case PlugType::METERING_ELECTRIC_SUPPLY_PEAK:
-					return "Peak Supply";
-				case PlugType::METERING_ELECTRIC_SUPPLY_OFF_PEAK:
-					return "Off-Peak Supply";
-				default:
-					return "Supply";
-				}
-			default:
-				return "Electric Meter";
-			}
-		case PlugType::METERING_WATER:
-			return "Water Meter";
-		case PlugType::METERING_GAS:
-			return "Gas Meter";
-		default:
-			return "Metering";
-		}
-	default:
-		return {};
+// info for a type
+struct TypeInfo {
+	// type without direction and command flag
+	uint16_t type;
+
+	// label in typeLabels
+	uint16_t labelOffset;
+	uint8_t labelLength;
+
+	// lowest bit of the category of this type
+	uint8_t bitIndex;
+
+	// category of the sub-types and their range in typeInfos (count is zero if the type has no sub-types)
+	uint8_t childBitIndex;
+	uint8_t childBitCount;
+	uint8_t firstChild;
+	uint8_t childCount;
+
+	// usage (inherited from parent if the type has no usage) and usage in a command message
+	Usage usage;
+	Usage commandUsage;
+
+	// first type on the path that is compatible to all its sub-types (the type itself and hasRoot is false if there is
+	// none)
+	uint8_t root;
+	bool hasRoot;
+};
+
+static char const typeLabels[] = "BinaryTernaryMultistateEncoderEnumLevelPhysicalConcentrationLightingMeteringButtonSwitchPower StateOpening StateLockOccupancyAlarmSoundEnable CloseWall ButtonWall SwitchLight PowerFreezer PowerFridge PowerAC PowerOven PowerCooker PowerCoffee M. PowerDishwasher PowerWashing M. PowerHi-Fi PowerTV PowerGate OpeningDoor OpeningWindow OpeningBlind OpeningSlat OpeningValve OpeningGate LockDoor LockWindow LockEvent SoundActivation SoundDeactivation SoundInformation SoundWarning SoundDoorbell SoundCall SoundAlarm SoundRockerOpening DriveLock StateWall RockerGate DriveDoor DriveWindow DriveBlind DriveSlat DriveValve DriveModeOpening LevelBattery LevelTank LevelGate LevelDoor LevelWindow LevelBlind LevelSlat LevelValve LevelTemperaturePressureVoltageCurrentPowerIlluminanceMeasured Temp.Setpoint Temp.Measured PressurePressure SetpointMeasured VoltageVoltage SetpointMeasured CurentCurent SetpointMeasured PowerPower SetpointHumidityVolatile OrganicCarbon Monox.Carbon Diox.Measured HumidityBrightnessColor Temp.Color ParameterColor XColor YHueSaturationElectric MeterWater MeterGas MeterEnergy UsageSupplyPeak UsageOff-Peak UsagePeak SupplyOff-Peak Supply";
+
+static TypeInfo const typeInfos[] = {
+	{0x0000, 0, 0, 9, 9, 4, 1, 10, Usage::NONE, Usage::NONE, 0, false},
+	{0x0200, 0, 6, 9, 5, 4, 11, 9, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0400, 6, 7, 9, 5, 4, 50, 4, Usage::OFF_ON1_ON2, Usage::OFF_ON1_ON2, 2, true},
+	{0x0600, 13, 10, 9, 5, 4, 64, 1, Usage::NONE, Usage::NONE, 3, false},
+	{0x0800, 23, 7, 9, 0, 0, 0, 0, Usage::NONE, Usage::NONE, 4, true},
+	{0x0a00, 30, 4, 9, 0, 0, 0, 0, Usage::NONE, Usage::NONE, 5, true},
+	{0x0c00, 34, 5, 9, 6, 3, 65, 3, Usage::PERCENT, Usage::PERCENT, 6, false},
+	{0x0e00, 39, 8, 9, 5, 4, 74, 6, Usage::NONE, Usage::NONE, 7, false},
+	{0x1000, 47, 13, 9, 4, 5, 104, 4, Usage::NONE, Usage::NONE, 8, false},
+	{0x1200, 60, 8, 9, 5, 4, 111, 3, Usage::NONE, Usage::NONE, 9, false},
+	{0x1400, 68, 8, 9, 5, 4, 118, 3, Usage::COUNTER, Usage::COUNTER, 10, false},
+	{0x0220, 76, 6, 5, 2, 3, 20, 1, Usage::RELEASED_PRESSED, Usage::RELEASED_PRESSED, 1, true},
+	{0x0240, 82, 6, 5, 2, 3, 21, 1, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0260, 88, 11, 5, 1, 4, 22, 11, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0280, 99, 13, 5, 1, 4, 33, 6, Usage::CLOSED_OPEN, Usage::CLOSED_OPEN_TOGGLE, 1, true},
+	{0x02a0, 112, 4, 5, 2, 3, 39, 3, Usage::LOCK, Usage::LOCK_TOGGLE, 1, true},
+	{0x02c0, 116, 9, 5, 0, 0, 0, 0, Usage::OCCUPANCY, Usage::OCCUPANCY, 1, true},
+	{0x02e0, 125, 5, 5, 0, 0, 0, 0, Usage::ACTIVATION, Usage::ACTIVATION, 1, true},
+	{0x0300, 130, 5, 5, 1, 4, 42, 8, Usage::SOUND, Usage::SOUND, 1, true},
+	{0x0320, 135, 12, 5, 0, 0, 0, 0, Usage::ENABLED, Usage::ENABLED, 1, true},
+	{0x0224, 147, 11, 2, 0, 0, 0, 0, Usage::RELEASED_PRESSED, Usage::RELEASED_PRESSED, 1, true},
+	{0x0244, 158, 11, 2, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0262, 169, 11, 1, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0264, 180, 13, 1, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0266, 193, 12, 1, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0268, 205, 8, 1, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x026a, 213, 10, 1, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x026c, 223, 12, 1, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x026e, 235, 15, 1, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0270, 250, 16, 1, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0272, 266, 16, 1, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0274, 282, 11, 1, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0276, 293, 8, 1, 0, 0, 0, 0, Usage::OFF_ON, Usage::OFF_ON_TOGGLE, 1, true},
+	{0x0282, 301, 12, 1, 0, 0, 0, 0, Usage::CLOSED_OPEN, Usage::CLOSED_OPEN_TOGGLE, 1, true},
+	{0x0284, 313, 12, 1, 0, 0, 0, 0, Usage::CLOSED_OPEN, Usage::CLOSED_OPEN_TOGGLE, 1, true},
+	{0x0286, 325, 14, 1, 0, 0, 0, 0, Usage::CLOSED_OPEN, Usage::CLOSED_OPEN_TOGGLE, 1, true},
+	{0x0288, 339, 13, 1, 0, 0, 0, 0, Usage::CLOSED_OPEN, Usage::CLOSED_OPEN_TOGGLE, 1, true},
+	{0x028a, 352, 12, 1, 0, 0, 0, 0, Usage::CLOSED_OPEN, Usage::CLOSED_OPEN_TOGGLE, 1, true},
+	{0x028c, 364, 13, 1, 0, 0, 0, 0, Usage::CLOSED_OPEN, Usage::CLOSED_OPEN_TOGGLE, 1, true},
+	{0x02a4, 377, 9, 2, 0, 0, 0, 0, Usage::LOCK, Usage::LOCK_TOGGLE, 1, true},
+	{0x02a8, 386, 9, 2, 0, 0, 0, 0, Usage::LOCK, Usage::LOCK_TOGGLE, 1, true},
+	{0x02ac, 395, 11, 2, 0, 0, 0, 0, Usage::LOCK, Usage::LOCK_TOGGLE, 1, true},
+	{0x0302, 406, 11, 1, 0, 0, 0, 0, Usage::SOUND, Usage::SOUND, 1, true},
+	{0x0304, 417, 16, 1, 0, 0, 0, 0, Usage::SOUND, Usage::SOUND, 1, true},
+	{0x0306, 433, 18, 1, 0, 0, 0, 0, Usage::SOUND, Usage::SOUND, 1, true},
+	{0x0308, 451, 17, 1, 0, 0, 0, 0, Usage::SOUND, Usage::SOUND, 1, true},
+	{0x030a, 468, 13, 1, 0, 0, 0, 0, Usage::SOUND, Usage::SOUND, 1, true},
+	{0x030c, 481, 14, 1, 0, 0, 0, 0, Usage::SOUND, Usage::SOUND, 1, true},
+	{0x030e, 495, 10, 1, 0, 0, 0, 0, Usage::SOUND, Usage::SOUND, 1, true},
+	{0x0310, 505, 11, 1, 0, 0, 0, 0, Usage::SOUND, Usage::SOUND, 1, true},
+	{0x0420, 516, 6, 5, 2, 3, 54, 1, Usage::RELEASED_UP_DOWN, Usage::RELEASED_UP_DOWN, 2, true},
+	{0x0440, 82, 6, 5, 2, 3, 55, 1, Usage::OFF_ON1_ON2, Usage::OFF_ON1_ON2, 2, true},
+	{0x0460, 522, 13, 5, 1, 4, 56, 6, Usage::STOPPED_OPENING_CLOSING, Usage::STOPPED_OPENING_CLOSING, 2, true},
+	{0x0480, 535, 10, 5, 2, 3, 62, 2, Usage::TILT_LOCK, Usage::TILT_LOCK, 2, true},
+	{0x0424, 545, 11, 2, 0, 0, 0, 0, Usage::RELEASED_UP_DOWN, Usage::RELEASED_UP_DOWN, 2, true},
+	{0x0444, 158, 11, 2, 0, 0, 0, 0, Usage::OFF_ON1_ON2, Usage::OFF_ON1_ON2, 2, true},
+	{0x0462, 556, 10, 1, 0, 0, 0, 0, Usage::STOPPED_OPENING_CLOSING, Usage::STOPPED_OPENING_CLOSING, 2, true},
+	{0x0464, 566, 10, 1, 0, 0, 0, 0, Usage::STOPPED_OPENING_CLOSING, Usage::STOPPED_OPENING_CLOSING, 2, true},
+	{0x0466, 576, 12, 1, 0, 0, 0, 0, Usage::STOPPED_OPENING_CLOSING, Usage::STOPPED_OPENING_CLOSING, 2, true},
+	{0x0468, 588, 11, 1, 0, 0, 0, 0, Usage::STOPPED_OPENING_CLOSING, Usage::STOPPED_OPENING_CLOSING, 2, true},
+	{0x046a, 599, 10, 1, 0, 0, 0, 0, Usage::STOPPED_OPENING_CLOSING, Usage::STOPPED_OPENING_CLOSING, 2, true},
+	{0x046c, 609, 11, 1, 0, 0, 0, 0, Usage::STOPPED_OPENING_CLOSING, Usage::STOPPED_OPENING_CLOSING, 2, true},
+	{0x0484, 386, 9, 2, 0, 0, 0, 0, Usage::TILT_LOCK, Usage::TILT_LOCK, 2, true},
+	{0x0488, 395, 11, 2, 0, 0, 0, 0, Usage::TILT_LOCK, Usage::TILT_LOCK, 2, true},
+	{0x0620, 620, 4, 5, 0, 0, 0, 0, Usage::NONE, Usage::NONE, 64, true},
+	{0x0c40, 624, 13, 6, 3, 3, 68, 6, Usage::PERCENT, Usage::PERCENT, 65, true},
+	{0x0c80, 637, 13, 6, 0, 0, 0, 0, Usage::PERCENT, Usage::PERCENT, 66, true},
+	{0x0cc0, 650, 10, 6, 0, 0, 0, 0, Usage::PERCENT, Usage::PERCENT, 67, true},
+	{0x0c48, 660, 10, 3, 0, 0, 0, 0, Usage::PERCENT, Usage::PERCENT, 65, true},
+	{0x0c50, 670, 10, 3, 0, 0, 0, 0, Usage::PERCENT, Usage::PERCENT, 65, true},
+	{0x0c58, 680, 12, 3, 0, 0, 0, 0, Usage::PERCENT, Usage::PERCENT, 65, true},
+	{0x0c60, 692, 11, 3, 0, 0, 0, 0, Usage::PERCENT, Usage::PERCENT, 65, true},
+	{0x0c68, 703, 10, 3, 0, 0, 0, 0, Usage::PERCENT, Usage::PERCENT, 65, true},
+	{0x0c70, 713, 11, 3, 0, 0, 0, 0, Usage::PERCENT, Usage::PERCENT, 65, true},
+	{0x0e20, 724, 11, 5, 3, 2, 80, 2, Usage::TEMPERATURE, Usage::TEMPERATURE, 74, false},
+	{0x0e40, 735, 8, 5, 3, 2, 92, 2, Usage::PASCAL, Usage::PASCAL, 75, false},
+	{0x0e60, 743, 7, 5, 3, 2, 95, 2, Usage::VOLTAGE, Usage::VOLTAGE, 76, false},
+	{0x0e80, 750, 7, 5, 3, 2, 100, 2, Usage::AMPERE, Usage::AMPERE, 77, false},
+	{0x0ea0, 757, 5, 5, 3, 2, 102, 2, Usage::WATT, Usage::WATT, 78, false},
+	{0x0ec0, 762, 11, 5, 0, 0, 0, 0, Usage::LUX, Usage::LUX, 79, true},
+	{0x0e28, 773, 14, 3, 0, 3, 82, 5, Usage::TEMPERATURE, Usage::TEMPERATURE, 80, true},
+	{0x0e30, 787, 14, 3, 0, 3, 87, 5, Usage::TEMPERATURE, Usage::TEMPERATURE, 81, true},
+	{0x0e29, 773, 14, 0, 0, 0, 0, 0, Usage::TEMPERATURE_FREEZER, Usage::TEMPERATURE_FREEZER, 80, true},
+	{0x0e2a, 773, 14, 0, 0, 0, 0, 0, Usage::TEMPERATURE_FRIDGE, Usage::TEMPERATURE_FRIDGE, 80, true},
+	{0x0e2b, 773, 14, 0, 0, 0, 0, 0, Usage::TEMPERATURE_OUTDOOR, Usage::TEMPERATURE_OUTDOOR, 80, true},
+	{0x0e2c, 773, 14, 0, 0, 0, 0, 0, Usage::TEMPERATURE_ROOM, Usage::TEMPERATURE_ROOM, 80, true},
+	{0x0e2d, 773, 14, 0, 0, 0, 0, 0, Usage::TEMPERATURE_OVEN, Usage::TEMPERATURE_OVEN, 80, true},
+	{0x0e31, 787, 14, 0, 0, 0, 0, 0, Usage::TEMPERATURE_FREEZER, Usage::TEMPERATURE_FREEZER, 81, true},
+	{0x0e32, 787, 14, 0, 0, 0, 0, 0, Usage::TEMPERATURE_FRIDGE, Usage::TEMPERATURE_FRIDGE, 81, true},
+	{0x0e33, 787, 14, 0, 0, 0, 0, 0, Usage::TEMPERATURE_ROOM, Usage::TEMPERATURE_ROOM, 81, true},
+	{0x0e34, 787, 14, 0, 0, 0, 0, 0, Usage::TEMPERATURE_ROOM, Usage::TEMPERATURE_ROOM, 81, true},
+	{0x0e35, 787, 14, 0, 0, 0, 0, 0, Usage::TEMPERATURE_OVEN, Usage::TEMPERATURE_OVEN, 81, true},
+	{0x0e48, 801, 17, 3, 1, 2, 94, 1, Usage::PASCAL, Usage::PASCAL, 92, false},
+	{0x0e50, 818, 17, 3, 0, 0, 0, 0, Usage::PASCAL, Usage::PASCAL, 93, true},
+	{0x0e4a, 801, 17, 1, 0, 0, 0, 0, Usage::PRESSURE_ATMOSPHERIC, Usage::PRESSURE_ATMOSPHERIC, 94, true},
+	{0x0e68, 835, 16, 3, 0, 3, 97, 3, Usage::VOLTAGE, Usage::VOLTAGE, 95, false},
+	{0x0e70, 851, 16, 3, 0, 0, 0, 0, Usage::VOLTAGE, Usage::VOLTAGE, 96, true},
+	{0x0e69, 835, 16, 0, 0, 0, 0, 0, Usage::VOLTAGE_LOW, Usage::VOLTAGE_LOW, 97, true},
+	{0x0e6a, 835, 16, 0, 0, 0, 0, 0, Usage::VOLTAGE_MAINS, Usage::VOLTAGE_MAINS, 98, true},
+	{0x0e6b, 835, 16, 0, 0, 0, 0, 0, Usage::VOLTAGE_HIGH, Usage::VOLTAGE_HIGH, 99, true},
+	{0x0e88, 867, 15, 3, 0, 0, 0, 0, Usage::AMPERE, Usage::AMPERE, 100, true},
+	{0x0e90, 882, 15, 3, 0, 0, 0, 0, Usage::AMPERE, Usage::AMPERE, 101, true},
+	{0x0ea8, 897, 14, 3, 0, 0, 0, 0, Usage::WATT, Usage::WATT, 102, true},
+	{0x0eb0, 911, 14, 3, 0, 0, 0, 0, Usage::WATT, Usage::WATT, 103, true},
+	{0x1010, 925, 8, 4, 2, 2, 108, 2, Usage::PERCENT, Usage::PERCENT, 104, false},
+	{0x1020, 933, 16, 4, 0, 0, 0, 0, Usage::NONE, Usage::NONE, 105, true},
+	{0x1030, 949, 13, 4, 0, 0, 0, 0, Usage::NONE, Usage::NONE, 106, true},
+	{0x1040, 962, 12, 4, 0, 0, 0, 0, Usage::NONE, Usage::NONE, 107, true},
+	{0x1014, 974, 17, 2, 0, 2, 110, 1, Usage::PERCENT, Usage::PERCENT, 108, false},
+	{0x1018, 787, 14, 2, 0, 0, 0, 0, Usage::PERCENT, Usage::PERCENT, 109, true},
+	{0x1015, 974, 17, 0, 0, 0, 0, 0, Usage::PERCENT, Usage::PERCENT, 110, true},
+	{0x1220, 991, 10, 5, 0, 0, 0, 0, Usage::PERCENT, Usage::PERCENT, 111, true},
+	{0x1240, 1001, 11, 5, 0, 0, 0, 0, Usage::TEMPERATURE_COLOR, Usage::TEMPERATURE_COLOR, 112, true},
+	{0x1260, 1012, 15, 5, 2, 3, 114, 4, Usage::UNIT_INTERVAL, Usage::UNIT_INTERVAL, 113, true},
+	{0x1264, 1027, 7, 2, 0, 0, 0, 0, Usage::UNIT_INTERVAL, Usage::UNIT_INTERVAL, 113, true},
+	{0x1268, 1034, 7, 2, 0, 0, 0, 0, Usage::UNIT_INTERVAL, Usage::UNIT_INTERVAL, 113, true},
+	{0x126c, 1041, 3, 2, 0, 0, 0, 0, Usage::UNIT_INTERVAL, Usage::UNIT_INTERVAL, 113, true},
+	{0x1270, 1044, 10, 2, 0, 0, 0, 0, Usage::UNIT_INTERVAL, Usage::UNIT_INTERVAL, 113, true},
+	{0x1420, 1054, 14, 5, 3, 2, 121, 2, Usage::ELECTRIC_METER, Usage::ELECTRIC_METER, 118, false},
+	{0x1440, 1068, 11, 5, 0, 0, 0, 0, Usage::COUNTER, Usage::COUNTER, 119, true},
+	{0x1460, 1079, 9, 5, 0, 0, 0, 0, Usage::COUNTER, Usage::COUNTER, 120, true},
+	{0x1428, 1088, 12, 3, 1, 2, 123, 2, Usage::ELECTRIC_METER, Usage::ELECTRIC_METER, 121, false},
+	{0x1430, 1100, 6, 3, 1, 2, 125, 2, Usage::ELECTRIC_METER, Usage::ELECTRIC_METER, 122, false},
+	{0x142a, 1106, 10, 1, 0, 0, 0, 0, Usage::ELECTRIC_METER, Usage::ELECTRIC_METER, 123, true},
+	{0x142c, 1116, 14, 1, 0, 0, 0, 0, Usage::ELECTRIC_METER, Usage::ELECTRIC_METER, 124, true},
+	{0x1432, 1130, 11, 1, 0, 0, 0, 0, Usage::ELECTRIC_METER, Usage::ELECTRIC_METER, 125, true},
+	{0x1434, 1141, 15, 1, 0, 0, 0, 0, Usage::ELECTRIC_METER, Usage::ELECTRIC_METER, 126, true},
+};
+
+// mask of a type including all categories down to the given bit index
+constexpr int getTypeMask(int bitIndex) {
+	return int(PlugType::TYPE_MASK) & (int(PlugType::TYPE_MASK) << bitIndex);
+}
+
+// find a type or its deepest known parent, returns the invalid type at index 0 if the category is unknown
+static TypeInfo const &findTypeInfo(int type) {
+	auto info = &typeInfos[0];
+	while (info->childCount > 0) {
+		int i = (type >> info->childBitIndex) & ((1 << info->childBitCount) - 1);
+		if (i == 0 || i > info->childCount)
+			break;
+		info = &typeInfos[info->firstChild + i - 1];
 	}
+	return *info;
 }
 
-Usage getUsage(PlugType type) {
-	bool cmd = (type & PlugType::CMD) != 0;
-	auto t = type & PlugType::TYPE_MASK;
+String getTypeLabel(PlugType type) {
+	auto &info = findTypeInfo(int(type & PlugType::TYPE_MASK));
+	return String(info.labelLength, typeLabels + info.labelOffset);
+}
 
-	switch (t & PlugType::CATEGORY) {
-	case PlugType::BINARY:
-		switch (t & PlugType::BINARY_CATEGORY) {
-		case PlugType::BINARY_BUTTON:
-			return Usage::RELEASED_PRESSED;
-		case PlugType::BINARY_OPENING:
-			return cmd ? Usage::CLOSED_OPEN_TOGGLE : Usage::CLOSED_OPEN;
-		case PlugType::BINARY_LOCK:
-			return cmd ? Usage::LOCK_TOGGLE : Usage::LOCK;
-		case PlugType::BINARY_OCCUPANCY:
-			return Usage::OCCUPANCY;
-		case PlugType::BINARY_ALARM:
-			return Usage::ACTIVATION;
-		case PlugType::BINARY_SOUND:
-			return Usage::SOUND;
-		case PlugType::BINARY_ENABLE_CLOSE:
-			return Usage::ENABLED;
-		default:
-			return cmd ? Usage::OFF_ON_TOGGLE : Usage::OFF_ON;
-		}
-	case PlugType::TERNARY:
-		switch (t & PlugType::TERNARY_CATEGORY) {
-		case PlugType::TERNARY_ROCKER:
-			return Usage::RELEASED_UP_DOWN;
-		case PlugType::TERNARY_OPENING:
-			return Usage::STOPPED_OPENING_CLOSING;
-		case PlugType::TERNARY_LOCK:
-			return Usage::TILT_LOCK;
-		default:
-			return Usage::OFF_ON1_ON2;
-		}
-	case PlugType::LEVEL:
-		return Usage::PERCENT;
-	case PlugType::PHYSICAL:
-		switch (t & PlugType::PHYSICAL_CATEGORY) {
-		case PlugType::PHYSICAL_TEMPERATURE:
-			switch (t & PlugType::PHYSICAL_TEMPERATURE_CATEGORY) {
-			case PlugType::PHYSICAL_TEMPERATURE_MEASURED:
-				switch (t & PlugType::PHYSICAL_TEMPERATURE_MEASURED_CATEGORY) {
-				case PlugType::PHYSICAL_TEMPERATURE_MEASURED_FREEZER:
-					return Usage::TEMPERATURE_FREEZER;
-				case PlugType::PHYSICAL_TEMPERATURE_MEASURED_FRIDGE:
-					return Usage::TEMPERATURE_FRIDGE;
-				case PlugType::PHYSICAL_TEMPERATURE_MEASURED_OUTDOOR:
-					return Usage::TEMPERATURE_OUTDOOR;
-				case PlugType::PHYSICAL_TEMPERATURE_MEASURED_ROOM:
-					return Usage::TEMPERATURE_ROOM;
-				case PlugType::PHYSICAL_TEMPERATURE_MEASURED_OVEN:
-					return Usage::TEMPERATURE_OVEN;
-				default:
-					return Usage::TEMPERATURE;
-				}
-			case PlugType::PHYSICAL_TEMPERATURE_SETPOINT:
-				switch (t & PlugType::PHYSICAL_TEMPERATURE_SETPOINT_CATEGORY) {
-				case PlugType::PHYSICAL_TEMPERATURE_SETPOINT_FREEZER:
-					return Usage::TEMPERATURE_FREEZER;
-				case PlugType::PHYSICAL_TEMPERATURE_SETPOINT_FRIDGE:
-					return Usage::TEMPERATURE_FRIDGE;
-				case PlugType::PHYSICAL_TEMPERATURE_SETPOINT_COOLER:
-					return Usage::TEMPERATURE_ROOM;
-				case PlugType::PHYSICAL_TEMPERATURE_SETPOINT_HEATER:
-					return Usage::TEMPERATURE_ROOM;
-				case PlugType::PHYSICAL_TEMPERATURE_SETPOINT_OVEN:
-					return Usage::TEMPERATURE_OVEN;
-				default:
-					return Usage::TEMPERATURE;
-				}
-			default:
-				return Usage::TEMPERATURE;
-			}
-		case PlugType::PHYSICAL_PRESSURE:
-			switch (t & PlugType::PHYSICAL_PRESSURE_CATEGORY) {
-			case PlugType::PHYSICAL_PRESSURE_MEASURED:
-				switch (t & PlugType::PHYSICAL_PRESSURE_MEASURED_CATEGORY) {
-				case PlugType::PHYSICAL_PRESSURE_MEASURED_ATMOSPHERE:
-					return Usage::PRESSURE_ATMOSPHERIC;
-				default:
-					return Usage::PASCAL;
-				}
-			default:
-				return Usage::PASCAL;
-			}
-		case PlugType::PHYSICAL_VOLTAGE:
-			switch (t & PlugType::PHYSICAL_VOLTAGE_CATEGORY) {
-			case PlugType::PHYSICAL_VOLTAGE_MEASURED:
-				switch (t & PlugType::PHYSICAL_VOLTAGE_MEASURED_CATEGORY) {
-				case PlugType::PHYSICAL_VOLTAGE_MEASURED_LOW:
-					return Usage::VOLTAGE_LOW;
-				case PlugType::PHYSICAL_VOLTAGE_MEASURED_MAINS:
-					return Usage::VOLTAGE_MAINS;
-				case PlugType::PHYSICAL_VOLTAGE_MEASURED_HIGH:
-					return Usage::VOLTAGE_HIGH;
-				default:
-					return Usage::VOLTAGE;
-				}
-			default:
-				return Usage::VOLTAGE;
-			}
-		case PlugType::PHYSICAL_CURRENT:
-			return Usage::AMPERE;
-		case PlugType::PHYSICAL_POWER:
-			return Usage::WATT;
-		case PlugType::PHYSICAL_ILLUMINANCE:
-			return Usage::LUX;
-		default:
-			return Usage::NONE;
-		}
-	case PlugType::CONCENTRATION:
-		switch (t & PlugType::CONCENTRATION_CATEGORY) {
-		case PlugType::CONCENTRATION_RELATIVE_HUMIDITY:
-			return Usage::PERCENT;
-		default:
-			return Usage::NONE;
-		}
-	case PlugType::LIGHTING:
-		switch (t & PlugType::LIGHTING_CATEGORY) {
-		case PlugType::LIGHTING_BRIGHTNESS:
-			return Usage::PERCENT;
-		case PlugType::LIGHTING_COLOR_TEMPERATURE:
-			return Usage::TEMPERATURE_COLOR;
-		case PlugType::LIGHTING_COLOR_PARAMETER:
-			return Usage::UNIT_INTERVAL;
-		default:
-			return Usage::NONE;
-		}
-	case PlugType::METERING:
-		switch (t & PlugType::METERING_CATEGORY) {
-		case PlugType::METERING_ELECTRIC:
-			return Usage::ELECTRIC_METER;
-		default:
-			return Usage::COUNTER;
-		}
-	default:
-		return Usage::NONE;
-	}
+Usage getUsage(PlugType type) {
+	auto &info = findTypeInfo(int(type & PlugType::TYPE_MASK));
+	return (type & PlugType::CMD) != 0 ? info.commandUsage : info.usage;
 }
 
 bool isCompatible(PlugType dstType, PlugType srcType) {
@@ -528,187 +213,13 @@ bool isCompatible(PlugType dstType, PlugType srcType) {
 	if (srcCommand && !dstCommand)
 		return false;
 
-	if ((src & PlugType::CATEGORY) == dst) return true;
-	switch (dst & PlugType::CATEGORY) {
-	case PlugType::BINARY:
-		return (src & PlugType::CATEGORY) == PlugType::BINARY;
-	case PlugType::TERNARY:
-		return (src & PlugType::CATEGORY) == PlugType::TERNARY;
-	case PlugType::MULTISTATE:
-		if ((src & PlugType::MULTISTATE_CATEGORY) == dst) return true;
-		switch (dst & PlugType::MULTISTATE_CATEGORY) {
-		case PlugType::MULTISTATE_THERMOSTAT_MODE:
-			return (src & PlugType::MULTISTATE_CATEGORY) == PlugType::MULTISTATE_THERMOSTAT_MODE;
-		default:
-			return false;
-		}
-	case PlugType::ENCODER:
-		return (src & PlugType::CATEGORY) == PlugType::ENCODER;
-	case PlugType::ENUM:
-		return (src & PlugType::CATEGORY) == PlugType::ENUM;
-	case PlugType::LEVEL:
-		if ((src & PlugType::LEVEL_CATEGORY) == dst) return true;
-		switch (dst & PlugType::LEVEL_CATEGORY) {
-		case PlugType::LEVEL_OPENING:
-			return (src & PlugType::LEVEL_CATEGORY) == PlugType::LEVEL_OPENING;
-		case PlugType::LEVEL_BATTERY:
-			return (src & PlugType::LEVEL_CATEGORY) == PlugType::LEVEL_BATTERY;
-		case PlugType::LEVEL_TANK:
-			return (src & PlugType::LEVEL_CATEGORY) == PlugType::LEVEL_TANK;
-		default:
-			return false;
-		}
-	case PlugType::PHYSICAL:
-		if ((src & PlugType::PHYSICAL_CATEGORY) == dst) return true;
-		switch (dst & PlugType::PHYSICAL_CATEGORY) {
-		case PlugType::PHYSICAL_TEMPERATURE:
-			if ((src & PlugType::PHYSICAL_TEMPERATURE_CATEGORY) == dst) return true;
-			switch (dst & PlugType::PHYSICAL_TEMPERATURE_CATEGORY) {
-			case PlugType::PHYSICAL_TEMPERATURE_MEASURED:
-				return (src & PlugType::PHYSICAL_TEMPERATURE_CATEGORY) == PlugType::PHYSICAL_TEMPERATURE_MEASURED;
-			case PlugType::PHYSICAL_TEMPERATURE_SETPOINT:
-				return (src & PlugType::PHYSICAL_TEMPERATURE_CATEGORY) == PlugType::PHYSICAL_TEMPERATURE_SETPOINT;
-			default:
-				return false;
-			}
-		case PlugType::PHYSICAL_PRESSURE:
-			if ((src & PlugType::PHYSICAL_PRESSURE_CATEGORY) == dst) return true;
-			switch (dst & PlugType::PHYSICAL_PRESSURE_CATEGORY) {
-			case PlugType::PHYSICAL_PRESSURE_MEASURED:
-				if ((src & PlugType::PHYSICAL_PRESSURE_MEASURED_CATEGORY) == dst) return true;
-				switch (dst & PlugType::PHYSICAL_PRESSURE_MEASURED_CATEGORY) {
-				case PlugType::PHYSICAL_PRESSURE_MEASURED_ATMOSPHERE:
-					return (src & PlugType::PHYSICAL_PRESSURE_MEASURED_CATEGORY) == PlugType::PHYSICAL_PRESSURE_MEASURED_ATMOSPHERE;
-				default:
-					return false;
-				}
-			case PlugType::PHYSICAL_PRESSURE_SETPOINT:
-				return (src & PlugType::PHYSICAL_PRESSURE_CATEGORY) == PlugType::PHYSICAL_PRESSURE_SETPOINT;
-			default:
-				return false;
-			}
-		case PlugType::PHYSICAL_VOLTAGE:
-			if ((src & PlugType::PHYSICAL_VOLTAGE_CATEGORY) == dst) return true;
-			switch (dst & PlugType::PHYSICAL_VOLTAGE_CATEGORY) {
-			case PlugType::PHYSICAL_VOLTAGE_MEASURED:
-				if ((src & PlugType::PHYSICAL_VOLTAGE_MEASURED_CATEGORY) == dst) return true;
-				switch (dst & PlugType::PHYSICAL_VOLTAGE_MEASURED_CATEGORY) {
-				case PlugType::PHYSICAL_VOLTAGE_MEASURED_LOW:
-					return (src & PlugType::PHYSICAL_VOLTAGE_MEASURED_CATEGORY) == PlugType::PHYSICAL_VOLTAGE_MEASURED_LOW;
-				case PlugType::PHYSICAL_VOLTAGE_MEASURED_MAINS:
-					return (src & PlugType::PHYSICAL_VOLTAGE_MEASURED_CATEGORY) == PlugType::PHYSICAL_VOLTAGE_MEASURED_MAINS;
-				case PlugType::PHYSICAL_VOLTAGE_MEASURED_HIGH:
-					return (src & PlugType::PHYSICAL_VOLTAGE_MEASURED_CATEGORY) == PlugType::PHYSICAL_VOLTAGE_MEASURED_HIGH;
-				default:
-					return false;
-				}
-			case PlugType::PHYSICAL_VOLTAGE_SETPOINT:
-				return (src & PlugType::PHYSICAL_VOLTAGE_CATEGORY) == PlugType::PHYSICAL_VOLTAGE_SETPOINT;
-			default:
-				return false;
-			}
-		case PlugType::PHYSICAL_CURRENT:
-			if ((src & PlugType::PHYSICAL_CURRENT_CATEGORY) == dst) return true;
-			switch (dst & PlugType::PHYSICAL_CURRENT_CATEGORY) {
-			case PlugType::PHYSICAL_CURRENT_MEASURED:
-				return (src & PlugType::PHYSICAL_CURRENT_CATEGORY) == PlugType::PHYSICAL_CURRENT_MEASURED;
-			case PlugType::PHYSICAL_CURRENT_SETPOINT:
-				return (src & PlugType::PHYSICAL_CURRENT_CATEGORY) == PlugType::PHYSICAL_CURRENT_SETPOINT;
-			default:
-				return false;
-			}
-		case PlugType::PHYSICAL_POWER:
-			if ((src & PlugType::PHYSICAL_POWER_CATEGORY) == dst) return true;
-			switch (dst & PlugType::PHYSICAL_POWER_CATEGORY) {
-			case PlugType::PHYSICAL_POWER_MEASURED:
-				return (src & PlugType::PHYSICAL_POWER_CATEGORY) == PlugType::PHYSICAL_POWER_MEASURED;
-			case PlugType::PHYSICAL_POWER_SETPOINT:
-				return (src & PlugType::PHYSICAL_POWER_CATEGORY) == PlugType::PHYSICAL_POWER_SETPOINT;
-			default:
-				return false;
-			}
-		case PlugType::PHYSICAL_ILLUMINANCE:
-			return (src & PlugType::PHYSICAL_CATEGORY) == PlugType::PHYSICAL_ILLUMINANCE;
-		default:
-			return false;
-		}
-	case PlugType::CONCENTRATION:
-		if ((src & PlugType::CONCENTRATION_CATEGORY) == dst) return true;
-		switch (dst & PlugType::CONCENTRATION_CATEGORY) {
-		case PlugType::CONCENTRATION_RELATIVE_HUMIDITY:
-			if ((src & PlugType::CONCENTRATION_RELATIVE_HUMIDITY_CATEGORY) == dst) return true;
-			switch (dst & PlugType::CONCENTRATION_RELATIVE_HUMIDITY_CATEGORY) {
-			case PlugType::CONCENTRATION_RELATIVE_HUMIDITY_MEASURED:
-				if ((src & PlugType::CONCENTRATION_RELATIVE_HUMIDITY_MEASURED_CATEGORY) == dst) return true;
-				switch (dst & PlugType::CONCENTRATION_RELATIVE_HUMIDITY_MEASURED_CATEGORY) {
-				case PlugType::CONCENTRATION_RELATIVE_HUMIDITY_MEASURED_AIR:
-					return (src & PlugType::CONCENTRATION_RELATIVE_HUMIDITY_MEASURED_CATEGORY) == PlugType::CONCENTRATION_RELATIVE_HUMIDITY_MEASURED_AIR;
-				default:
-					return false;
-				}
-			case PlugType::CONCENTRATION_RELATIVE_HUMIDITY_SETPOINT:
-				return (src & PlugType::CONCENTRATION_RELATIVE_HUMIDITY_CATEGORY) == PlugType::CONCENTRATION_RELATIVE_HUMIDITY_SETPOINT;
-			default:
-				return false;
-			}
-		case PlugType::CONCENTRATION_VOC:
-			return (src & PlugType::CONCENTRATION_CATEGORY) == PlugType::CONCENTRATION_VOC;
-		case PlugType::CONCENTRATION_CARBON_MONOXIDE:
-			return (src & PlugType::CONCENTRATION_CATEGORY) == PlugType::CONCENTRATION_CARBON_MONOXIDE;
-		case PlugType::CONCENTRATION_CARBON_DIOXIDE:
-			return (src & PlugType::CONCENTRATION_CATEGORY) == PlugType::CONCENTRATION_CARBON_DIOXIDE;
-		default:
-			return false;
-		}
-	case PlugType::LIGHTING:
-		if ((src & PlugType::LIGHTING_CATEGORY) == dst) return true;
-		switch (dst & PlugType::LIGHTING_CATEGORY) {
-		case PlugType::LIGHTING_BRIGHTNESS:
-			return (src & PlugType::LIGHTING_CATEGORY) == PlugType::LIGHTING_BRIGHTNESS;
-		case PlugType::LIGHTING_COLOR_TEMPERATURE:
-			return (src & PlugType::LIGHTING_CATEGORY) == PlugType::LIGHTING_COLOR_TEMPERATURE;
-		case PlugType::LIGHTING_COLOR_PARAMETER:
-			return (src & PlugType::LIGHTING_CATEGORY) == PlugType::LIGHTING_COLOR_PARAMETER;
-		default:
-			return false;
-		}
-	case PlugType::METERING:
-		if ((src & PlugType::METERING_CATEGORY) == dst) return true;
-		switch (dst & PlugType::METERING_CATEGORY) {
-		case PlugType::METERING_ELECTRIC:
-			if ((src & PlugType::METERING_ELECTRIC_CATEGORY) == dst) return true;
-			switch (dst & PlugType::METERING_ELECTRIC_CATEGORY) {
-			case PlugType::METERING_ELECTRIC_USAGE:
-				if ((src & PlugType::METERING_ELECTRIC_USAGE_CATEGORY) == dst) return true;
-				switch (dst & PlugType::METERING_ELECTRIC_USAGE_CATEGORY) {
-				case PlugType::METERING_ELECTRIC_USAGE_PEAK:
-					return (src & PlugType::METERING_ELECTRIC_USAGE_CATEGORY) == PlugType::METERING_ELECTRIC_USAGE_PEAK;
-				case PlugType::METERING_ELECTRIC_USAGE_OFF_PEAK:
-					return (src & PlugType::METERING_ELECTRIC_USAGE_CATEGORY) == PlugType::METERING_ELECTRIC_USAGE_OFF_PEAK;
-				default:
-					return false;
-				}
-			case PlugType::METERING_ELECTRIC_SUPPLY:
-				if ((src & PlugType::METERING_ELECTRIC_SUPPLY_CATEGORY) == dst) return true;
-				switch (dst & PlugType::METERING_ELECTRIC_SUPPLY_CATEGORY) {
-				case PlugType::METERING_ELECTRIC_SUPPLY_PEAK:
-					return (src & PlugType::METERING_ELECTRIC_SUPPLY_CATEGORY) == PlugType::METERING_ELECTRIC_SUPPLY_PEAK;
-				case PlugType::METERING_ELECTRIC_SUPPLY_OFF_PEAK:
-					return (src & PlugType::METERING_ELECTRIC_SUPPLY_CATEGORY) == PlugType::METERING_ELECTRIC_SUPPLY_OFF_PEAK;
-				default:
-					return false;
-				}
-			default:
-				return false;
-			}
-		case PlugType::METERING_WATER:
-			return (src & PlugType::METERING_CATEGORY) == PlugType::METERING_WATER;
-		case PlugType::METERING_GAS:
-			return (src & PlugType::METERING_CATEGORY) == PlugType::METERING_GAS;
-		default:
-			return false;
-		}
-	default:
-		return false;
+	auto &info = findTypeInfo(int(dst));
+	if (info.hasRoot || info.type == int(dst)) {
+		// source must be the compatibility root (or the destination itself) or one of its sub-types
+		auto &root = typeInfos[info.root];
+		return (int(src) & getTypeMask(root.bitIndex)) == root.type;
 	}
+
+	// unknown destination type: source must be equal to the destination down to the category of the sub-types
+	return (int(src) & getTypeMask(info.childBitIndex)) == int(dst);
 }
@@ -0,0 +1,73 @@
+#include "Message.hpp"
+#include "Subscriber.hpp"
+#include <bus.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+
+
+// destination of a connection that counts the received messages
+struct Receiver {
+	SubscriberBarrier barrier;
+	int count = 0;
+};
+
+static Coroutine receive(Receiver &receiver) {
+	while (true) {
+		SubscriberInfo info;
+		Message message;
+		co_await receiver.barrier.wait(info, &message);
+		++receiver.count;
+	}
+}
+
+// benchmark publishing through the per-plug dispatch table against walking all subscribers of the list
+TEST(nodeBenchmark, subscriberRouting) {
+	constexpr int PLUG_COUNT = 8;
+	constexpr int CONNECTION_COUNT = 64; // per plug
+	constexpr int COUNT = 10000;
+
+	Connection connections[PLUG_COUNT * CONNECTION_COUNT] = {};
+	Receiver receivers[PLUG_COUNT * CONNECTION_COUNT];
+	SubscriberList subscribers;
+	Subscriber subscriberArray[PLUG_COUNT * CONNECTION_COUNT];
+
+	// interleave the plugs as the connections of different destinations are in the list
+	for (int i = 0; i < PLUG_COUNT * CONNECTION_COUNT; ++i) {
+		auto &connection = connections[i];
+		connection.source.plugIndex = i % PLUG_COUNT;
+		connection.convertOptions.commands = 0 | (1 << 3) | (2 << 6);
+		auto &subscriber = subscriberArray[i];
+		subscriber.data = &connection;
+		subscriber.target = {bus::PlugType::BINARY_POWER_LIGHT_IN, &receivers[i].barrier};
+		subscriber.converter.init(subscriber.target.type, connection.convertOptions);
+		subscribers.add(subscriber);
+		receive(receivers[i]);
+	}
+
+	// dispatch table
+	auto start1 = std::chrono::steady_clock::now();
+	for (int i = 0; i < COUNT; ++i)
+		subscribers.publishSwitch(i % PLUG_COUNT, i & 1);
+	auto table = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start1).count();
+
+	// reference: walk all subscribers and compare the plug index
+	auto start2 = std::chrono::steady_clock::now();
+	for (int i = 0; i < COUNT; ++i) {
+		uint8_t plugIndex = i % PLUG_COUNT;
+		uint8_t value = i & 1;
+		for (auto &subscriber : subscribers) {
+			if (subscriber.data->source.plugIndex == plugIndex) {
+				subscriber.target.barrier->resumeFirst([&subscriber, value](SubscriberParameters &p) {
+					auto &dst = *reinterpret_cast<Message *>(p.message);
+					return convertSwitch(subscriber.target.type, dst, value, subscriber.data->convertOptions);
+				});
+			}
+		}
+	}
+	auto list = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start2).count();
+
+	std::cout << "publish to " << CONNECTION_COUNT << " of " << PLUG_COUNT * CONNECTION_COUNT
+		<< " subscribers: dispatch table " << table / COUNT << "ns, list " << list / COUNT << "ns" << std::endl;
+	EXPECT_EQ(receivers[0].count, COUNT * 2 / PLUG_COUNT);
+}
@@ -1,4 +1,6 @@
+#include "FlightRecorder.hpp"
 #include "Message.hpp"
+#include "Subscriber.hpp"
 #include <bus.hpp>
 #include <gtest/gtest.h>
 
@@ -55,3 +57,294 @@ TEST(nodeTest, isCompatible) {
 	// switch <- float command
 	EXPECT_FALSE(isCompatible(bus::PlugType::BINARY_POWER_LIGHT_IN, bus::PlugType::PHYSICAL_TEMPERATURE_SETPOINT_CMD_OUT));
 }
+
+TEST(nodeTest, converter) {
+	ConvertOptions convertOptions = {};
+	convertOptions.commands = 1 | (0 << 3) | (7 << 6); // 0 -> 1, 1 -> 0, 2 -> discard
+	convertOptions.transition = 20;
+	convertOptions.value.f[0] = 10.0f;
+	convertOptions.value.f[1] = 5.0f;
+	Message dst = {};
+
+	// switch -> switch
+	Converter converter;
+	converter.init(bus::PlugType::BINARY_POWER_LIGHT_IN, convertOptions);
+	EXPECT_TRUE(converter.convertSwitch(dst, 0));
+	EXPECT_EQ(dst.value.u8, 1);
+	EXPECT_FALSE(converter.convertSwitch(dst, 2));
+	EXPECT_FALSE(converter.convertSwitch(dst, 3));
+
+	// float -> switch, compare against thresholds
+	EXPECT_TRUE(converter.convertFloat(dst, 11.0f));
+	EXPECT_EQ(dst.value.u8, 1);
+	EXPECT_TRUE(converter.convertFloat(dst, 4.0f));
+	EXPECT_EQ(dst.value.u8, 0);
+	EXPECT_FALSE(converter.convertFloat(dst, 7.0f));
+	EXPECT_FALSE(converter.convertInt8(dst, 1));
+
+	// switch -> lighting command with transition
+	converter.init(bus::PlugType::LIGHTING_BRIGHTNESS_CMD_IN, convertOptions);
+	EXPECT_TRUE(converter.convertSwitch(dst, 1));
+	EXPECT_EQ(dst.value.f32, 5.0f);
+	EXPECT_EQ(dst.command, 0);
+	EXPECT_EQ(dst.transition, 20);
+	EXPECT_TRUE(converter.convertInt8(dst, -2));
+	EXPECT_EQ(dst.value.f32, -20.0f);
+	EXPECT_EQ(dst.command, 1);
+	EXPECT_TRUE(converter.convertFloatTransition(dst, 0.5f, 0, 7));
+	EXPECT_EQ(dst.transition, 7);
+
+	// value without command: no step or transition
+	converter.init(bus::PlugType::LIGHTING_BRIGHTNESS_IN, convertOptions);
+	EXPECT_TRUE(converter.convertFloat(dst, 0.5f));
+	EXPECT_FALSE(converter.convertInt8(dst, 1));
+	EXPECT_FALSE(converter.convertFloatCommand(dst, 0.5f, 1));
+
+	// the functions without prepared converter give the same results
+	EXPECT_TRUE(convertFloatCommand(bus::PlugType::LIGHTING_BRIGHTNESS_CMD_IN, dst, 0.25f, 1, convertOptions));
+	EXPECT_EQ(dst.command, 1);
+	EXPECT_FALSE(convertFloatCommand(bus::PlugType::LIGHTING_BRIGHTNESS_IN, dst, 0.25f, 1, convertOptions));
+}
+
+// destination of a connection that counts the received messages
+struct Receiver {
+	SubscriberBarrier barrier;
+	int count = 0;
+	uint8_t value = 0;
+};
+
+Coroutine receive(Receiver &receiver) {
+	while (true) {
+		SubscriberInfo info;
+		Message message;
+		co_await receiver.barrier.wait(info, &message);
+		++receiver.count;
+		receiver.value = message.value.u8;
+	}
+}
+
+// end-to-end routing from a multi-plug source (e.g. 4-button rocker) to coroutines waiting on the destinations
+TEST(nodeTest, subscriberRouting) {
+	constexpr int PLUG_COUNT = 8;
+	constexpr int CONNECTION_COUNT = 64; // per plug
+	constexpr int COUNT = 1000;
+
+	Connection connections[PLUG_COUNT * CONNECTION_COUNT] = {};
+	Receiver receivers[PLUG_COUNT * CONNECTION_COUNT];
+	SubscriberList subscribers;
+	{
+		Subscriber subscriberArray[PLUG_COUNT * CONNECTION_COUNT];
+
+		// interleave the plugs as the connections of different destinations are in the list
+		for (int i = 0; i < PLUG_COUNT * CONNECTION_COUNT; ++i) {
+			auto &connection = connections[i];
+			connection.source.plugIndex = i % PLUG_COUNT;
+			connection.convertOptions.commands = 0 | (1 << 3) | (2 << 6);
+			auto &subscriber = subscriberArray[i];
+			subscriber.data = &connection;
+			subscriber.target = {bus::PlugType::BINARY_POWER_LIGHT_IN, &receivers[i].barrier};
+			subscriber.converter.init(subscriber.target.type, connection.convertOptions);
+			subscribers.add(subscriber);
+			receive(receivers[i]);
+		}
+
+		// only the subscribers of the plug get the message
+		subscribers.publishSwitch(3, 1);
+		for (int i = 0; i < PLUG_COUNT * CONNECTION_COUNT; ++i) {
+			EXPECT_EQ(receivers[i].count, i % PLUG_COUNT == 3 ? 1 : 0);
+			EXPECT_EQ(receivers[i].value, i % PLUG_COUNT == 3 ? 1 : 0);
+		}
+
+		// publish to all plugs in turn
+		for (int i = 0; i < COUNT; ++i)
+			subscribers.publishSwitch(i % PLUG_COUNT, i & 1);
+		for (int i = 0; i < PLUG_COUNT * CONNECTION_COUNT; ++i)
+			EXPECT_EQ(receivers[i].count, (i % PLUG_COUNT == 3 ? 1 : 0) + COUNT / PLUG_COUNT);
+	}
+
+	// subscribers have unsubscribed themselves, table gets rebuilt
+	subscribers.publishSwitch(3, 1);
+	EXPECT_EQ(receivers[3].count, 1 + COUNT / PLUG_COUNT);
+}
+
+// destination that changes the subscriptions when it receives a message
+struct ChangingReceiver {
+	SubscriberBarrier barrier;
+	SubscriberList *subscribers;
+	Subscriber *remove;
+	Subscriber *add;
+};
+
+Coroutine receive(ChangingReceiver &receiver) {
+	SubscriberInfo info;
+	Message message;
+	co_await receiver.barrier.wait(info, &message);
+	receiver.remove->remove();
+	receiver.subscribers->add(*receiver.add);
+}
+
+// a resumed coroutine changes the subscriptions while a message gets published
+TEST(nodeTest, subscriberChange) {
+	constexpr int COUNT = 5;
+	Connection connection = {};
+	Receiver receivers[COUNT];
+	ChangingReceiver changingReceiver;
+	Subscriber subscribers[COUNT];
+	SubscriberList list;
+
+	// subscriber 1 removes subscriber 3 and adds subscriber 4, all subscribe to the same plug
+	for (int i = 0; i < COUNT; ++i) {
+		auto &subscriber = subscribers[i];
+		auto &barrier = i == 1 ? changingReceiver.barrier : receivers[i].barrier;
+		subscriber.data = &connection;
+		subscriber.target = {bus::PlugType::BINARY_POWER_LIGHT_IN, &barrier};
+		subscriber.converter.init(subscriber.target.type, connection.convertOptions);
+		if (i < COUNT - 1)
+			list.add(subscriber);
+		if (i != 1)
+			receive(receivers[i]);
+	}
+	changingReceiver.subscribers = &list;
+	changingReceiver.remove = &subscribers[3];
+	changingReceiver.add = &subscribers[4];
+	receive(changingReceiver);
+
+	// the subscribers after the change still get the message, subscriber 0 gets it only once
+	list.publishSwitch(0, 1);
+	EXPECT_EQ(receivers[0].count, 1);
+	EXPECT_EQ(receivers[2].count, 1);
+	EXPECT_EQ(receivers[3].count, 0);
+	EXPECT_EQ(receivers[4].count, 1);
+
+	// the next message goes to the changed subscriptions
+	list.publishSwitch(0, 0);
+	EXPECT_EQ(receivers[0].count, 2);
+	EXPECT_EQ(receivers[2].count, 2);
+	EXPECT_EQ(receivers[3].count, 0);
+	EXPECT_EQ(receivers[4].count, 2);
+}
+
+// destination that replaces a subscriber by a new one at the same address when it receives a message
+struct ReplacingReceiver {
+	SubscriberBarrier barrier;
+	SubscriberList *subscribers;
+	Subscriber *replace;
+	Connection const *data;
+	SubscriberBarrier *target;
+};
+
+Coroutine receive(ReplacingReceiver &receiver) {
+	SubscriberInfo info;
+	Message message;
+	co_await receiver.barrier.wait(info, &message);
+	auto subscriber = receiver.replace;
+	subscriber->~Subscriber();
+	new (subscriber) Subscriber();
+	subscriber->data = receiver.data;
+	subscriber->target = {bus::PlugType::BINARY_POWER_LIGHT_IN, receiver.target};
+	subscriber->converter.init(subscriber->target.type, receiver.data->convertOptions);
+	receiver.subscribers->add(*subscriber);
+}
+
+// a resumed coroutine destroys a subscriber that was already resumed and creates a new one at the same address
+TEST(nodeTest, subscriberReplace) {
+	Connection connection = {};
+	Receiver receivers[3];
+	ReplacingReceiver replacingReceiver;
+	Subscriber subscribers[2];
+	SubscriberList list;
+
+	// subscriber 0 to receiver 0, subscriber 1 to the replacing receiver
+	for (int i = 0; i < 2; ++i) {
+		auto &subscriber = subscribers[i];
+		subscriber.data = &connection;
+		subscriber.target = {bus::PlugType::BINARY_POWER_LIGHT_IN, i == 0 ? &receivers[0].barrier
+			: &replacingReceiver.barrier};
+		subscriber.converter.init(subscriber.target.type, connection.convertOptions);
+		list.add(subscriber);
+	}
+	receive(receivers[0]);
+	receive(receivers[2]);
+	replacingReceiver.subscribers = &list;
+	replacingReceiver.replace = &subscribers[0];
+	replacingReceiver.data = &connection;
+	replacingReceiver.target = &receivers[2].barrier;
+	receive(replacingReceiver);
+
+	// the new subscriber is not mistaken for the resumed one and gets the message
+	list.publishSwitch(0, 1);
+	EXPECT_EQ(receivers[0].count, 1);
+	EXPECT_EQ(receivers[2].count, 1);
+}
+
+// a stream that collects the text written to it
+struct TextStream : public Stream {
+	std::string text;
+
+	Stream &operator <<(char ch) override {this->text += ch; return *this;}
+	Stream &operator <<(String const &str) override {this->text.append(str.data, str.length); return *this;}
+	Stream &operator <<(Command command) override {return *this;}
+};
+
+TEST(nodeTest, flightRecorder) {
+	uint32_t time = 0;
+	static uint32_t *currentTime = &time;
+	FlightRecorder::clock = []() {return *currentTime;};
+	FlightRecorder::clear();
+
+	Connection connection = {};
+	connection.source = {1, 2, 3};
+	connection.destination.plugIndex = 4;
+	Receiver receiver;
+	SubscriberList subscribers;
+	Subscriber subscriber;
+	subscriber.data = &connection;
+	subscriber.interfaceId = 5;
+	subscriber.elementId = 6;
+	subscriber.connectionIndex = 7;
+	subscriber.target = {bus::PlugType::BINARY_POWER_LIGHT_IN, &receiver.barrier};
+	subscriber.converter.init(subscriber.target.type, connection.convertOptions);
+	subscribers.add(subscriber);
+	receive(receiver);
+
+	// deliveries are recorded, the oldest records get overwritten when the ring buffer is full
+	for (int i = 0; i < FlightRecorder::CAPACITY + 10; ++i) {
+		time = i;
+		subscribers.publishSwitch(3, i & 1);
+	}
+	EXPECT_EQ(FlightRecorder::getCount(), FlightRecorder::CAPACITY);
+	auto &record = FlightRecorder::get(0);
+	EXPECT_EQ(record.time, 10);
+	EXPECT_EQ(record.message.value.u8, 0);
+	EXPECT_EQ(record.source.interfaceId, 1);
+	EXPECT_EQ(record.source.elementId, 2);
+	EXPECT_EQ(record.source.plugIndex, 3);
+	EXPECT_EQ(record.interfaceId, 5);
+	EXPECT_EQ(record.elementId, 6);
+	EXPECT_EQ(record.plugIndex, 4);
+	EXPECT_EQ(record.connectionIndex, 7);
+	EXPECT_EQ(FlightRecorder::get(FlightRecorder::CAPACITY - 1).time, FlightRecorder::CAPACITY + 9);
+
+	// messages on other plugs are not delivered and not recorded
+	subscribers.publishSwitch(2, 1);
+	EXPECT_EQ(FlightRecorder::get(FlightRecorder::CAPACITY - 1).time, FlightRecorder::CAPACITY + 9);
+
+	// dump as text and parse again
+	TextStream stream;
+	FlightRecorder::dump(stream);
+	int count = 0;
+	size_t start = 0;
+	while (start < stream.text.size()) {
+		size_t end = stream.text.find('\n', start);
+		FlightRecorder::Record parsed;
+		EXPECT_TRUE(FlightRecorder::parse(String(int(end - start), stream.text.data() + start), parsed));
+		EXPECT_EQ(memcmp(&parsed, &FlightRecorder::get(count), sizeof(parsed)), 0);
+		++count;
+		start = end + 1;
+	}
+	EXPECT_EQ(count, FlightRecorder::CAPACITY);
+
+	FlightRecorder::clock = nullptr;
+	FlightRecorder::clear();
+	EXPECT_EQ(FlightRecorder::getCount(), 0);
+}
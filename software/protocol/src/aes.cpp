@@ -0,0 +1,67 @@
+#include "crypt.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+#include <arm_neon.h>
+#endif
+
+
+// AES backends: hardware instructions if available, otherwise tinycrypt. All backends use the key schedule of
+// tinycrypt which stores the 11 round keys as big endian 32 bit words
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// AES-NI, selected at runtime because the binary may run on a processor without AES instructions
+__attribute__((target("aes,ssse3")))
+static void encryptAesNi(uint8_t *out, uint8_t const *in, AesKey const &aesKey) {
+	// shuffle to convert the big endian words of the round keys to bytes
+	__m128i const swap = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+	auto roundKeys = reinterpret_cast<__m128i const *>(aesKey.words);
+
+	__m128i state = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in));
+	state = _mm_xor_si128(state, _mm_shuffle_epi8(_mm_loadu_si128(roundKeys), swap));
+	for (int i = 1; i < Nr; ++i)
+		state = _mm_aesenc_si128(state, _mm_shuffle_epi8(_mm_loadu_si128(roundKeys + i), swap));
+	state = _mm_aesenclast_si128(state, _mm_shuffle_epi8(_mm_loadu_si128(roundKeys + Nr), swap));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(out), state);
+}
+
+using AesFunction = void (*)(uint8_t *, uint8_t const *, AesKey const &);
+
+static AesFunction selectAesFunction() {
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("aes"))
+		return encryptAesNi;
+	return [](uint8_t *out, uint8_t const *in, AesKey const &aesKey) {tc_aes_encrypt(out, in, &aesKey);};
+}
+
+void aesEncrypt(uint8_t *out, uint8_t const *in, AesKey const &aesKey) {
+	static AesFunction const function = selectAesFunction();
+	function(out, in, aesKey);
+}
+
+#elif defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+
+// ARMv8 cryptography extension, available when enabled at compile time (e.g. -march=armv8-a+crypto)
+static uint8x16_t loadRoundKey(AesKey const &aesKey, int i) {
+	// convert the big endian words of the round key to bytes
+	return vrev32q_u8(vreinterpretq_u8_u32(vld1q_u32(reinterpret_cast<uint32_t const *>(aesKey.words) + i * Nb)));
+}
+
+void aesEncrypt(uint8_t *out, uint8_t const *in, AesKey const &aesKey) {
+	uint8x16_t state = vld1q_u8(in);
+	for (int i = 0; i < Nr - 1; ++i)
+		state = vaesmcq_u8(vaeseq_u8(state, loadRoundKey(aesKey, i)));
+	state = vaeseq_u8(state, loadRoundKey(aesKey, Nr - 1));
+	state = veorq_u8(state, loadRoundKey(aesKey, Nr));
+	vst1q_u8(out, state);
+}
+
+#else
+
+void aesEncrypt(uint8_t *out, uint8_t const *in, AesKey const &aesKey) {
+	tc_aes_encrypt(out, in, &aesKey);
+}
+
+#endif
@@ -1,179 +1,169 @@
 #include "crypt.hpp"
-#include "DataBuffer.hpp"
 #include <util.hpp>
 
 
 constexpr int L = 2; // size of message length field
-
-static void crypt(uint8_t *p, uint8_t *u, uint8_t const *c, int payloadLength, uint8_t const *t, int micLength,
-	Array<uint8_t const, 13> nonce, AesKey const &aesKey)
-{
-	// C.4.1 Decryption Transformation
-	uint8_t const flags = L - 1;
-
-	// AES in counter mode, see https://de.wikipedia.org/wiki/Counter_Mode
-	DataBuffer<16> Ai;
-	Ai.setU8(0, flags);
-	Ai.setData(1, nonce);
-
-	DataBuffer<16> Si;
-	int i = 1;
-	int length = payloadLength;
-
-	while (length > 0) {
-		// set CTR-counter for Ai (starts with A1)
-		Ai.setU16B(14, i++);
-
-		// Si = E(Key, Ai)
-		encrypt(Si, Ai, aesKey);
-
-		// Pi = E(Key, Ai) ^ Ci
-		int l = min(length, 16);
-		length -= l;
-		for (int j = 0; j < l; ++j) {
-			*p = Si.data[j] ^ *c;
-			++c;
-			++p;
-		}
-	}
-	
-	// set CTR-counter for A0
-	Ai.setU16B(14, 0);
-
-	// S0 = E(Key, A0)
-	encrypt(Si, Ai, aesKey);
-	
-	// U = S0 ^ T
-	for (int j = 0; j < micLength; ++j) {
-		*u = Si.data[j] ^ *t;
-		++t;
-		++u;
-	}
-}
-
-void encrypt(uint8_t *result, uint8_t const *header, int headerLength, uint8_t const *message, int payloadLength,
-	int micLength, Array<uint8_t const, 13> nonce, AesKey const &aesKey)
-{
-	int L = 2; // size of message length field
-	int M = 4; // size of authentication field (is 4 also for GP security level 1 where only 2 byte MIC is transferred)
-	uint8_t const flags = 0x40 | ((M - 2) / 2 << 3) | (L - 1);
-
-	
-	// C.3.2 Authentication Transformation
-	// AES in block chaining mode, see https://de.wikipedia.org/wiki/Cipher_Block_Chaining_Mode
-	DataBuffer<16> Xi;
-
-	// X0 ^ B0 (X0 is zero)
-	Xi.setU8(0, flags);
-	Xi.setData(1, nonce);
-	Xi.setU16B(14, payloadLength);
-
-	// X1 = E(key, X0 ^ B0)
-	encrypt(Xi, Xi, aesKey);
-	
-	// X1 ^ B1
-	Xi.xorU16B(0, headerLength);
-	Xi.xorData(2, headerLength, header);
-	header += 14;
-	headerLength -= 14;
-
-	// X2 = E(key, X1 ^ B1)
-	encrypt(Xi, Xi, aesKey);
-
-	// repeat for remainder of header
-	while (headerLength > 0) {
-		// Xi ^ Bi
-		Xi.xorData(0, headerLength, header);
-		header += 16;
-		headerLength -= 16;
-
-		// Xi+1 = E(key, Xi ^ Bi)
-		encrypt(Xi, Xi, aesKey);
-	}
-
-	uint8_t const *b = message;
-	int length = payloadLength;
-	while (length > 0) {
-		// Xi ^ Bi
-		int l = min(length, 16);
-		length -= l;
-		for (int j = 0; j < l; ++j) {
-			Xi.data[j] ^= *b;
-			++b;
-		}
-
-		// Xi+1 = E(key, Xi ^ Bi)
-		encrypt(Xi, Xi, aesKey);
-	}
-
-	// authentication tag T is in Xi (message integrity code)
-
-	crypt(result, result + payloadLength, message, payloadLength, Xi.data, micLength, nonce, aesKey);
-}
-
-bool decrypt(uint8_t *result, uint8_t const *header, int headerLength, uint8_t const *message, int payloadLength,
-	int micLength, Array<uint8_t const, 13> nonce, AesKey const &aesKey)
-{
-	int M = 4; // size of authentication field (is 4 also for security level 1)
-	uint8_t const flags = 0x40 | ((M - 2) / 2 << 3) | (L - 1);
-
-	uint8_t T[4];
-	crypt(result, T, message, payloadLength, message + payloadLength, micLength, nonce, aesKey);
-	
-	// C.4.2 Authentication Checking Transformation
-	// C.3.2 Authentication Transformation
+constexpr int M = 4; // size of authentication field (is 4 also for GP security level 1 where only 2 byte MIC is transferred)
+
+namespace {
+
+/**
+ * CCM* engine that runs authentication (CBC-MAC) and encryption (CTR) in a single pass over the message. Each
+ * message block is read once, authenticated and encrypted/decrypted in place
+ */
+class Ccm {
+public:
+	Ccm(int headerLength, uint8_t const *header, int payloadLength, Array<uint8_t const, 13> nonce,
+		AesKey const &aesKey) : aesKey(aesKey)
 	{
+		// C.3.2 Authentication Transformation
 		// AES in block chaining mode, see https://de.wikipedia.org/wiki/Cipher_Block_Chaining_Mode
-		DataBuffer<16> Xi;
 
 		// X0 ^ B0 (X0 is zero)
-		Xi.setU8(0, flags);
-		Xi.setData(1, nonce);
-		Xi.setU16B(14, payloadLength);
+		this->X[0] = 0x40 | ((M - 2) / 2 << 3) | (L - 1);
+		array::copy(13, this->X + 1, nonce.data());
+		this->X[14] = payloadLength >> 8;
+		this->X[15] = payloadLength;
 
 		// X1 = E(key, X0 ^ B0)
-		encrypt(Xi, Xi, aesKey);
-		
+		aes(this->X, this->X, aesKey);
+
 		// X1 ^ B1
-		Xi.xorU16B(0, headerLength);
-		Xi.xorData(2, headerLength, header);
+		this->X[0] ^= headerLength >> 8;
+		this->X[1] ^= headerLength;
+		xorBlock(this->X + 2, header, min(headerLength, 14));
 		header += 14;
 		headerLength -= 14;
-		
+
 		// X2 = E(key, X1 ^ B1)
-		encrypt(Xi, Xi, aesKey);
+		aes(this->X, this->X, aesKey);
 
 		// repeat for remainder of header
 		while (headerLength > 0) {
 			// Xi ^ Bi
-			Xi.xorData(0, headerLength, header);
+			xorBlock(this->X, header, min(headerLength, 16));
 			header += 16;
 			headerLength -= 16;
 
 			// Xi+1 = E(key, Xi ^ Bi)
-			encrypt(Xi, Xi, aesKey);
+			aes(this->X, this->X, aesKey);
 		}
 
-		uint8_t *b = result;
-		int length = payloadLength;
-		while (length > 0) {
-			// Xi ^ Bi
-			int l = min(length, 16);
-			length -= l;
+		// C.4.1 Decryption Transformation
+		// AES in counter mode, see https://de.wikipedia.org/wiki/Counter_Mode
+		this->A[0] = L - 1;
+		array::copy(13, this->A + 1, nonce.data());
+	}
+
+	/**
+	 * Authenticate and encrypt the payload, works in-place if result and message are the same
+	 */
+	void encrypt(uint8_t *result, uint8_t const *message, int payloadLength) {
+		for (int i = 1; payloadLength > 0; ++i) {
+			// Si = E(Key, Ai)
+			keyStream(i);
+
+			// Xi ^ Bi, Ci = Si ^ Pi
+			int l = min(payloadLength, 16);
+			payloadLength -= l;
 			for (int j = 0; j < l; ++j) {
-				Xi.data[j] ^= *b;
-				++b;
+				uint8_t p = message[j];
+				this->X[j] ^= p;
+				result[j] = this->S[j] ^ p;
 			}
+			message += l;
+			result += l;
 
 			// Xi+1 = E(key, Xi ^ Bi)
-			encrypt(Xi, Xi, aesKey);
+			aes(this->X, this->X, this->aesKey);
 		}
-	
-		// compare authentication tag T
-		uint8_t ok = 0;
-		for (int j = 0; j < micLength; ++j) {
-			ok |= T[j] ^ Xi.data[j];
+	}
+
+	/**
+	 * Decrypt and authenticate the payload, works in-place if result and message are the same
+	 */
+	void decrypt(uint8_t *result, uint8_t const *message, int payloadLength) {
+		for (int i = 1; payloadLength > 0; ++i) {
+			// Si = E(Key, Ai)
+			keyStream(i);
+
+			// Pi = Si ^ Ci, Xi ^ Bi
+			int l = min(payloadLength, 16);
+			payloadLength -= l;
+			for (int j = 0; j < l; ++j) {
+				uint8_t p = this->S[j] ^ message[j];
+				result[j] = p;
+				this->X[j] ^= p;
+			}
+			message += l;
+			result += l;
+
+			// Xi+1 = E(key, Xi ^ Bi)
+			aes(this->X, this->X, this->aesKey);
 		}
-		return ok == 0;
 	}
+
+	/**
+	 * Get encrypted authentication tag U = S0 ^ T where T is in X after the payload was processed
+	 */
+	uint8_t const *tag() {
+		keyStream(0);
+		xorBlock(this->S, this->X, 16);
+		return this->S;
+	}
+
+protected:
+
+	static void xorBlock(uint8_t *x, uint8_t const *b, int length) {
+		for (int j = 0; j < length; ++j)
+			x[j] ^= b[j];
+	}
+
+	static void aes(uint8_t *out, uint8_t const *in, AesKey const &aesKey) {
+		aesEncrypt(out, in, aesKey);
+	}
+
+	// set CTR-counter and calculate key stream block S = E(Key, A)
+	void keyStream(int i) {
+		this->A[14] = i >> 8;
+		this->A[15] = i;
+		aes(this->S, this->A, this->aesKey);
+	}
+
+	AesKey const &aesKey;
+
+	// CBC-MAC state
+	uint8_t X[16];
+
+	// CTR counter block and key stream
+	uint8_t A[16];
+	uint8_t S[16];
+};
+
+} // namespace
+
+void encrypt(uint8_t *result, uint8_t const *header, int headerLength, uint8_t const *message, int payloadLength,
+	int micLength, Array<uint8_t const, 13> nonce, AesKey const &aesKey)
+{
+	Ccm ccm(headerLength, header, payloadLength, nonce, aesKey);
+	ccm.encrypt(result, message, payloadLength);
+
+	// append encrypted authentication tag (message integrity code)
+	array::copy(micLength, result + payloadLength, ccm.tag());
+}
+
+bool decrypt(uint8_t *result, uint8_t const *header, int headerLength, uint8_t const *message, int payloadLength,
+	int micLength, Array<uint8_t const, 13> nonce, AesKey const &aesKey)
+{
+	Ccm ccm(headerLength, header, payloadLength, nonce, aesKey);
+	ccm.decrypt(result, message, payloadLength);
+
+	// C.4.2 Authentication Checking Transformation: compare encrypted authentication tag with MIC after payload
+	auto U = ccm.tag();
+	auto mic = message + payloadLength;
+	uint8_t ok = 0;
+	for (int j = 0; j < micLength; ++j) {
+		ok |= U[j] ^ mic[j];
+	}
+	return ok == 0;
 }
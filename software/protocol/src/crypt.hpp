@@ -10,8 +10,16 @@ inline void setKey(AesKey &aesKey, Array<uint8_t const, 16> key) {
 	tc_aes128_set_encrypt_key(&aesKey, key.data());
 }
 
+/**
+ * Encrypt one block using the fastest available AES backend (AES-NI, ARMv8 cryptography extension or tinycrypt)
+ * @param out encrypted block, may be the same as in
+ * @param in block to encrypt
+ * @param aesKey key schedule created by setKey()
+ */
+void aesEncrypt(uint8_t *out, uint8_t const *in, AesKey const &aesKey);
+
 inline void encrypt(Array<uint8_t, 16> out, Array<uint8_t const, 16> in, AesKey const &aesKey) {
-	tc_aes_encrypt(out.data(), in.data(), &aesKey);
+	aesEncrypt(out.data(), in.data(), aesKey);
 }
 
 /**
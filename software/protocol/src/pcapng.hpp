@@ -0,0 +1,78 @@
+#pragma once
+
+#include "pcap.hpp"
+#include <cstdint>
+
+
+// pcap next generation capture file format, see https://www.ietf.org/archive/id/draft-tuexen-opsawg-pcapng-05.html
+namespace pcapng {
+
+enum class BlockType : uint32_t {
+	INTERFACE_DESCRIPTION = 1,
+	INTERFACE_STATISTICS = 5,
+	ENHANCED_PACKET = 6,
+	SECTION_HEADER = 0x0A0D0D0A
+};
+
+enum class OptionCode : uint16_t {
+	END_OF_OPTIONS = 0,
+
+	// interface description block
+	IF_TSRESOL = 9,
+
+	// interface statistics block
+	ISB_STARTTIME = 2,
+	ISB_ENDTIME = 3,
+	ISB_IFRECV = 4,
+	ISB_IFDROP = 5,
+	ISB_OSDROP = 7
+};
+
+// header of a block, followed by the block body and the total length again
+struct BlockHeader {
+	BlockType type;
+	uint32_t totalLength;
+};
+
+// section header block without options, starts a file
+struct SectionHeader {
+	BlockHeader header;
+	uint32_t byteOrderMagic; // 0x1A2B3C4D
+	uint16_t majorVersion;
+	uint16_t minorVersion;
+	int64_t sectionLength; // -1 if not specified
+};
+
+// interface description block without options
+struct InterfaceDescription {
+	BlockHeader header;
+	uint16_t linkType; // see pcap::Network
+	uint16_t reserved;
+	uint32_t snapLength;
+};
+
+// option header, followed by the option value padded to 32 bit
+struct OptionHeader {
+	OptionCode code;
+	uint16_t length;
+};
+
+// enhanced packet block, followed by the packet data padded to 32 bit
+struct EnhancedPacket {
+	BlockHeader header;
+	uint32_t interfaceId;
+	uint32_t timestampHigh;
+	uint32_t timestampLow;
+	uint32_t capturedLength;
+	uint32_t originalLength;
+};
+
+// interface statistics block, followed by options
+struct InterfaceStatistics {
+	BlockHeader header;
+	uint32_t interfaceId;
+	uint32_t timestampHigh;
+	uint32_t timestampLow;
+};
+
+} // namespace pcapng
@@ -207,22 +207,6 @@ def PlugType(types, totalBitCount, bitIndex, tabs, parentPrefix, prefix):
 			PlugType(type[5], totalBitCount, bitIndex, tabs + '\t', f"{prefix}{name} | ", f"{prefix}{name}_")
 		
 
-def getLabel(types, tabs, prefix, defaultLabel):
-	print(f"{tabs}switch (type & PlugType::{prefix}CATEGORY) {{")
-	for i in range(1, len(types)):
-		type = types[i]
-		name = type[0]
-		label = type[2]
-		print(f"{tabs}case PlugType::{prefix}{name}:")
-		if len(type) >= 6:
-			getLabel(type[5], tabs + '\t', prefix + name + '_', f"\"{label}\"")
-		else:
-			print(f"{tabs}\treturn \"{label}\";")		
-	print(f"{tabs}default:")
-	print(f"{tabs}\treturn {defaultLabel};")
-	print(f"{tabs}}}")		
-
-
 def collectUsages(types, usages, defaultUsage):
 	for i in range(1, len(types)):
 		type = types[i]
@@ -237,63 +221,46 @@ def collectUsages(types, usages, defaultUsage):
 			collectUsages(type[5], usages, usage)
 
 
-def hasUsage(types):
+# flatten the type tree into a list of type infos where the sub-types of each type are stored consecutively, so that
+# the index of a sub-type is the index of the first sub-type plus the value of the category bits minus one
+def collectTypeInfos(types, bitIndex, parentType, parentUsage, parentToggle, root, infos):
+	bitIndex -= types[0]
+	first = len(infos)
 	for i in range(1, len(types)):
 		type = types[i]
-		usage = type[3]
-		if usage:
-			return True
-		if len(type) >= 6 and hasUsage(type[5]):
-			return True
-	return False
-	
-	
-def getUsage(types, tabs, prefix, parentFlags, parentUsage):
-	print(f"{tabs}switch (t & PlugType::{prefix}CATEGORY) {{")
-	for i in range(1, len(types)):
-		type = types[i]
-		name = type[0]
 		flags = type[1]
+		label = type[2]
 		usage = type[3]
-		if len(type) < 6 or not hasUsage(type[5]):
-			# is leaf
-			if usage:
-				print(f"{tabs}case PlugType::{prefix}{name}:")
-				if flags & TOGGLE:
-					print(f"{tabs}\treturn cmd ? Usage::{usage}_TOGGLE : Usage::{usage};")
-				else:
-					print(f"{tabs}\treturn Usage::{usage};")
+		isLeaf = len(type) < 6
+
+		# usage is inherited from the parent if not set
+		toggle = parentToggle
+		if usage:
+			toggle = (flags & TOGGLE) != 0
 		else:
-			# has children with usage
-			print(f"{tabs}case PlugType::{prefix}{name}:")
-			if usage:
-				getUsage(type[5], tabs + '\t', prefix + name + '_', flags, usage)
-			else:
-				getUsage(type[5], tabs + '\t', prefix + name + '_', parentFlags, parentUsage)
-	print(f"{tabs}default:")
-	if parentFlags & TOGGLE:
-		print(f"{tabs}\treturn cmd ? Usage::{parentUsage}_TOGGLE : Usage::{parentUsage};")
-	else:
-		print(f"{tabs}\treturn Usage::{parentUsage};")
-	print(f"{tabs}}}")
-
-
-def isCompatible(types, tabs, prefix):
-	print(f"{tabs}if ((src & PlugType::{prefix}CATEGORY) == dst) return true;")
-	print(f"{tabs}switch (dst & PlugType::{prefix}CATEGORY) {{")
+			usage = parentUsage
+
+		# first type on the path that is compatible to its sub-types or is a leaf
+		index = len(infos)
+		typeRoot = root
+		if typeRoot is None and (flags & COMPATIBLE or isLeaf):
+			typeRoot = index
+
+		infos.append({"type": parentType | (i << bitIndex), "label": label, "usage": usage, "toggle": toggle,
+			"bitIndex": bitIndex, "childBitIndex": 0, "childBitCount": 0, "firstChild": 0, "childCount": 0,
+			"root": index if typeRoot is None else typeRoot, "hasRoot": typeRoot is not None})
+
+	# append sub-types after all types of this category
 	for i in range(1, len(types)):
 		type = types[i]
-		name = type[0]
-		flags = type[1]
-		print(f"{tabs}case PlugType::{prefix}{name}:")
-		if flags & COMPATIBLE or len(type) < 6:
-			# subtypes are compatible to this type
-			print(f"{tabs}\treturn (src & PlugType::{prefix}CATEGORY) == PlugType::{prefix}{name};")
-		else:
-			isCompatible(type[5], tabs + '\t', prefix + name + '_')	
-	print(f"{tabs}default:")
-	print(f"{tabs}\treturn false;")
-	print(f"{tabs}}}")
+		if len(type) >= 6:
+			info = infos[first + i - 1]
+			info["childBitIndex"] = bitIndex - type[5][0]
+			info["childBitCount"] = type[5][0]
+			info["childCount"] = len(type[5]) - 1
+			info["firstChild"] = len(infos)
+			root = info["root"] if info["hasRoot"] else None
+			collectTypeInfos(type[5], bitIndex, info["type"], info["usage"], info["toggle"], root, infos)
 
 
 
@@ -343,22 +310,92 @@ print("};")
 f = open('../../node/src/functions.generated.cpp', 'w')
 sys.stdout = f
 
-# getTypeLabel()
-print("String getTypeLabel(PlugType type) {")
-getLabel(types, "\t", "", "{}")
-print("}")
+# the first entry is the invalid type which has the top level categories as sub-types
+infos = [{"type": 0, "label": "", "usage": "NONE", "toggle": False,
+	"bitIndex": 13 - types[0], "childBitIndex": 13 - types[0], "childBitCount": types[0],
+	"firstChild": 1, "childCount": len(types) - 1, "root": 0, "hasRoot": False}]
+collectTypeInfos(types, 13, 0, "NONE", False, None, infos)
+if len(infos) > 256:
+	print("error: too many types for 8 bit type index")
+	exit()
 
-# getUsage()
-print("""
-Usage getUsage(PlugType type) {
-	bool cmd = (type & PlugType::CMD) != 0;
-	auto t = type & PlugType::TYPE_MASK;
+# label strings, each label is stored once
+labels = ""
+labelOffsets = {}
+for info in infos:
+	label = info["label"]
+	if label not in labelOffsets:
+		labelOffsets[label] = len(labels)
+		labels += label
+
+# info for each type
+print("""// info for a type
+struct TypeInfo {
+	// type without direction and command flag
+	uint16_t type;
+
+	// label in typeLabels
+	uint16_t labelOffset;
+	uint8_t labelLength;
+
+	// lowest bit of the category of this type
+	uint8_t bitIndex;
+
+	// category of the sub-types and their range in typeInfos (count is zero if the type has no sub-types)
+	uint8_t childBitIndex;
+	uint8_t childBitCount;
+	uint8_t firstChild;
+	uint8_t childCount;
+
+	// usage (inherited from parent if the type has no usage) and usage in a command message
+	Usage usage;
+	Usage commandUsage;
+
+	// first type on the path that is compatible to all its sub-types (the type itself and hasRoot is false if there is
+	// none)
+	uint8_t root;
+	bool hasRoot;
+};
 """)
-getUsage(types, "\t", "", 0, "NONE")
-print("}")
+print(f"static char const typeLabels[] = \"{labels}\";\n")
+print("static TypeInfo const typeInfos[] = {")
+for info in infos:
+	label = info["label"]
+	usage = info["usage"]
+	commandUsage = f"{usage}_TOGGLE" if info["toggle"] else usage
+	print(f"\t{{{info['type']:#06x}, {labelOffsets[label]}, {len(label)}, {info['bitIndex']}, "
+		f"{info['childBitIndex']}, {info['childBitCount']}, {info['firstChild']}, {info['childCount']}, "
+		f"Usage::{usage}, Usage::{commandUsage}, {info['root']}, {'true' if info['hasRoot'] else 'false'}}},")
+print("};")
 
-# isCompatible()
 print("""
+// mask of a type including all categories down to the given bit index
+constexpr int getTypeMask(int bitIndex) {
+	return int(PlugType::TYPE_MASK) & (int(PlugType::TYPE_MASK) << bitIndex);
+}
+
+// find a type or its deepest known parent, returns the invalid type at index 0 if the category is unknown
+static TypeInfo const &findTypeInfo(int type) {
+	auto info = &typeInfos[0];
+	while (info->childCount > 0) {
+		int i = (type >> info->childBitIndex) & ((1 << info->childBitCount) - 1);
+		if (i == 0 || i > info->childCount)
+			break;
+		info = &typeInfos[info->firstChild + i - 1];
+	}
+	return *info;
+}
+
+String getTypeLabel(PlugType type) {
+	auto &info = findTypeInfo(int(type & PlugType::TYPE_MASK));
+	return String(info.labelLength, typeLabels + info.labelOffset);
+}
+
+Usage getUsage(PlugType type) {
+	auto &info = findTypeInfo(int(type & PlugType::TYPE_MASK));
+	return (type & PlugType::CMD) != 0 ? info.commandUsage : info.usage;
+}
+
 bool isCompatible(PlugType dstType, PlugType srcType) {
 	// output must connect to input
 	if ((srcType & PlugType::DIRECTION_MASK) != PlugType::OUT || (dstType & PlugType::DIRECTION_MASK) != PlugType::IN)
@@ -386,6 +423,14 @@ bool isCompatible(PlugType dstType, PlugType srcType) {
 	// command messages can't generate value messages
 	if (srcCommand && !dstCommand)
 		return false;
-""")
-isCompatible(types, "\t", "")
-print("}")
+
+	auto &info = findTypeInfo(int(dst));
+	if (info.hasRoot || info.type == int(dst)) {
+		// source must be the compatibility root (or the destination itself) or one of its sub-types
+		auto &root = typeInfos[info.root];
+		return (int(src) & getTypeMask(root.bitIndex)) == root.type;
+	}
+
+	// unknown destination type: source must be equal to the destination down to the category of the sub-types
+	return (int(src) & getTypeMask(info.childBitIndex)) == int(dst);
+}""")
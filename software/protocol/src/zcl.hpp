@@ -1,5 +1,7 @@
 #pragma once
 
+#include "MessageReader.hpp"
+#include "MessageWriter.hpp"
 #include <enum.hpp>
 #include <cstdint>
 
@@ -27,6 +29,7 @@ enum class Cluster : uint16_t {
 	GREEN_POWER = 0x0021,
 	THERMOSTAT = 0x0201,
 	COLOR_CONTROL = 0x0300,
+	TEMPERATURE_MEASUREMENT = 0x0402,
 	ZLL_COMMISSIONING = 0x1000,
 };
 
@@ -65,7 +68,19 @@ enum class Command : uint8_t {
 
 enum class Status : uint8_t {
 	SUCCESS = 0x00,
-	UNSUPPORTED_ATTRIBUTE = 0x86
+	FAILURE = 0x01,
+	UNSUPPORTED_ATTRIBUTE = 0x86,
+	UNREPORTABLE_ATTRIBUTE = 0x8c,
+	INVALID_DATA_TYPE = 0x8d
+};
+
+// direction field of configure reporting records
+enum class ReportingDirection : uint8_t {
+	// attribute is reported by the server (followed by data type, min/max interval and reportable change)
+	REPORTED = 0x00,
+
+	// attribute reports are received by the server (followed by timeout)
+	RECEIVED = 0x01
 };
 
 enum class DataType : uint8_t  {
@@ -88,6 +103,90 @@ enum class DataType : uint8_t  {
 	STRING = 0x42 // length in first byte
 };
 
+/**
+ * Get size of a value of fixed size
+ * @param type data type
+ * @return size in bytes or 0 if the size is not fixed or the type is unknown
+ */
+constexpr int getSize(DataType type) {
+	switch (type) {
+	case DataType::BOOL:
+	case DataType::UINT8:
+	case DataType::INT8:
+	case DataType::ENUM8:
+		return 1;
+	case DataType::UINT16:
+	case DataType::INT16:
+	case DataType::ENUM16:
+	case DataType::SEMI:
+		return 2;
+	case DataType::UINT24:
+		return 3;
+	case DataType::SINGLE:
+		return 4;
+	case DataType::DOUBLE:
+		return 8;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * Check if a data type is analog, only analog attributes have a reportable change in configure reporting
+ * @param type data type
+ * @return true if analog
+ */
+constexpr bool isAnalog(DataType type) {
+	return (type >= DataType::UINT8 && type <= DataType::INT16) || (type >= DataType::SEMI && type <= DataType::DOUBLE);
+}
+
+/**
+ * Write an attribute reporting configuration record of a configure reporting command for an attribute that gets
+ * reported by the server
+ * @param w message writer
+ * @param attribute attribute id
+ * @param type data type of the attribute
+ * @param minInterval minimum reporting interval in seconds
+ * @param maxInterval maximum reporting interval in seconds, 0xffff disables periodic reports
+ * @param reportableChange minimum change of an analog attribute that causes a report
+ */
+inline void writeReportingConfiguration(MessageWriter &w, uint16_t attribute, DataType type, uint16_t minInterval,
+	uint16_t maxInterval, uint16_t reportableChange)
+{
+	w.e8(ReportingDirection::REPORTED);
+	w.u16L(attribute);
+	w.e8(type);
+	w.u16L(minInterval);
+	w.u16L(maxInterval);
+	if (isAnalog(type)) {
+		// reportable change has the size of the attribute
+		int size = getSize(type);
+		for (int i = 0; i < size; ++i)
+			w.u8(i < 2 ? uint8_t(reportableChange >> i * 8) : 0);
+	}
+}
+
+/**
+ * Get the status of an attribute from a configure reporting response. The response only contains one status if all
+ * records were successful, otherwise it contains an attribute status record for each record that failed
+ * @param r reader for the payload of the response
+ * @param attribute attribute id
+ * @return status of the attribute
+ */
+inline Status getReportingStatus(MessageReader r, uint16_t attribute) {
+	if (r.getRemaining() < 1)
+		return Status::FAILURE;
+	if (r.getRemaining() == 1)
+		return r.e8<Status>();
+	while (r.getRemaining() >= 4) {
+		auto status = r.e8<Status>();
+		auto direction = r.e8<ReportingDirection>();
+		if (r.u16L() == attribute && direction == ReportingDirection::REPORTED)
+			return status;
+	}
+	return Status::SUCCESS;
+}
+
 // basic cluster
 // -------------
 
@@ -216,4 +315,16 @@ enum class ThermostatCommand : uint16_t {
 
 };
 
+// temperature measurement
+// -----------------------
+
+enum class TemperatureMeasurementAttribute : uint16_t {
+	MEASURED_VALUE = 0x0000, // (INT16S / 100 Celsius, read only, required)
+	MIN_MEASURED_VALUE = 0x0001, // (INT16S, read only, required)
+	MAX_MEASURED_VALUE = 0x0002, // (INT16S, read only, required)
+	TOLERANCE = 0x0003, // (INT16U, read only)
+	CLUSTER_REVISION = 0xFFFD, // (INT16U, required)
+	REPORTING_STATUS = 0xFFFE // (ENUM8)
+};
+
 } // namespace zcl
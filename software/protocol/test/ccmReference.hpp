@@ -0,0 +1,86 @@
+#pragma once
+
+#include <crypt.hpp>
+#include <DataBuffer.hpp>
+#include <util.hpp>
+
+
+// reference implementation of CCM* with separate authentication (CBC-MAC) and encryption (CTR) passes
+namespace reference {
+
+constexpr int L = 2;
+constexpr int M = 4;
+
+inline void crypt(uint8_t *p, uint8_t *u, uint8_t const *c, int payloadLength, uint8_t const *t, int micLength,
+	Array<uint8_t const, 13> nonce, AesKey const &aesKey)
+{
+	DataBuffer<16> Ai;
+	Ai.setU8(0, L - 1);
+	Ai.setData(1, nonce);
+	DataBuffer<16> Si;
+	int i = 1;
+	int length = payloadLength;
+	while (length > 0) {
+		Ai.setU16B(14, i++);
+		encrypt(Si, Ai, aesKey);
+		int l = min(length, 16);
+		length -= l;
+		for (int j = 0; j < l; ++j)
+			*p++ = Si.data[j] ^ *c++;
+	}
+	Ai.setU16B(14, 0);
+	encrypt(Si, Ai, aesKey);
+	for (int j = 0; j < micLength; ++j)
+		*u++ = Si.data[j] ^ *t++;
+}
+
+inline void authenticate(DataBuffer<16> &Xi, uint8_t const *header, int headerLength, uint8_t const *message,
+	int payloadLength, Array<uint8_t const, 13> nonce, AesKey const &aesKey)
+{
+	Xi.setU8(0, 0x40 | ((M - 2) / 2 << 3) | (L - 1));
+	Xi.setData(1, nonce);
+	Xi.setU16B(14, payloadLength);
+	encrypt(Xi, Xi, aesKey);
+	Xi.xorU16B(0, headerLength);
+	Xi.xorData(2, headerLength, header);
+	header += 14;
+	headerLength -= 14;
+	encrypt(Xi, Xi, aesKey);
+	while (headerLength > 0) {
+		Xi.xorData(0, headerLength, header);
+		header += 16;
+		headerLength -= 16;
+		encrypt(Xi, Xi, aesKey);
+	}
+	int length = payloadLength;
+	while (length > 0) {
+		int l = min(length, 16);
+		length -= l;
+		for (int j = 0; j < l; ++j)
+			Xi.data[j] ^= *message++;
+		encrypt(Xi, Xi, aesKey);
+	}
+}
+
+inline void encrypt(uint8_t *result, uint8_t const *header, int headerLength, uint8_t const *message, int payloadLength,
+	int micLength, Array<uint8_t const, 13> nonce, AesKey const &aesKey)
+{
+	DataBuffer<16> Xi;
+	authenticate(Xi, header, headerLength, message, payloadLength, nonce, aesKey);
+	crypt(result, result + payloadLength, message, payloadLength, Xi.data, micLength, nonce, aesKey);
+}
+
+inline bool decrypt(uint8_t *result, uint8_t const *header, int headerLength, uint8_t const *message, int payloadLength,
+	int micLength, Array<uint8_t const, 13> nonce, AesKey const &aesKey)
+{
+	uint8_t T[4];
+	crypt(result, T, message, payloadLength, message + payloadLength, micLength, nonce, aesKey);
+	DataBuffer<16> Xi;
+	authenticate(Xi, header, headerLength, result, payloadLength, nonce, aesKey);
+	uint8_t ok = 0;
+	for (int j = 0; j < micLength; ++j)
+		ok |= T[j] ^ Xi.data[j];
+	return ok == 0;
+}
+
+} // namespace reference
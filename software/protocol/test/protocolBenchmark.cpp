@@ -0,0 +1,47 @@
+#include "crypt.hpp"
+#include "Nonce.hpp"
+#include "ccmReference.hpp"
+#include <util.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+
+
+static uint8_t const key[] = {0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCa, 0xCb, 0xCc, 0xCd, 0xCe, 0xCf};
+constexpr uint32_t deviceId = 0x87654321;
+constexpr uint32_t counter = 0x00000002;
+
+// benchmark single pass CCM* against the reference for typical zbee frames
+TEST(protocolBenchmark, ccm) {
+	AesKey aesKey;
+	setKey(aesKey, key);
+	Nonce nonce(deviceId, counter);
+	constexpr int count = 5000;
+
+	// header (nwk header and auxiliary security header) and payload (aps and zcl) sizes
+	static int const sizes[][2] = {{10, 1}, {30, 20}, {30, 60}, {24, 80}};
+	for (auto size : sizes) {
+		int headerLength = size[0];
+		int payloadLength = size[1];
+		uint8_t frame[127] = {};
+
+		auto start1 = std::chrono::steady_clock::now();
+		for (int i = 0; i < count; ++i) {
+			frame[0] = i;
+			encrypt(frame + headerLength, frame, headerLength, frame + headerLength, payloadLength, 4, nonce, aesKey);
+			decrypt(frame + headerLength, frame, headerLength, frame + headerLength, payloadLength, 4, nonce, aesKey);
+		}
+		auto single = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start1).count();
+
+		auto start2 = std::chrono::steady_clock::now();
+		for (int i = 0; i < count; ++i) {
+			frame[0] = i;
+			reference::encrypt(frame + headerLength, frame, headerLength, frame + headerLength, payloadLength, 4, nonce, aesKey);
+			reference::decrypt(frame + headerLength, frame, headerLength, frame + headerLength, payloadLength, 4, nonce, aesKey);
+		}
+		auto twoPass = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start2).count();
+
+		std::cout << "CCM* header " << headerLength << " payload " << payloadLength << ": single pass "
+			<< single / count << "us, two pass " << twoPass / count << "us" << std::endl;
+	}
+}
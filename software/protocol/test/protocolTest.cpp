@@ -3,6 +3,8 @@
 #include "crypt.hpp"
 #include "Nonce.hpp"
 #include "hash.hpp"
+#include "zcl.hpp"
+#include "ccmReference.hpp"
 #include <util.hpp>
 #include <gtest/gtest.h>
 
@@ -26,6 +28,65 @@ TEST(protocolTest, crc16) {
 	EXPECT_EQ(crc, 0x882a);
 }
 
+TEST(protocolTest, zclDataType) {
+	// size of values, e.g. for skipping unknown attributes in attribute reports
+	EXPECT_EQ(zcl::getSize(zcl::DataType::BOOL), 1);
+	EXPECT_EQ(zcl::getSize(zcl::DataType::INT16), 2);
+	EXPECT_EQ(zcl::getSize(zcl::DataType::UINT24), 3);
+	EXPECT_EQ(zcl::getSize(zcl::DataType::STRING), 0);
+
+	// only analog attributes have a reportable change in configure reporting
+	EXPECT_FALSE(zcl::isAnalog(zcl::DataType::BOOL));
+	EXPECT_TRUE(zcl::isAnalog(zcl::DataType::UINT8));
+	EXPECT_TRUE(zcl::isAnalog(zcl::DataType::INT16));
+	EXPECT_FALSE(zcl::isAnalog(zcl::DataType::ENUM8));
+	EXPECT_TRUE(zcl::isAnalog(zcl::DataType::SINGLE));
+	EXPECT_FALSE(zcl::isAnalog(zcl::DataType::STRING));
+}
+
+TEST(protocolTest, zclReporting) {
+	// attribute reporting configuration record of a discrete attribute has no reportable change
+	{
+		uint8_t message[16];
+		MessageWriter w(message);
+		zcl::writeReportingConfiguration(w, 0x0000, zcl::DataType::BOOL, 1, 300, 0);
+		uint8_t const expected[] = {0x00, 0x00, 0x00, 0x10, 0x01, 0x00, 0x2c, 0x01};
+		ASSERT_EQ(w.getLength(), int(sizeof(expected)));
+		EXPECT_EQ(memcmp(message, expected, sizeof(expected)), 0);
+	}
+
+	// reportable change of an analog attribute has the size of the attribute
+	{
+		uint8_t message[16];
+		MessageWriter w(message);
+		zcl::writeReportingConfiguration(w, 0x0000, zcl::DataType::INT16, 10, 600, 0x1234);
+		uint8_t const expected[] = {0x00, 0x00, 0x00, 0x29, 0x0a, 0x00, 0x58, 0x02, 0x34, 0x12};
+		ASSERT_EQ(w.getLength(), int(sizeof(expected)));
+		EXPECT_EQ(memcmp(message, expected, sizeof(expected)), 0);
+	}
+
+	// response with a single status for all records
+	{
+		uint8_t response[] = {0x00};
+		EXPECT_EQ(zcl::getReportingStatus(MessageReader(sizeof(response), response), 0x0000), zcl::Status::SUCCESS);
+	}
+
+	// response with a status record for each failed record, attributes that are not listed were successful
+	{
+		uint8_t response[] = {0x8c, 0x00, 0x00, 0x00, 0x86, 0x00, 0x21, 0x00};
+		MessageReader r(sizeof(response), response);
+		EXPECT_EQ(zcl::getReportingStatus(r, 0x0000), zcl::Status::UNREPORTABLE_ATTRIBUTE);
+		EXPECT_EQ(zcl::getReportingStatus(r, 0x0021), zcl::Status::UNSUPPORTED_ATTRIBUTE);
+		EXPECT_EQ(zcl::getReportingStatus(r, 0x0001), zcl::Status::SUCCESS);
+	}
+
+	// empty response
+	{
+		uint8_t response[1];
+		EXPECT_EQ(zcl::getReportingStatus(MessageReader(0, response), 0x0000), zcl::Status::FAILURE);
+	}
+}
+
 
 
 static uint8_t const key[] = {0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCa, 0xCb, 0xCc, 0xCd, 0xCe, 0xCf};
@@ -99,6 +160,77 @@ TEST(protocolTest, security11) {
 	EXPECT_EQ(encrypted[4], 0x34);
 }
 
+// FIPS-197 C.1 and comparison of the AES backend with tinycrypt
+TEST(protocolTest, aes) {
+	static uint8_t const fipsKey[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+	static uint8_t const plaintext[] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+	static uint8_t const expectedOutput[] = {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a};
+
+	AesKey aesKey;
+	setKey(aesKey, fipsKey);
+	DataBuffer<16> output;
+	encrypt(output, plaintext, aesKey);
+	for (int i = 0; i < 16; ++i) {
+		EXPECT_EQ(output[i], expectedOutput[i]);
+	}
+
+	// compare with tinycrypt for some keys and blocks
+	uint8_t k[16];
+	DataBuffer<16> block;
+	for (int i = 0; i < 16; ++i) {
+		k[i] = i * 31 + 7;
+		block.data[i] = i * 17;
+	}
+	for (int round = 0; round < 100; ++round) {
+		k[round & 15] ^= round;
+		setKey(aesKey, k);
+		uint8_t expected[16];
+		tc_aes_encrypt(expected, block.data, &aesKey);
+
+		// encrypt in-place
+		encrypt(block, block, aesKey);
+		for (int i = 0; i < 16; ++i) {
+			EXPECT_EQ(block[i], expected[i]);
+		}
+	}
+}
+
+// compare single pass CCM* against the reference for all header and payload lengths of 802.15.4 frames
+TEST(protocolTest, ccm) {
+	AesKey aesKey;
+	setKey(aesKey, key);
+	Nonce nonce(deviceId, counter);
+
+	uint8_t frame[127];
+	for (int i = 0; i < array::count(frame); ++i)
+		frame[i] = i * 7 + 3;
+
+	for (int headerLength = 0; headerLength <= 40; ++headerLength) {
+		for (int payloadLength = 0; headerLength + payloadLength + 4 <= array::count(frame); ++payloadLength) {
+			uint8_t const *header = frame;
+			uint8_t const *payload = frame + headerLength;
+
+			// encrypt in-place
+			uint8_t encrypted1[127];
+			uint8_t encrypted2[127];
+			array::copy(payloadLength, encrypted1, payload);
+			encrypt(encrypted1, header, headerLength, encrypted1, payloadLength, 4, nonce, aesKey);
+			reference::encrypt(encrypted2, header, headerLength, payload, payloadLength, 4, nonce, aesKey);
+			for (int i = 0; i < payloadLength + 4; ++i)
+				EXPECT_EQ(encrypted1[i], encrypted2[i]);
+
+			// decrypt in-place
+			EXPECT_TRUE(decrypt(encrypted1, header, headerLength, encrypted1, payloadLength, 4, nonce, aesKey));
+			for (int i = 0; i < payloadLength; ++i)
+				EXPECT_EQ(encrypted1[i], payload[i]);
+
+			// modified MIC must fail
+			encrypted2[payloadLength + 3] ^= 1;
+			EXPECT_FALSE(decrypt(encrypted2, header, headerLength, encrypted2, payloadLength, 4, nonce, aesKey));
+		}
+	}
+}
+
 // C.5.1
 TEST(protocolTest, hash1) {
 	static uint8_t const input[] = {0xC0};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "SystemTime.hpp"
+#include <Coroutine.hpp>
+
+
+/*
+	Wakeup engine that is shared by the transitions of many functions, e.g. the functions of FunctionInterface. Instead
+	of sleeping with an own timer, a function waits for the next step of its transitions using wait() for an exact time
+	(e.g. an off timeout) or step() for the next tick of a fixed grid (e.g. an animation step or a periodic report).
+	The owner sleeps with one timer until getNext() and then calls advance() which resumes all functions that are due
+	in one batch, so that the steps on the grid get published together. A function that stops waiting, e.g. because
+	select() returned for another event, is removed from the engine.
+	The functions still calculate their transitions themselves and publish target values with a transition time so
+	that the devices fade on their own.
+*/
+class Animator {
+public:
+	// interval of the tick grid, transitions are specified in 1/10 s
+	static constexpr SystemDuration TICK = 100ms;
+
+	/**
+	 * Wait until the given time, e.g. for a timeout
+	 * @param time time at which to resume
+	 * @return use co_await on return value to wait
+	 */
+	[[nodiscard]] Awaitable<SystemTime> wait(SystemTime time) {
+		// wake up the owner if the time is earlier than the next time
+		if (!this->active || time < this->next) {
+			this->next = time;
+			this->active = true;
+			this->wakeup.resumeAll();
+		}
+		return {this->waitlist, time};
+	}
+
+	/**
+	 * Wait until the tick at or after the given time, e.g. for an animation step
+	 * @param time time of the step
+	 * @return use co_await on return value to wait
+	 */
+	[[nodiscard]] Awaitable<SystemTime> step(SystemTime time) {
+		// round up to the tick grid
+		uint32_t t = time.value + TICK.value - 1;
+		return wait({t - t % TICK.value});
+	}
+
+	/**
+	 * Get the time at which advance() needs to be called next. May be too early when a function stopped waiting
+	 * @param next next time
+	 * @return true if a function is waiting
+	 */
+	bool getNext(SystemTime &next) const {
+		next = this->next;
+		return this->active;
+	}
+
+	/**
+	 * Wait until the next time changes because a function waits for an earlier time
+	 * @return use co_await on return value to wait
+	 */
+	[[nodiscard]] Awaitable<> changed() {
+		return this->wakeup.wait();
+	}
+
+	/**
+	 * Resume all functions that are due at the given time and determine the next time
+	 * @param now current time
+	 */
+	void advance(SystemTime now) {
+		// functions that wait again update the next time in wait()
+		this->active = false;
+		this->waitlist.resumeAll([this, now](SystemTime time) {
+			if (time <= now)
+				return true;
+			if (!this->active || time < this->next) {
+				this->next = time;
+				this->active = true;
+			}
+			return false;
+		});
+	}
+
+protected:
+
+	// functions waiting for a time
+	Waitlist<SystemTime> waitlist;
+
+	// next time, only valid if active is true
+	SystemTime next = {};
+	bool active = false;
+
+	// the owner waits here for an earlier time
+	Barrier<> wakeup;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "PacketPool.hpp"
 #include <cstdint>
 #include <Coroutine.hpp>
 
@@ -59,6 +60,10 @@ public:
 		uint8_t *data;
 	};
 
+	struct ReceiveBufferParameters {
+		PacketBuffer *packet;
+	};
+
 	struct SendParameters {
 		int length;
 		uint8_t const *data;
@@ -75,6 +80,14 @@ public:
 	 */
 	[[nodiscard]] virtual Awaitable<ReceiveParameters> receive(int &length, uint8_t *data) = 0;
 
+	/**
+	 * Receive data from a bus node without copying. The message is in a buffer of the packet pool, its length is given
+	 * by getLength()
+	 * @param packet received message
+	 * @return use co_await on return value to await received data
+	 */
+	[[nodiscard]] virtual Awaitable<ReceiveBufferParameters> receive(PacketBuffer &packet) = 0;
+
 	/**
 	 * Send data to a bus node
 	 * @param length length of data to send
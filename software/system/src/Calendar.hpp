@@ -23,4 +23,10 @@ ClockTime now();
  */
 Awaitable<> secondTick();
 
+/**
+ * Suspend execution using co_await until the wall clock gets adjusted, e.g. by daylight saving time. Coroutines that
+ * wait for a wall clock time using Timer::sleep() need to recalculate the duration
+ */
+Awaitable<> clockChange();
+
 } // namespace Calendar
@@ -14,6 +14,8 @@ public:
 	static constexpr int HOURS_SHIFT   = 16;
 	static constexpr int WEEKDAY_SHIFT = 24;
 
+	static constexpr int SECONDS_PER_WEEK = 7 * 24 * 60 * 60;
+
 	ClockTime() = default;
 
 	explicit ClockTime(uint32_t time) : time(time) {}
@@ -91,6 +93,14 @@ public:
 	 */
 	int getWeekday() const {return this->time >> WEEKDAY_SHIFT;}
 
+	/**
+	 * Get seconds since start of the week (Monday 0:00)
+	 * @return seconds, range 0 - SECONDS_PER_WEEK - 1
+	 */
+	int getWeekSeconds() const {
+		return ((getWeekday() * 24 + getHours()) * 60 + getMinutes()) * 60 + getSeconds();
+	}
+
 
 	uint32_t time = 0;
 };
@@ -28,6 +28,14 @@ static uint8_t checksum(uint8_t const *buffer) {
 	return (value & 0x0f) | (checksum << 4);
 }
 
+// fill a 5 byte slot with data, control byte and checksum
+static void setSlot(uint8_t *slot, int sequenceCounter, int size, void const *data) {
+	array::fill(4, slot, 0xff);
+	array::copy(size, slot, reinterpret_cast<uint8_t const *>(data));
+	slot[4] = ((sequenceCounter & 2) << 2) | size;
+	slot[4] = checksum(slot);
+}
+
 struct Resumer {
 	Resumer(Barrier<> &barrier) : barrier(barrier) {}
 	~Resumer() {this->barrier.resumeFirst();}
@@ -82,16 +90,23 @@ Storage::Status FeRamStorage4Base::readBlocking(int index, int &size, void *data
 		return Status::INVALID_ID;
 	}
 
-	// read all 10 bytes for the given id into a buffer
-	int address = index * 10;
-	uint8_t hi = address >> 8;
-	uint8_t lo = address;
-	uint8_t command[3] = {FERAM_READ, hi, lo};
-	uint8_t buffer[3 + 10];
-	this->spi.transferBlocking(3, command, 3 + 10, buffer);
+	// check if the element is in the read-ahead buffer
+	int i = index - this->readAheadIndex;
+	if (i < 0 || i >= this->readAheadCount) {
+		// read all 10 bytes for the given id and the following ids in one burst
+		int count = min(BURST_COUNT, this->maxId + 1 - index);
+		int address = index * 10;
+		uint8_t hi = address >> 8;
+		uint8_t lo = address;
+		uint8_t command[4] = {FERAM_FSTRD, hi, lo, 0};
+		this->spi.transferBlocking(4, command, 4 + count * 10, this->readAheadBuffer);
+		this->readAheadIndex = index;
+		this->readAheadCount = count;
+		i = 0;
+	}
 
 	// read data from buffer
-	return readBuffer(size, data, index, buffer + 3);
+	return readBuffer(size, data, index, this->readAheadBuffer + 4 + i * 10);
 }
 
 Storage::Status FeRamStorage4Base::writeBlocking(int index, int size, void const *data) {
@@ -104,43 +119,80 @@ Storage::Status FeRamStorage4Base::writeBlocking(int index, int size, void const
 		return Status::DATA_SIZE_EXCEEDED;
 	}
 
+	// invalidate read-ahead buffer
+	this->readAheadCount = 0;
+
 	// write value according to lsb of sequenceCounter
 	int sequenceCounter = nextSequenceCounter(index);
 	int address = index * 10 + 5 * (sequenceCounter & 1);
 	uint8_t hi = address >> 8;
 	uint8_t lo = address;
-	uint8_t c = ((sequenceCounter & 2) << 2) | size;
-	uint8_t buffer[3 + 5] = {FERAM_WRITE, hi, lo,0xff, 0xff, 0xff, 0xff, c};
-	array::copy(size, buffer + 3, reinterpret_cast<uint8_t const *>(data));
-	buffer[3 + 4] = checksum(buffer + 3);
-	this->spi.transferBlocking(3 + size + 1, buffer, 0, nullptr);
+	uint8_t buffer[3 + 5] = {FERAM_WRITE, hi, lo};
+	setSlot(buffer + 3, sequenceCounter, size, data);
+	this->spi.transferBlocking(3 + 5, buffer, 0, nullptr);
 	//Terminal::out << "write " << dec(*(int*)data) << " seq " << dec(sequenceCounter) << '\n';
 	return Status::OK;
 }
 
 Storage::Status FeRamStorage4Base::clearBlocking() {
+	this->readAheadCount = 0;
 
 	return Status::OK;
 }
 
+void FeRamStorage4Base::visitBlocking(int prefix, int mask, Visitor const &visitor) {
+	// iterate over the range of ids given by prefix and mask, consecutive ids are read using the read-ahead buffer
+	int last = min(prefix | (~mask & 0xffff), this->maxId);
+	for (int id = prefix; id <= last; ++id) {
+		if ((id & mask) != prefix)
+			continue;
+		uint32_t value;
+		int size = 4;
+		if (readBlocking(id, size, &value) != Status::OK || size == 0)
+			continue;
+		void *data = visitor(id, size);
+		if (data != nullptr)
+			array::copy(size, reinterpret_cast<uint8_t *>(data), reinterpret_cast<uint8_t *>(&value));
+	}
+}
+
 Coroutine FeRamStorage4Base::reader() {
+	uint8_t buffer[4 + BURST_COUNT * 10];
 	while (true) {
 		co_await this->readBarrier.wait();
 
 		while (!this->readWaitlist.isEmpty()) {
-			ReadParameters &p = this->readWaitlist.getFirst();
+			// extend the range of the first read by queued reads of adjacent ids
+			int begin = this->readWaitlist.getFirst().id;
+			int end = begin + 1;
+			bool extended;
+			do {
+				extended = false;
+				this->readWaitlist.visitAll([&begin, &end, &extended](ReadParameters &p) {
+					if (end - begin < BURST_COUNT) {
+						if (p.id == end) {
+							++end;
+							extended = true;
+						} else if (p.id == begin - 1) {
+							--begin;
+							extended = true;
+						}
+					}
+				});
+			} while (extended);
 
-			// read all 10 bytes for the given id
-			int address = p.id * 10;
+			// read all 10 bytes for each id in the range in one burst
+			int address = begin * 10;
 			uint8_t hi = address >> 8;
 			uint8_t lo = address;
-			uint8_t command[3] = {FERAM_READ, hi, lo};
-			uint8_t buffer[3 + 10];
-			co_await this->spi.transfer(3, command, 3 + 10, buffer);
+			uint8_t command[4] = {FERAM_FSTRD, hi, lo, 0};
+			co_await this->spi.transfer(4, command, 4 + (end - begin) * 10, buffer);
 
-			// resume coroutine that waits for the read operation
-			this->readWaitlist.resumeFirst([this, &buffer](ReadParameters &p) {
-				*p.status = readBuffer(*p.size, p.data, p.id, buffer);
+			// resume all coroutines that wait for a read operation in the range
+			this->readWaitlist.resumeAll([this, begin, end, &buffer](ReadParameters &p) {
+				if (p.id < begin || p.id >= end)
+					return false;
+				*p.status = readBuffer(*p.size, p.data, p.id, buffer + 4 + (p.id - begin) * 10);
 				return true;
 			});
 		}
@@ -148,27 +200,57 @@ Coroutine FeRamStorage4Base::reader() {
 }
 
 Coroutine FeRamStorage4Base::writer() {
+	uint8_t buffer[3 + BURST_COUNT * 5];
+	WriteParameters *burst[BURST_COUNT];
 	while (true) {
 		co_await this->writeBarrier.wait();
 
 		while (!this->writeWaitlist.isEmpty()) {
-			WriteParameters &p = this->writeWaitlist.getFirst();
+			// invalidate read-ahead buffer
+			this->readAheadCount = 0;
 
-			// write value according to lsb of sequenceCounter
-			int sequenceCounter = nextSequenceCounter(p.index);
-			int address = p.index * 10 + 5 * (sequenceCounter & 1);
-			uint8_t hi = address >> 8;
-			uint8_t lo = address;
-			uint8_t c = ((sequenceCounter & 2) << 2) | p.size;
-			uint8_t buffer[3 + 5] = {FERAM_WRITE, hi, lo,0xff, 0xff, 0xff, 0xff, c};
-			array::copy(p.size, buffer + 3, reinterpret_cast<uint8_t const *>(p.data));
-			buffer[3 + 4] = checksum(buffer + 3);
-			co_await this->spi.transfer(3 + p.size + 1, buffer, 0, nullptr);
-
-			// resume coroutine that waits for the write operation
-			this->writeWaitlist.resumeFirst([](WriteParameters &p) {
-				*p.status = Status::OK;
-				return true;
+			// collect the first write and queued writes whose slot directly follows the slots collected so far
+			int address = 0;
+			int count = 0;
+			bool extended;
+			do {
+				extended = false;
+				this->writeWaitlist.visitAll([this, &buffer, &burst, &address, &count, &extended](WriteParameters &p) {
+					if (extended || count >= BURST_COUNT)
+						return;
+					for (int i = 0; i < count; ++i) {
+						if (burst[i] == &p)
+							return;
+					}
+
+					// write value according to lsb of next sequenceCounter
+					int a = p.index * 10 + 5 * ((getSequenceCounter(p.index) + 1) & 1);
+					if (count == 0)
+						address = a;
+					else if (a != address + count * 5)
+						return;
+					int sequenceCounter = nextSequenceCounter(p.index);
+					setSlot(buffer + 3 + count * 5, sequenceCounter, p.size, p.data);
+					burst[count++] = &p;
+					extended = true;
+				});
+			} while (extended);
+
+			// write all collected slots in one burst
+			buffer[0] = FERAM_WRITE;
+			buffer[1] = address >> 8;
+			buffer[2] = address;
+			co_await this->spi.transfer(3 + count * 5, buffer, 0, nullptr);
+
+			// resume coroutines that wait for the write operations
+			this->writeWaitlist.resumeAll([&burst, count](WriteParameters &p) {
+				for (int i = 0; i < count; ++i) {
+					if (burst[i] == &p) {
+						*p.status = Status::OK;
+						return true;
+					}
+				}
+				return false;
 			});
 		}
 	}
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <Storage.hpp>
 #include <SpiMaster.hpp>
 
@@ -13,13 +15,23 @@ public:
 	Status readBlocking(int id, int &size, void *data) override;
 	Status writeBlocking(int id, int size, void const *data) override;
 	Status clearBlocking() override;
+	void visitBlocking(int prefix, int mask, Visitor const &visitor) override;
 
 protected:
+	// maximum number of elements that get read or written in one SPI transfer
+	static constexpr int BURST_COUNT = 16;
+
 	Coroutine reader();
 	Coroutine writer();
 
 	Status readBuffer(int &size, void *data, int index, uint8_t const *buffer);
 
+	int getSequenceCounter(int index) {
+		uint8_t sc = this->sequenceCounters[index >> 2];
+		int pos = (index & 3) * 2;
+		return (sc >> pos) & 3;
+	}
+
 	void setSequenceCounter(int index, int counter) {
 		uint8_t &sc = this->sequenceCounters[index >> 2];
 		int pos = (index & 3) * 2;
@@ -46,6 +58,11 @@ protected:
 
 	int maxId;
 	uint8_t *sequenceCounters;
+
+	// read-ahead buffer for blocking reads of consecutive elements, e.g. when all counters get loaded on startup
+	int readAheadIndex = 0;
+	int readAheadCount = 0;
+	uint8_t readAheadBuffer[4 + BURST_COUNT * 10];
 };
 
 /**
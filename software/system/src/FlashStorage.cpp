@@ -228,6 +228,62 @@ Storage::Status FlashStorage::clearBlocking() {
 
 }
 
+void FlashStorage::visitBlocking(int prefix, int mask, Visitor const &visitor) {
+	int range = (~mask & 0xffff) + 1;
+	if (range > MAX_VISIT_RANGE) {
+		assert(false);
+		return;
+	}
+
+	// flags for ids that were already visited, only the newest entry of an id is valid
+	uint32_t visited[MAX_VISIT_RANGE / 32];
+	array::fill(visited, 0);
+
+	int sectorIndex = this->sectorIndex;
+	int sector = sectorIndex * this->info.sectorSize;
+	int entryOffset = this->entryWriteOffset - this->entrySize;
+	int dataOffset = this->info.sectorSize;
+
+	// iterate over sectors from newest to oldest
+	int i = 0;
+	while (true) {
+		// iterate over entries from newest to oldest
+		while (entryOffset > 0) {
+			Entry entry;
+			this->flash.readBlocking(sector + entryOffset, sizeof(entry), &entry);
+
+			// check if entry is valid and matches the prefix
+			if (isEntryValid(entryOffset, dataOffset, entry) && (entry.id & mask) == prefix) {
+				// check if the id was already visited
+				int index = entry.id & ~mask & 0xffff;
+				uint32_t flag = 1 << (index & 31);
+				if ((visited[index >> 5] & flag) == 0) {
+					visited[index >> 5] |= flag;
+
+					// visit if not erased
+					if (entry.size > 0) {
+						void *data = visitor(entry.id, entry.size);
+						if (data != nullptr)
+							this->flash.readBlocking(sector + entry.offset, entry.size, data);
+					}
+				}
+			}
+			entryOffset -= this->entrySize;
+		}
+
+		++i;
+		if (i == this->info.sectorCount - 1)
+			break;
+
+		// go to previous sector
+		sectorIndex = sectorIndex == 0 ? info.sectorCount - 1 : sectorIndex - 1;
+		sector = sectorIndex * this->info.sectorSize;
+
+		// get offset of last entry in allocation table
+		entryOffset = getLastEntry(sector);
+	}
+}
+
 FlashStorage::SectorState FlashStorage::detectSectorState(int sectorIndex) {
 	int sector = sectorIndex * this->info.sectorSize;
 
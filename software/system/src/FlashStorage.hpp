@@ -22,6 +22,7 @@ public:
 	Status readBlocking(int id, int &size, void *data) override;
 	Status writeBlocking(int id, int size, const void *data) override;
 	Status clearBlocking() override;
+	void visitBlocking(int prefix, int mask, Visitor const &visitor) override;
 
 	// allocation table entry
 	union Entry {
@@ -46,6 +47,9 @@ public:
 protected:
 	static constexpr int BUFFER_SIZE = 32;
 
+	// maximum number of ids in the range given by the mask of visitBlocking()
+	static constexpr int MAX_VISIT_RANGE = 4096;
+
 	enum SectorState {
 		EMPTY,
 		OPEN,
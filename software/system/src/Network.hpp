@@ -1,5 +1,6 @@
 #pragma once
 
+#include "PacketPool.hpp"
 #include <String.hpp>
 #include <Coroutine.hpp>
 
@@ -44,6 +45,12 @@ struct ReceiveParameters {
 	void *data;
 };
 
+// Internal helper: Stores the receive parameters and a reference to the packet buffer in the awaitable during co_await
+struct ReceiveBufferParameters {
+	Endpoint* source;
+	PacketBuffer *packet;
+};
+
 // Internal helper: Stores the send parameters in the awaitable during co_await
 struct SendParameters {
 	Endpoint const *destination;
@@ -89,6 +96,16 @@ void close(int index);
  */
 Awaitable<ReceiveParameters> receive(int index, Endpoint& source, int &length, void *data);
 
+/**
+ * Receive data on a UDP socket into a buffer of the packet pool. Data that does not fit into PACKET_POOL_SIZE gets
+ * truncated, the packet is invalid if the pool is exhausted or the socket gets closed
+ * @param index context index
+ * @param source source of received data
+ * @param packet received data, getLength() is the number of bytes received
+ * @return use co_await on return value to await received data
+ */
+Awaitable<ReceiveBufferParameters> receive(int index, Endpoint& source, PacketBuffer &packet);
+
 /**
  * Send data on a UDP socket
  * @param index context index (number of contexts defined by NETWORK_CONTEXT_COUNT in sysConfig.hpp)
@@ -0,0 +1,82 @@
+#include "PacketPool.hpp"
+#include <boardConfig.hpp>
+#include <assert.hpp>
+#include <util.hpp>
+
+
+namespace PacketPool {
+
+Buffer buffers[PACKET_POOL_COUNT];
+uint8_t data[PACKET_POOL_COUNT][PACKET_POOL_SIZE];
+Buffer *freeList = nullptr;
+bool inited = false;
+int freeCount;
+int failCount = 0;
+
+// build the free list on first use so that no init() call is necessary
+static void init() {
+	for (int i = 0; i < PACKET_POOL_COUNT; ++i) {
+		auto &buffer = PacketPool::buffers[i];
+		buffer.data = PacketPool::data[i];
+		buffer.next = PacketPool::freeList;
+		PacketPool::freeList = &buffer;
+	}
+	PacketPool::freeCount = PACKET_POOL_COUNT;
+	PacketPool::inited = true;
+}
+
+Buffer *allocate() {
+	if (!PacketPool::inited)
+		init();
+
+	Buffer *buffer = PacketPool::freeList;
+	if (buffer == nullptr) {
+		++PacketPool::failCount;
+		return nullptr;
+	}
+	PacketPool::freeList = buffer->next;
+	--PacketPool::freeCount;
+
+	buffer->useCount = 1;
+	buffer->length = 0;
+	return buffer;
+}
+
+void release(Buffer *buffer) {
+	assert(buffer->useCount > 0);
+	if (--buffer->useCount == 0) {
+		buffer->next = PacketPool::freeList;
+		PacketPool::freeList = buffer;
+		++PacketPool::freeCount;
+	}
+}
+
+int getSize() {
+	return PACKET_POOL_SIZE;
+}
+
+int getFreeCount() {
+	return PacketPool::inited ? PacketPool::freeCount : PACKET_POOL_COUNT;
+}
+
+int getFailCount() {
+	return PacketPool::failCount;
+}
+
+} // namespace PacketPool
+
+
+bool PacketBuffer::makeWritable() {
+	if (!isShared())
+		return true;
+
+	// copy to a new buffer and release the shared buffer
+	auto buffer = PacketPool::allocate();
+	if (buffer == nullptr)
+		return false;
+	buffer->length = this->buffer->length;
+	array::copy(this->buffer->length, buffer->data, this->buffer->data);
+	PacketPool::release(this->buffer);
+	this->buffer = buffer;
+	return true;
+}
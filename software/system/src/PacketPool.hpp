@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+
+
+/*
+	Pool of reference counted packet buffers that is shared by the drivers (Radio, BusMaster, Network). A driver
+	receives a packet into a buffer of the pool and passes references to the receiving coroutines without copying.
+	Packets that arrive while no coroutine is waiting are kept by the driver in a small backlog per receiver (radio
+	context, bus) as long as the pool has free buffers, therefore short bursts are not lost while a slow receiver can't
+	hold the whole pool and starve the other receivers.
+
+	The pool is not interrupt safe, use it only from the event loop. This header does not depend on boardConfig.hpp
+	so that driver headers which get included by boardConfig.hpp can use it.
+
+	Config:
+		PACKET_POOL_COUNT: number of buffers in the pool
+		PACKET_POOL_SIZE: size of a buffer in bytes, at least the size of a Radio::Packet if the radio is used
+*/
+namespace PacketPool {
+
+// maximum number of packets a driver keeps per receiver while no coroutine is waiting
+constexpr int BACKLOG_COUNT = 2;
+
+struct Buffer {
+	// next free buffer while in the pool
+	Buffer *next;
+
+	// number of references
+	uint16_t useCount;
+
+	// length of the data
+	uint16_t length;
+
+	// data of PACKET_POOL_SIZE bytes
+	uint8_t *data;
+};
+
+/**
+ * Allocate a buffer from the pool
+ * @return buffer with a use count of one or nullptr if the pool is exhausted
+ */
+Buffer *allocate();
+
+/**
+ * Release a reference to a buffer, the buffer returns to the pool when the use count reaches zero
+ * @param buffer buffer, must not be nullptr
+ */
+void release(Buffer *buffer);
+
+/**
+ * Get the size of a buffer
+ * @return size of a buffer in bytes (PACKET_POOL_SIZE)
+ */
+int getSize();
+
+/**
+ * Get the number of free buffers, e.g. for diagnostics
+ * @return number of free buffers
+ */
+int getFreeCount();
+
+/**
+ * Get the number of failed allocations since start, e.g. for diagnostics
+ * @return number of failed allocations
+ */
+int getFailCount();
+
+} // namespace PacketPool
+
+
+/**
+ * Shared reference to a buffer of the packet pool. The buffer returns to the pool when the last reference is
+ * destroyed. Receivers that modify the data in-place (e.g. decryption) should call makeWritable() first
+ */
+class PacketBuffer {
+public:
+	PacketBuffer() = default;
+
+	PacketBuffer(PacketBuffer const &packet) : buffer(packet.buffer) {
+		if (this->buffer != nullptr)
+			++this->buffer->useCount;
+	}
+
+	PacketBuffer(PacketBuffer &&packet) noexcept : buffer(packet.buffer) {
+		packet.buffer = nullptr;
+	}
+
+	~PacketBuffer() {
+		if (this->buffer != nullptr)
+			PacketPool::release(this->buffer);
+	}
+
+	PacketBuffer &operator =(PacketBuffer const &packet) {
+		if (packet.buffer != nullptr)
+			++packet.buffer->useCount;
+		if (this->buffer != nullptr)
+			PacketPool::release(this->buffer);
+		this->buffer = packet.buffer;
+		return *this;
+	}
+
+	PacketBuffer &operator =(PacketBuffer &&packet) noexcept {
+		if (this != &packet) {
+			if (this->buffer != nullptr)
+				PacketPool::release(this->buffer);
+			this->buffer = packet.buffer;
+			packet.buffer = nullptr;
+		}
+		return *this;
+	}
+
+	/**
+	 * Release the current buffer and allocate a new buffer from the pool
+	 * @return true on success, false if the pool is exhausted
+	 */
+	bool allocate() {
+		reset();
+		this->buffer = PacketPool::allocate();
+		return this->buffer != nullptr;
+	}
+
+	/**
+	 * Release the buffer
+	 */
+	void reset() {
+		if (this->buffer != nullptr) {
+			PacketPool::release(this->buffer);
+			this->buffer = nullptr;
+		}
+	}
+
+	/**
+	 * Check if a buffer is referenced
+	 * @return true if valid
+	 */
+	bool isValid() const {return this->buffer != nullptr;}
+
+	/**
+	 * Check if the buffer is shared with other references
+	 * @return true if shared
+	 */
+	bool isShared() const {return this->buffer != nullptr && this->buffer->useCount > 1;}
+
+	/**
+	 * Copy the buffer if it is shared so that the data can be modified
+	 * @return true on success, false if a copy is needed but the pool is exhausted
+	 */
+	bool makeWritable();
+
+	uint8_t *data() {return this->buffer->data;}
+	uint8_t const *data() const {return this->buffer->data;}
+
+	int getLength() const {return this->buffer->length;}
+	void setLength(int length) {this->buffer->length = length;}
+
+protected:
+	PacketPool::Buffer *buffer = nullptr;
+};
@@ -0,0 +1,38 @@
+#include "PersistentCounter.hpp"
+
+
+void PersistentCounter::loadBlocking() {
+	// resume from the stored upper bound
+	int size = 4;
+	this->storage.readBlocking(this->id, size, &this->value);
+	if (size != 4)
+		this->value = 0;
+
+	// reserve first window
+	this->bound = this->value + this->window;
+	this->storage.writeBlocking(this->id, 4, &this->bound);
+}
+
+Awaitable<Storage::WriteParameters> PersistentCounter::store(Storage::Status &status) {
+	if (!advance()) {
+		status = Storage::Status::OK;
+		return {};
+	}
+	return this->storage.write(this->id, 4, &this->bound, status);
+}
+
+Storage::Status PersistentCounter::storeBlocking() {
+	if (!advance())
+		return Storage::Status::OK;
+	return this->storage.writeBlocking(this->id, 4, &this->bound);
+}
+
+bool PersistentCounter::advance() {
+	// values below the bound can be used without writing to the storage
+	if (this->value < this->bound)
+		return false;
+
+	// reserve next window
+	this->bound = this->value + this->window;
+	return true;
+}
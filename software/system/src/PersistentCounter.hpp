@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Storage.hpp"
+
+
+/**
+ * Security counter that is persisted in a storage using a reserved window. Instead of the counter itself an upper
+ * bound is stored which gets advanced by the window size when the counter reaches it. After reboot the counter resumes
+ * from the stored bound, therefore no counter value gets used twice while only every window-th increment is written.
+ * Use only for counters that get incremented locally, e.g. for sending, not for counters received from other devices.
+ */
+class PersistentCounter {
+public:
+	/**
+	 * Constructor
+	 * @param storage storage for the upper bound
+	 * @param id id of the upper bound in the storage
+	 * @param window number of increments between two writes to the storage
+	 */
+	PersistentCounter(Storage &storage, int id, uint32_t window = 64)
+		: storage(storage), id(id), window(window) {}
+
+	/**
+	 * Load the counter on startup and reserve the first window
+	 */
+	void loadBlocking();
+
+	/**
+	 * Store the upper bound if the counter has reached it
+	 * @param status status of operation
+	 * @return use co_await on return value to await completion
+	 */
+	[[nodiscard]] Awaitable<Storage::WriteParameters> store(Storage::Status &status);
+
+	/**
+	 * Store the upper bound if the counter has reached it
+	 * @return status of operation
+	 */
+	Storage::Status storeBlocking();
+
+	operator uint32_t() const {return this->value;}
+	uint32_t operator ++() {return ++this->value;}
+	uint32_t operator ++(int) {return this->value++;}
+
+protected:
+	// check if the bound needs to be advanced
+	bool advance();
+
+	Storage &storage;
+	int id;
+	uint32_t window;
+
+	// current value of the counter, all values below were possibly used
+	uint32_t value = 0;
+
+	// upper bound of the counter that is stored in the storage
+	uint32_t bound = 0;
+};
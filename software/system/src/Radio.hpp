@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RadioDefs.hpp"
+#include "PacketPool.hpp"
 #include <Coroutine.hpp>
 #include <functional>
 #include <boardConfig.hpp>
@@ -31,6 +32,8 @@ constexpr int SEND_EXTRA_LENGTH = 1;
  */
 using Packet = uint8_t[1 + RADIO_MAX_PAYLOAD_LENGTH + RECEIVE_EXTRA_LENGTH];
 
+static_assert(PACKET_POOL_SIZE >= sizeof(Packet), "buffers of packet pool must be able to hold a radio packet");
+
 /*
 // Internal helper: Stores the receive parameters and a reference to the result value in the awaitable during co_await
 struct ReceiveParameters : public WaitlistElement {
@@ -70,6 +73,7 @@ struct SendParameters : public WaitlistElement {
 // Internal helper: Stores the receive parameters and a reference to the result value in the awaitable during co_await
 class ReceiveParameters : public WaitlistNode {
 public:
+	ReceiveParameters() = default;
 	explicit ReceiveParameters(Packet &packet) : packet(packet) {}
 	//~ReceiveParameters() {if (isInList()) cancel();}
 
@@ -79,7 +83,22 @@ public:
 	// handle of waiting coroutine
 	std::coroutine_handle<> handle = nullptr;
 
-	Packet &packet;
+	uint8_t *packet = nullptr;
+};
+
+// Internal helper: Stores the reference to the packet buffer in the awaitable during co_await
+class ReceiveBufferParameters : public WaitlistNode {
+public:
+	ReceiveBufferParameters() = default;
+	explicit ReceiveBufferParameters(PacketBuffer &packet) : packet(&packet) {}
+
+	void append(WaitlistNode &list) noexcept;
+	void cancel() noexcept;
+
+	// handle of waiting coroutine
+	std::coroutine_handle<> handle = nullptr;
+
+	PacketBuffer *packet = nullptr;
 };
 
 // Internal helper: Stores the send parameters in the awaitable during co_await
@@ -169,6 +188,16 @@ void setFlags(int index, ContextFlags flags);
  */
 [[nodiscard]] Awaitable<ReceiveParameters> receive(int index, Packet &packet);
 
+/**
+ * Receive data using the radio receiver without copying. The packet is in a buffer of the packet pool that may be
+ * shared with other contexts, use makeWritable() before modifying it. Packets that arrive while no coroutine is
+ * waiting are kept for the next call to receive() as long as the packet pool has free buffers
+ * @param index context index (number of contexts defined by RADIO_CONTEXT_COUNT in sysConfig.hpp)
+ * @param packet received packet in the same format as Packet
+ * @return use co_await on return value to await a packet
+ */
+[[nodiscard]] Awaitable<ReceiveBufferParameters> receive(int index, PacketBuffer &packet);
+
 /**
  * Send data over the air using the radio transmitter
  * @param index context index (number of contexts defined by RADIO_CONTEXT_COUNT in sysConfig.hpp)
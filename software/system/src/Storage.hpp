@@ -2,6 +2,7 @@
 
 #include <Coroutine.hpp>
 #include <cstdint>
+#include <functional>
 
 
 /**
@@ -49,6 +50,12 @@ public:
 		Status *status;
 	};
 
+	/**
+	 * Visitor for visitBlocking(), gets called with id and size of an element and returns the buffer where the data of
+	 * the element gets read into or nullptr to skip the data
+	 */
+	using Visitor = std::function<void *(int id, int size)>;
+
 
 	virtual ~Storage();
 
@@ -104,6 +111,15 @@ public:
 	 */
 	virtual Status clearBlocking() = 0;
 
+	/**
+	 * Visit all elements whose id matches a prefix in one pass over the storage. Each element is visited once with its
+	 * current data, erased elements are skipped
+	 * @param prefix prefix of the ids, e.g. 0x1000
+	 * @param mask mask of the id bits that have to be equal to the prefix, e.g. 0xf000
+	 * @param visitor visitor that gets called for each element
+	 */
+	virtual void visitBlocking(int prefix, int mask, Visitor const &visitor) = 0;
+
 
 	/**
 	 * Get size of an element
@@ -4,7 +4,7 @@
 
 
 /**
- * System duration, internal unit is 1/1024 second
+ * System duration, internal unit is 1 millisecond
  */
 struct SystemDuration {
 	int32_t value;
@@ -122,7 +122,7 @@ constexpr SystemDuration min(SystemDuration x, SystemDuration y) {return {x.valu
 
 
 /**
- * System time, internal unit is 1/1024 second
+ * System time, internal unit is 1 millisecond
  */
 struct SystemTime {
 	uint32_t value;
@@ -13,7 +13,7 @@ namespace Timer {
 void init();
 
 /**
- * Get current time in 1/1024 seconds
+ * Get current time in milliseconds
  * @return current time
  */
 SystemTime now();
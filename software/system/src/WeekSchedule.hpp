@@ -0,0 +1,109 @@
+#pragma once
+
+#include "ClockTime.hpp"
+#include <util.hpp>
+
+
+/*
+	Schedule of events that repeat every week, e.g. alarms. An entry consists of the time in seconds since start of the
+	week and an 8 bit id. The entries are kept sorted by time so that the next entry can be found by binary search.
+*/
+template <int N>
+class WeekSchedule {
+public:
+	static constexpr int WEEK = ClockTime::SECONDS_PER_WEEK;
+
+	// number of seconds the wall clock may jump forward in addition to the elapsed time, entries that are due in
+	// between still go off (e.g. start of daylight saving time)
+	static constexpr int MAX_CATCH_UP = 60 * 60;
+
+	void clear() {this->count = 0;}
+
+	bool isEmpty() const {return this->count == 0;}
+
+	int size() const {return this->count;}
+
+	/**
+	 * Add an entry using insertion sort, gets ignored when the schedule is full
+	 * @param weekSeconds time of the entry in seconds since start of week
+	 * @param id id of the entry
+	 */
+	void add(int weekSeconds, uint8_t id) {
+		if (this->count >= N)
+			return;
+		uint32_t entry = uint32_t(weekSeconds) << 8 | id;
+		int i = this->count;
+		while (i > 0 && this->entries[i - 1] > entry) {
+			this->entries[i] = this->entries[i - 1];
+			--i;
+		}
+		this->entries[i] = entry;
+		++this->count;
+	}
+
+	/**
+	 * Get index of the first entry that goes off after the given time, wraps around to 0
+	 * @param weekSeconds time in seconds since start of week
+	 * @return index of entry
+	 */
+	int getNextIndex(int weekSeconds) const {
+		uint32_t key = uint32_t(weekSeconds) << 8 | 0xff;
+		int index = array::binaryLowerBound(this->count, this->entries,
+			[key](uint32_t entry) {return entry <= key;});
+		return index < this->count && this->entries[index] > key ? index : 0;
+	}
+
+	/**
+	 * Get the time until the next entry goes off, schedule must not be empty
+	 * @param weekSeconds time in seconds since start of week
+	 * @return delay in seconds, range 1 - WEEK
+	 */
+	int getDelay(int weekSeconds) const {
+		int delay = int(this->entries[getNextIndex(weekSeconds)] >> 8) - weekSeconds;
+		return delay <= 0 ? delay + WEEK : delay;
+	}
+
+	/**
+	 * Get the span after the last check in which entries are due. The wall clock may have been adjusted in the
+	 * meantime, therefore the span is compared to the elapsed time of a monotonic clock: When the clock jumped back
+	 * over the last check, nothing is due to prevent entries from going off twice. When it jumped forward by more than
+	 * MAX_CATCH_UP, nothing is due as the clock was probably set for the first time.
+	 * @param checked time up to which the entries were handled in seconds since start of week
+	 * @param now current time in seconds since start of week
+	 * @param elapsed time elapsed since the last check in seconds, measured with a monotonic clock
+	 * @return span in seconds, range 0 - elapsed + MAX_CATCH_UP
+	 */
+	static int getDueSpan(int checked, int now, int elapsed) {
+		int span = (now - checked + WEEK) % WEEK;
+
+		// add full weeks, e.g. a single entry goes off once per week
+		span += (elapsed - span + WEEK / 2) / WEEK * WEEK;
+		return span <= elapsed + MAX_CATCH_UP ? span : 0;
+	}
+
+	/**
+	 * Call a function for each entry that goes off in the time interval (from, from + span]
+	 * @param from start of interval in seconds since start of week
+	 * @param span length of interval in seconds
+	 * @param function function that gets called with the id of each entry
+	 */
+	template <typename F>
+	void forEachDue(int from, int span, F const &function) const {
+		int index = getNextIndex(from);
+		for (int i = 0; i < this->count; ++i) {
+			uint32_t entry = this->entries[(index + i) % this->count];
+			int d = int(entry >> 8) - from;
+			if (d <= 0)
+				d += WEEK;
+			if (d > span)
+				break;
+			function(uint8_t(entry));
+		}
+	}
+
+protected:
+
+	// entries sorted by time, entry is seconds since start of week << 8 | id
+	int count = 0;
+	uint32_t entries[N];
+};
@@ -5,6 +5,7 @@
 #include <util.hpp>
 #include <emu/Gui.hpp>
 #include <emu/Loop.hpp>
+#include <boardConfig.hpp>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -79,9 +80,30 @@ BusMasterImpl::BusMasterImpl() : file("busMaster.bin", File::Mode::READ_WRITE) {
 }
 
 Awaitable<BusMaster::ReceiveParameters> BusMasterImpl::receive(int &length, uint8_t *data) {
+	// take message that was received while no coroutine was waiting
+	if (!this->receiveBacklog.isEmpty()) {
+		auto &buffer = this->receiveBacklog.getFront();
+		length = min(length, buffer.getLength());
+		array::copy(length, data, buffer.data());
+		buffer.reset();
+		this->receiveBacklog.removeFront();
+		return {};
+	}
+
 	return {this->receiveWaitlist, &length, data};
 }
 
+Awaitable<BusMaster::ReceiveBufferParameters> BusMasterImpl::receive(PacketBuffer &packet) {
+	// take message that was received while no coroutine was waiting
+	if (!this->receiveBacklog.isEmpty()) {
+		packet = std::move(this->receiveBacklog.getFront());
+		this->receiveBacklog.removeFront();
+		return {};
+	}
+
+	return {this->receiveBufferWaitlist, &packet};
+}
+
 Awaitable<BusMaster::SendParameters> BusMasterImpl::send(int length, uint8_t const *data) {
 	return {this->sendWaitlist, length, data};
 }
@@ -284,13 +306,7 @@ void BusMasterImpl::handle(Gui &gui) {
 			w.encrypt(micLength, nonce, bus::defaultAesKey);
 
 			// send to bus master (resume coroutine waiting to receive from device)
-			int sendLength = w.getLength();
-			this->receiveWaitlist.resumeFirst([sendLength, sendData](ReceiveParameters &p) {
-				int length = min(*p.length, sendLength);
-				array::copy(length, p.data, sendData);
-				*p.length = length;
-				return true;
-			});
+			pass(w.getLength(), sendData);
 		}
 
 		// add device endpoints to gui if device is commissioned
@@ -408,12 +424,39 @@ void BusMasterImpl::sendToMaster(bus::MessageWriter &w, Device &device) {
 	this->file.write(device.offset + offsetOf(PersistentState, securityCounter), 4, &device.persistentState.securityCounter);
 
 	// send to bus master (resume coroutine waiting to receive from device)
-	int length = w.getLength();
-	auto data = w.begin;
-	this->receiveWaitlist.resumeFirst([length, data](ReceiveParameters &p) {
-		int len = min(*p.length, length);
-		array::copy(len, p.data, data);
-		*p.length = len;
-		return true;
-	});
+	pass(w.getLength(), w.begin);
+}
+
+void BusMasterImpl::pass(int length, uint8_t const *data) {
+	// coroutines that receive into their own buffer get a copy
+	if (!this->receiveWaitlist.isEmpty()) {
+		this->receiveWaitlist.resumeFirst([length, data](ReceiveParameters &p) {
+			int len = min(*p.length, length);
+			array::copy(len, p.data, data);
+			*p.length = len;
+			return true;
+		});
+		return;
+	}
+
+	// copy into a buffer of the packet pool
+	PacketBuffer packet;
+	if (!packet.allocate())
+		return;
+	int len = min(length, PACKET_POOL_SIZE);
+	array::copy(len, packet.data(), data);
+	packet.setLength(len);
+
+	// coroutines that receive into a pool buffer get the packet
+	if (!this->receiveBufferWaitlist.isEmpty()) {
+		this->receiveBufferWaitlist.resumeFirst([&packet](ReceiveBufferParameters &p) {
+			*p.packet = packet;
+			return true;
+		});
+		return;
+	}
+
+	// keep message if the backlog is not full and the packet pool is not exhausted
+	if (!this->receiveBacklog.isFull() && PacketPool::getFreeCount() > 0)
+		this->receiveBacklog.addBack(packet);
 }
@@ -4,6 +4,7 @@
 #include "Loop.hpp"
 #include "../posix/File.hpp"
 #include <bus.hpp>
+#include <Queue.hpp>
 #include <chrono>
 
 
@@ -15,6 +16,7 @@ public:
 	BusMasterImpl();
 
 	Awaitable<ReceiveParameters> receive(int &length, uint8_t *data) override;
+	Awaitable<ReceiveBufferParameters> receive(PacketBuffer &packet) override;
 	Awaitable<SendParameters> send(int length, uint8_t const *data) override;
 
 	void handle(Gui &gui) override;
@@ -58,11 +60,14 @@ public:
 protected:
 	void setHeader(bus::MessageWriter &w, Device &device);
 	void sendToMaster(bus::MessageWriter &w, Device &device);
+	void pass(int length, uint8_t const *data);
 
 	File file;
 
 	std::chrono::steady_clock::time_point time;
 
 	Waitlist<ReceiveParameters> receiveWaitlist;
+	Waitlist<ReceiveBufferParameters> receiveBufferWaitlist;
+	Queue<PacketBuffer, PacketPool::BACKLOG_COUNT> receiveBacklog; // messages received while no coroutine was waiting
 	Waitlist<SendParameters> sendWaitlist;
 };
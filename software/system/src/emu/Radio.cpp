@@ -1,4 +1,5 @@
 #include "../Radio.hpp"
+#include "RadioMedium.hpp"
 #include "StringOperators.hpp"
 #include <usb.hpp>
 #include <emu/Loop.hpp>
@@ -10,7 +11,11 @@
 #include <Queue.hpp>
 #include <boardConfig.hpp>
 #include <libusb.h>
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
 
 
 namespace Radio {
@@ -25,6 +30,23 @@ int channel;
 libusb_device_handle *device = nullptr;
 
 
+// simulated medium, used when no radio is connected via USB
+// ---------------------------------------------------------
+// configured by environment variables, e.g. RADIO_LIGHTS=100 RADIO_SWITCHES=10 RADIO_LOSS=0.1 to test RadioInterface
+// with many devices on a lossy medium, or RADIO_REPLAY=input.pcap (and RADIO_REPLAY_CHANNEL=15) to replay a capture
+
+// get an environment variable as number
+static double getNumber(char const *name, double defaultValue) {
+	char const *value = getenv(name);
+	return value != nullptr ? atof(value) : defaultValue;
+}
+
+std::chrono::steady_clock::time_point startTime;
+bool receiverEnabled = false;
+std::vector<std::unique_ptr<RadioMedium::Node>> simulatedNodes;
+RadioMedium::PcapReplay pcapReplay;
+
+
 // context
 // -------
 
@@ -40,9 +62,12 @@ struct Context {
 
 	// receive
 	Waitlist<ReceiveParameters> receiveWaitlist;
+	Waitlist<ReceiveBufferParameters> receiveBufferWaitlist;
+	Queue<PacketBuffer, PacketPool::BACKLOG_COUNT> receiveBacklog; // packets received while no coroutine was waiting
 	libusb_transfer *receiveTransfer;
 	uint8_t receiveBuffer[sizeof(Radio::Packet) - 1];
 	void startReceive();
+	void pass(PacketBuffer const &packet);
 
 	// send
 	Waitlist<SendParameters> sendWaitlist;
@@ -136,14 +161,15 @@ void onReceived(libusb_transfer *transfer) {
 		});
 	} else if (length >= 2 + Radio::RECEIVE_EXTRA_LENGTH) {
 		// got a receive packet
-
-		// resume first waiting coroutine
-		context.receiveWaitlist.resumeFirst([length, buffer](ReceiveParameters &p) {
+		PacketBuffer packet;
+		if (packet.allocate()) {
 			// convert to radio format where first byte is length of payload and crc, but no extra data
-			p.packet[0] = length - Radio::RECEIVE_EXTRA_LENGTH + 2;
-			array::copy(length, p.packet + 1, buffer);
-			return true;
-		});
+			uint8_t *data = packet.data();
+			data[0] = length - Radio::RECEIVE_EXTRA_LENGTH + 2;
+			array::copy(length, data + 1, buffer);
+			packet.setLength(1 + length);
+			context.pass(packet);
+		}
 	}
 
 	// wait for next packet
@@ -157,21 +183,94 @@ void Context::startReceive() {
 	libusb_submit_transfer(this->receiveTransfer);
 }
 
+// pass a received packet to the first waiting coroutine or keep it until receive() gets called
+void Context::pass(PacketBuffer const &packet) {
+	// coroutines that receive into a pool buffer share the packet
+	if (!this->receiveBufferWaitlist.isEmpty()) {
+		this->receiveBufferWaitlist.resumeFirst([&packet](ReceiveBufferParameters &p) {
+			*p.packet = packet;
+			return true;
+		});
+		return;
+	}
+
+	// coroutines that receive into their own buffer get a copy
+	if (!this->receiveWaitlist.isEmpty()) {
+		this->receiveWaitlist.resumeFirst([&packet](ReceiveParameters &p) {
+			array::copy(packet.getLength(), p.packet, packet.data());
+			return true;
+		});
+		return;
+	}
+
+	// keep packet if the backlog of the context is not full and the packet pool is not exhausted
+	if (!this->receiveBacklog.isFull() && PacketPool::getFreeCount() > 0)
+		this->receiveBacklog.addBack(packet);
+}
+
 // let the emulated radio receive some data
 void receiveData(uint8_t *packet) {
+	// length without crc but with extra data
+	int length = packet[0] - 2 + Radio::RECEIVE_EXTRA_LENGTH;
+
+	// copy once into a buffer of the packet pool that is shared by all contexts
+	PacketBuffer buffer;
 	for (auto &context : Radio::contexts) {
 		if (context.filter(packet)) {
-			// resume first waiting coroutine
-			context.receiveWaitlist.resumeFirst([packet](ReceiveParameters &p) {
-				// length without crc but with extra data
-				int length = packet[0] - 2 + Radio::RECEIVE_EXTRA_LENGTH;
-				array::copy(1 + length, p.packet, packet);
-				return true;
-			});
+			if (!buffer.isValid()) {
+				if (!buffer.allocate())
+					return;
+				array::copy(1 + length, buffer.data(), packet);
+				buffer.setLength(1 + length);
+			}
+			context.pass(buffer);
 		}
 	}
 }
 
+// the emulated radio as node on the simulated medium
+class RadioNode : public RadioMedium::Node {
+public:
+	void receive(uint8_t const *mac, int length, uint8_t lqi) override {
+		if (!Radio::receiverEnabled)
+			return;
+
+		// convert to radio format where first byte is length of payload and crc, followed by lqi and timestamp
+		uint8_t packet[1 + RadioMedium::MAX_FRAME_LENGTH + Radio::RECEIVE_EXTRA_LENGTH];
+		packet[0] = length + 2;
+		array::copy(length, packet + 1, mac);
+		uint8_t *extra = packet + 1 + length;
+		uint32_t timestamp = uint32_t(RadioMedium::now());
+		extra[0] = lqi;
+		extra[1] = uint8_t(timestamp);
+		extra[2] = uint8_t(timestamp >> 8);
+		extra[3] = uint8_t(timestamp >> 16);
+		extra[4] = uint8_t(timestamp >> 24);
+		Radio::receiveData(packet);
+	}
+
+	bool acknowledge(uint8_t const *mac, int length) override {
+		if (!Radio::receiverEnabled)
+			return false;
+
+		// acknowledge if a context that handles ACKs accepts the frame (filter() expects the length byte before mac)
+		for (auto &context : Radio::contexts) {
+			ContextFlags flags = context.flags;
+			if ((flags & ContextFlags::HANDLE_ACK) != 0 && context.filter(mac - 1)) {
+				auto frameControl = ieee::FrameControl(mac[0] | (mac[1] << 8));
+				if ((frameControl & ieee::FrameControl::DESTINATION_ADDRESSING_LONG_FLAG) != 0
+					|| (mac[5] | (mac[6] << 8)) != 0xffff)
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+};
+
+RadioNode radioNode;
+
 
 // send
 // ----
@@ -259,9 +358,8 @@ GreenPowerDeviceData const deviceData[1] = {{
 }};
 
 
-// read from pcap file
-// -------------------
-FILE *pcapIn = nullptr;
+// write to pcap file
+// ------------------
 FILE *pcapOut = nullptr;
 
 /*
@@ -286,6 +384,14 @@ void ReceiveParameters::cancel() noexcept {
 	remove();
 }
 
+void ReceiveBufferParameters::append(WaitlistNode &list) noexcept {
+	list.add(*this);
+}
+
+void ReceiveBufferParameters::cancel() noexcept {
+	remove();
+}
+
 /*
 SendParameters::SendParameters(SendParameters &&p) noexcept
 	: WaitlistElement(std::move(p)), packet(p.packet), result(p.result)
@@ -350,6 +456,12 @@ void SendParameters::cancel() noexcept {
 // event loop handler chain
 Loop::Handler nextHandler = nullptr;
 void handle(Gui &gui) {
+	// advance the simulated medium in real time
+	if (Radio::device == nullptr) {
+		auto duration = std::chrono::steady_clock::now() - Radio::startTime;
+		RadioMedium::advance(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+	}
+
 	for (int index = 0; index < RADIO_CONTEXT_COUNT; ++index) {
 		auto &context = Radio::contexts[index];
 	
@@ -449,20 +561,6 @@ void handle(Gui &gui) {
 			device.lastRocker = rocker;
 		}
 	}
-	
-	// inject packets from pcap file
-	if (Radio::pcapIn != nullptr) {
-		pcap::PacketHeader header;
-		if (fread(&header, sizeof(pcap::PacketHeader), 1, Radio::pcapIn) == 1) {
-			// read data
-			uint8_t packet[128];
-			packet[0] = header.orig_len;
-			int size = fread(packet + 1, 1, header.incl_len, Radio::pcapIn);
-			
-			// let the radio receive the packet
-			Radio::receiveData(packet);
-		}
-	}
 }
 
 int controlTransfer(libusb_device_handle *handle, Request request, uint16_t wValue, uint16_t wIndex) {
@@ -549,34 +647,34 @@ void init() {
 		setKey(device.key, d.key);
 	}
 
-
-	// open input pcap file
-	//Radio::pcapIn = fopen("input.pcap", "rb");
-	if (Radio::pcapIn != nullptr) {
-		// read pcap header
-		pcap::Header header;
-		fread(&header, sizeof(header), 1, Radio::pcapIn);
-		if (header.network != pcap::Network::IEEE802_15_4) {
-			// error: protocol not supported
-			Radio::pcapIn = nullptr;
-		}
-		
-		// skip all packets up to a given time
-		while (true) {
-			pcap::PacketHeader header;
-			if (fread(&header, sizeof(pcap::PacketHeader), 1, Radio::pcapIn) == 1) {
-				// read data
-				uint8_t packet[128];
-				packet[0] = header.orig_len;
-				fread(packet + 1, 1, header.incl_len, Radio::pcapIn);
-				
-				if (header.ts_sec >= 25)
-					break;
-			} else {
-				break;
-			}
-		}
+	// simulated medium
+	Radio::startTime = std::chrono::steady_clock::now();
+	RadioMedium::setLossRate(float(getNumber("RADIO_LOSS", 0)));
+	RadioMedium::add(Radio::radioNode);
+
+	// number of simulated devices
+	int lightCount = int(getNumber("RADIO_LIGHTS", 0));
+	int switchCount = int(getNumber("RADIO_SWITCHES", 0));
+	for (int i = 0; i < lightCount; ++i) {
+		// channel and pan get set in start() and setPan()
+		auto node = std::make_unique<RadioMedium::ZigbeeLight>(-1, 0xffff, 0x1000 + i,
+			0x00124b0000000000 + i);
+		RadioMedium::add(*node);
+		Radio::simulatedNodes.push_back(std::move(node));
 	}
+	for (int i = 0; i < switchCount; ++i) {
+		// send every 2 seconds, shifted by 100ms for each switch
+		auto node = std::make_unique<RadioMedium::GreenPowerSwitch>(-1, 0x10000000 + i, deviceData[0].key,
+			2000000 + i * 100000);
+		RadioMedium::add(*node);
+		Radio::simulatedNodes.push_back(std::move(node));
+	}
+
+	// replay a pcap file on the simulated medium
+	RadioMedium::add(Radio::pcapReplay);
+	char const *replayFile = getenv("RADIO_REPLAY");
+	if (replayFile != nullptr && !Radio::pcapReplay.open(int(getNumber("RADIO_REPLAY_CHANNEL", 15)), replayFile))
+		Terminal::err << "error: can't open pcap file " << str(replayFile) << '\n';
 
 	// open output pcap file
 	//radio::pcapOut = fopen("output.pcap", "wb");
@@ -600,16 +698,27 @@ void start(int channel) {
 
 	if (Radio::device != nullptr)
 		controlTransfer(Radio::device, Request::START, channel, 0);
+
+	// simulated devices follow the channel of the radio
+	Radio::radioNode.channel = channel;
+	for (auto &node : Radio::simulatedNodes)
+		node->channel = channel;
 }
 
 void stop() {
 	Radio::channel = -1;
+	Radio::radioNode.channel = -1;
 
 	if (Radio::device != nullptr)
 		controlTransfer(Radio::device, Request::STOP, 0, 0);
 
 	// clear queues
 	for (auto &context : Radio::contexts) {
+		// return received packets to the packet pool
+		while (!context.receiveBacklog.isEmpty()) {
+			context.receiveBacklog.getFront().reset();
+			context.receiveBacklog.removeFront();
+		}
 		/*context.receiveWaitingQueue.resumeAll([](ReceiveParameters p) {
 			// coroutines waiting for receive get a null pointer
 			p.data = nullptr;
@@ -628,12 +737,15 @@ void detectEnergy(std::function<void (uint8_t)> const &onReady) {
 }
 
 void enableReceiver(bool enable) {
+	Radio::receiverEnabled = enable;
+
 	if (Radio::device != nullptr)
 		controlTransfer(Radio::device, Request::ENABLE_RECEIVER, uint16_t(enable), 0);
 }
 
 void setLongAddress(uint64_t longAddress) {
 	Radio::longAddress = longAddress;
+	Radio::radioNode.longAddress = longAddress;
 
 	if (Radio::device != nullptr) {
 		// todo: transfer to device
@@ -651,6 +763,12 @@ void setPan(int index, uint16_t pan) {
 
 	c.pan = pan;
 
+	// simulated devices join the pan
+	if (pan != 0xffff) {
+		for (auto &node : Radio::simulatedNodes)
+			node->pan = pan;
+	}
+
 	if (Radio::device != nullptr)
 		controlTransfer(Radio::device, Request::SET_PAN, pan, index);
 }
@@ -679,9 +797,32 @@ Awaitable<ReceiveParameters> receive(int index, Packet &packet) {
 	assert(uint(index) < RADIO_CONTEXT_COUNT);
 	auto &context = Radio::contexts[index];
 
+	// take packet that was received while no coroutine was waiting
+	if (!context.receiveBacklog.isEmpty()) {
+		auto &buffer = context.receiveBacklog.getFront();
+		array::copy(buffer.getLength(), packet, buffer.data());
+		buffer.reset();
+		context.receiveBacklog.removeFront();
+		return {};
+	}
+
 	return {context.receiveWaitlist, packet};
 }
 
+Awaitable<ReceiveBufferParameters> receive(int index, PacketBuffer &packet) {
+	assert(uint(index) < RADIO_CONTEXT_COUNT);
+	auto &context = Radio::contexts[index];
+
+	// take packet that was received while no coroutine was waiting
+	if (!context.receiveBacklog.isEmpty()) {
+		packet = std::move(context.receiveBacklog.getFront());
+		context.receiveBacklog.removeFront();
+		return {};
+	}
+
+	return {context.receiveBufferWaitlist, packet};
+}
+
 Awaitable<SendParameters> send(int index, uint8_t *packet, uint8_t &result) {
 	assert(uint(index) < RADIO_CONTEXT_COUNT);
 	auto &context = Radio::contexts[index];
@@ -706,6 +847,19 @@ Awaitable<SendParameters> send(int index, uint8_t *packet, uint8_t &result) {
 			// start to send
 			context.startSend();
 		}
+	} else if (Radio::radioNode.channel != -1) {
+		// send over the simulated medium, 0xff: packet waiting to be sent
+		result = 0xff;
+		Radio::radioNode.send(packet + 1, length, [index, packet, macCounter = packet[3]](int backoffCount) {
+			// resume coroutine unless the send operation was cancelled
+			Radio::contexts[index].sendWaitlist.resumeAll([packet, macCounter, backoffCount](SendParameters &p) {
+				if (p.packet == packet && p.packet[3] == macCounter) {
+					p.result = backoffCount;
+					return true;
+				}
+				return false;
+			});
+		});
 	} else {
 		// indicate failure
 		result = 0;
@@ -0,0 +1,496 @@
+#include "RadioMedium.hpp"
+#include <ieee.hpp>
+#include <pcap.hpp>
+#include <Nonce.hpp>
+#include <util.hpp>
+#include <list>
+#include <map>
+#include <random>
+
+
+namespace RadioMedium {
+
+// little endian 32 bit integer
+#define I32L(value) uint8_t(value), uint8_t(value >> 8), uint8_t(value >> 16), uint8_t(value >> 24)
+
+// event that is processed when the time of the medium reaches the given time
+struct Event {
+	// owner of the event, events of a node get removed when the node is destroyed
+	Node *node;
+
+	std::function<void ()> function;
+};
+
+// frame on air
+struct Transmission {
+	Node *sender;
+	int channel;
+	Time end;
+	bool collided;
+	int length;
+	uint8_t mac[MAX_FRAME_LENGTH];
+};
+
+// frame waiting to be sent by Node::send()
+struct Frame {
+	uint32_t id;
+	Node *node;
+	int length;
+	uint8_t mac[MAX_FRAME_LENGTH];
+	std::function<void (int)> onSent;
+
+	// csma/ca state
+	int backoffExponent;
+	int backoffCount;
+	int ackRetryCount;
+
+	// generation of ACK wait, the ACK timeout of an older generation is ignored
+	uint32_t ackGeneration = 0;
+	bool waitForAck = false;
+};
+
+struct Medium {
+	static Time time;
+	static float lossRate;
+
+	// containers are allocated once and never destroyed because nodes that are global variables in other
+	// translation units may get destroyed after them and remove themselves in Node::~Node()
+	static NodeList &nodes;
+
+	// events ordered by time and then by order of scheduling
+	static std::map<std::pair<Time, uint32_t>, Event> &events;
+	static uint32_t eventSequence;
+
+	static std::list<Transmission> &transmissions;
+	static std::list<Frame> &frames;
+	static uint32_t frameId;
+
+	// random numbers for backoff and loss with fixed seed so that benchmarks are reproducible
+	static std::mt19937 random;
+
+	static void schedule(Time time, Node *node, std::function<void ()> function) {
+		Medium::events.emplace(std::make_pair(time, Medium::eventSequence++), Event{node, std::move(function)});
+	}
+
+	static Frame *findFrame(uint32_t id) {
+		for (auto &frame : Medium::frames) {
+			if (frame.id == id)
+				return &frame;
+		}
+		return nullptr;
+	}
+
+	// first frame of a node which is the one being sent
+	static Frame *findFrame(Node *node) {
+		for (auto &frame : Medium::frames) {
+			if (frame.node == node)
+				return &frame;
+		}
+		return nullptr;
+	}
+
+	static bool isBusy(int channel) {
+		for (auto &transmission : Medium::transmissions) {
+			if (transmission.channel == channel)
+				return true;
+		}
+		return false;
+	}
+
+	static bool isLost(Node const *sender, Node const *receiver) {
+		float success = (1.0f - Medium::lossRate) * (1.0f - sender->lossRate) * (1.0f - receiver->lossRate);
+		return std::uniform_real_distribution<float>()(Medium::random) >= success;
+	}
+
+	// start csma/ca for the frame
+	static void startBackoff(Frame &frame) {
+		frame.backoffExponent = MIN_BACKOFF_EXPONENT;
+		frame.backoffCount = 0;
+		backoff(frame);
+	}
+
+	// wait a random backoff period and then do a clear channel assessment
+	static void backoff(Frame &frame) {
+		// fail when maximum backoff count is reached
+		if (frame.backoffCount >= MAX_BACKOFF_COUNT) {
+			finish(frame, 0);
+			return;
+		}
+
+		// throw the dice to determine backoff period
+		int periods = (Medium::random() & ~(0xffffffff << frame.backoffExponent)) + 1;
+		Time duration = periods * UNIT_BACKOFF_DURATION + CCA_DURATION;
+
+		// update backoff parameters
+		frame.backoffExponent = min(frame.backoffExponent + 1, MAX_BACKOFF_EXPONENT);
+		++frame.backoffCount;
+
+		uint32_t id = frame.id;
+		schedule(Medium::time + duration, frame.node, [id]() {
+			auto frame = findFrame(id);
+			if (isBusy(frame->node->channel)) {
+				// channel is busy: backoff and try again
+				backoff(*frame);
+			} else {
+				// channel is clear: send after rx-to-tx turnaround
+				schedule(Medium::time + TURNAROUND_DURATION, frame->node, [id]() {
+					auto frame = findFrame(id);
+					startTransmission(frame->node, frame->mac, frame->length, [id]() {
+						sent(*findFrame(id));
+					});
+				});
+			}
+		});
+	}
+
+	// frame was sent, wait for ACK if requested
+	static void sent(Frame &frame) {
+		auto frameControl = ieee::FrameControl(frame.mac[0] | (frame.mac[1] << 8));
+		if ((frameControl & ieee::FrameControl::ACKNOWLEDGE_REQUEST) == 0) {
+			finish(frame, frame.backoffCount);
+			return;
+		}
+
+		frame.waitForAck = true;
+		uint32_t id = frame.id;
+		uint32_t generation = ++frame.ackGeneration;
+		schedule(Medium::time + ACK_WAIT_DURATION, frame.node, [id, generation]() {
+			auto frame = findFrame(id);
+			if (frame == nullptr || !frame->waitForAck || frame->ackGeneration != generation)
+				return;
+			frame->waitForAck = false;
+
+			if (frame->ackRetryCount < MAX_ACK_RETRY_COUNT) {
+				// ack was not received: retry
+				++frame->ackRetryCount;
+				startBackoff(*frame);
+			} else {
+				// sent frame was not acknowledged
+				finish(*frame, 0);
+			}
+		});
+	}
+
+	// finish sending a frame and start the next frame of the node
+	static void finish(Frame &frame, int result) {
+		Node *node = frame.node;
+		if (result != 0)
+			++node->sentCount;
+		else
+			++node->failedCount;
+		auto onSent = std::move(frame.onSent);
+		Medium::frames.remove_if([&frame](Frame const &f) {return &f == &frame;});
+
+		auto next = findFrame(node);
+		node->sending = next != nullptr;
+		if (next != nullptr)
+			startBackoff(*next);
+
+		if (onSent)
+			onSent(result);
+	}
+
+	// put a frame on air
+	static void startTransmission(Node *sender, uint8_t const *mac, int length, std::function<void ()> onEnd) {
+		// overlapping frames on the same channel collide
+		bool collided = false;
+		for (auto &transmission : Medium::transmissions) {
+			if (transmission.channel == sender->channel) {
+				transmission.collided = true;
+				collided = true;
+			}
+		}
+
+		auto &transmission = Medium::transmissions.emplace_back();
+		transmission.sender = sender;
+		transmission.channel = sender->channel;
+		transmission.end = Medium::time + getAirtime(length);
+		transmission.collided = collided;
+		transmission.length = length;
+		array::copy(length, transmission.mac, mac);
+		sender->transmitting = true;
+
+		auto it = std::prev(Medium::transmissions.end());
+		schedule(transmission.end, sender, [it, onEnd = std::move(onEnd)]() {
+			it->sender->transmitting = false;
+			deliver(*it);
+			Medium::transmissions.erase(it);
+			if (onEnd)
+				onEnd();
+		});
+	}
+
+	// deliver a frame at the end of its transmission to all nodes on the channel
+	static void deliver(Transmission const &transmission) {
+		if (transmission.collided)
+			return;
+
+		uint8_t const *mac = transmission.mac;
+		int length = transmission.length;
+		auto frameControl = ieee::FrameControl(mac[0] | (mac[1] << 8));
+		auto frameType = frameControl & ieee::FrameControl::TYPE_MASK;
+
+		for (auto &node : Medium::nodes) {
+			// half duplex: a node can't receive while it transmits
+			if (&node == transmission.sender || node.channel != transmission.channel || node.transmitting)
+				continue;
+			if (isLost(transmission.sender, &node))
+				continue;
+
+			if (frameType == ieee::FrameControl::TYPE_ACK && length >= 3) {
+				// check if the node waits for this ACK
+				auto frame = findFrame(&node);
+				if (frame != nullptr && frame->waitForAck && frame->mac[2] == mac[2]) {
+					frame->waitForAck = false;
+					finish(*frame, frame->backoffCount);
+				}
+			} else if ((frameControl & ieee::FrameControl::ACKNOWLEDGE_REQUEST) != 0 && node.acknowledge(mac, length)) {
+				// send ACK after rx-to-tx turnaround
+				Node *n = &node;
+				uint8_t sequenceNumber = mac[2];
+				schedule(Medium::time + TURNAROUND_DURATION, n, [n, sequenceNumber]() {
+					uint8_t ack[] = {uint8_t(ieee::FrameControl::TYPE_ACK), 0, sequenceNumber};
+					n->transmit(ack, 3);
+				});
+			}
+
+			// link quality decreases with loss rate of the link
+			uint8_t lqi = uint8_t(255.0f * (1.0f - transmission.sender->lossRate) * (1.0f - node.lossRate));
+			++node.receivedCount;
+			node.receive(mac, length, lqi);
+		}
+	}
+};
+
+Time Medium::time = 0;
+float Medium::lossRate = 0.0f;
+NodeList &Medium::nodes = *new NodeList();
+std::map<std::pair<Time, uint32_t>, Event> &Medium::events = *new std::map<std::pair<Time, uint32_t>, Event>();
+uint32_t Medium::eventSequence = 0;
+std::list<Transmission> &Medium::transmissions = *new std::list<Transmission>();
+std::list<Frame> &Medium::frames = *new std::list<Frame>();
+uint32_t Medium::frameId = 0;
+std::mt19937 Medium::random(1);
+
+
+// Node
+
+Node::~Node() {
+	// remove all events, frames and transmissions of this node
+	std::erase_if(Medium::events, [this](auto const &entry) {return entry.second.node == this;});
+	Medium::frames.remove_if([this](Frame const &frame) {return frame.node == this;});
+	Medium::transmissions.remove_if([this](Transmission const &transmission) {return transmission.sender == this;});
+}
+
+bool Node::acknowledge(uint8_t const *mac, int length) {
+	auto frameControl = ieee::FrameControl(mac[0] | (mac[1] << 8));
+	if ((frameControl & ieee::FrameControl::DESTINATION_ADDRESSING_FLAG) == 0 || length < 7)
+		return false;
+
+	// check pan
+	uint16_t pan = mac[3] | (mac[4] << 8);
+	if (pan != this->pan)
+		return false;
+
+	if ((frameControl & ieee::FrameControl::DESTINATION_ADDRESSING_LONG_FLAG) == 0) {
+		// short destination address
+		uint16_t shortAddress = mac[5] | (mac[6] << 8);
+		return shortAddress != 0xffff && shortAddress == this->shortAddress;
+	}
+
+	// long destination address
+	if (length < 13)
+		return false;
+	uint64_t longAddress = 0;
+	for (int i = 7; i >= 0; --i)
+		longAddress = (longAddress << 8) | mac[5 + i];
+	return longAddress == this->longAddress;
+}
+
+void Node::activate() {
+}
+
+void Node::send(uint8_t const *mac, int length, std::function<void (int)> onSent) {
+	auto &frame = Medium::frames.emplace_back();
+	frame.id = Medium::frameId++;
+	frame.node = this;
+	frame.length = min(length, MAX_FRAME_LENGTH);
+	array::copy(frame.length, frame.mac, mac);
+	frame.onSent = std::move(onSent);
+	frame.ackRetryCount = 0;
+
+	// start unless a previous frame is being sent
+	if (!this->sending) {
+		this->sending = true;
+		Medium::startBackoff(frame);
+	}
+}
+
+void Node::setTimer(Time time) {
+	uint32_t generation = ++this->timerGeneration;
+	Medium::schedule(time, this, [this, generation]() {
+		if (this->timerGeneration == generation)
+			activate();
+	});
+}
+
+void Node::transmit(uint8_t const *mac, int length) {
+	Medium::startTransmission(this, mac, min(length, MAX_FRAME_LENGTH), nullptr);
+}
+
+
+// ZigbeeLight
+
+ZigbeeLight::ZigbeeLight(int channel, uint16_t pan, uint16_t shortAddress, uint64_t longAddress) {
+	this->channel = channel;
+	this->pan = pan;
+	this->shortAddress = shortAddress;
+	this->longAddress = longAddress;
+}
+
+void ZigbeeLight::receive(uint8_t const *mac, int length, uint8_t lqi) {
+	if (acknowledge(mac, length))
+		this->lastSequenceNumber = mac[2];
+}
+
+
+// GreenPowerSwitch
+
+GreenPowerSwitch::GreenPowerSwitch(int channel, uint32_t deviceId, uint8_t const (&key)[16], Time interval)
+	: deviceId(deviceId), interval(interval)
+{
+	this->channel = channel;
+	setKey(this->key, key);
+	setTimer(Medium::time + interval);
+}
+
+void GreenPowerSwitch::receive(uint8_t const *mac, int length, uint8_t lqi) {
+	// a self powered switch does not receive
+}
+
+void GreenPowerSwitch::activate() {
+	// alternate between press and release of the first rocker
+	uint8_t command = this->pressed ? 0x14 : 0x10;
+	this->pressed = !this->pressed;
+
+	uint8_t frame[] = {
+		0x01, 0x08, uint8_t(this->securityCounter), 0xff, 0xff, 0xff, 0xff, // mac header
+		0x8c, 0x30, // network header
+		I32L(this->deviceId), // deviceId
+		I32L(this->securityCounter), // counter
+		command,
+		0x00, 0x00, 0x00, 0x00}; // mic
+
+	// nonce
+	Nonce nonce(this->deviceId, this->securityCounter);
+
+	// header is network header, deviceId, counter and command
+	uint8_t const *header = frame + 7;
+	int headerLength = 11;
+
+	// message: empty payload and mic
+	uint8_t *message = frame + 18;
+
+	encrypt(message, header, headerLength, message, 0, 4, nonce, this->key);
+
+	send(frame, array::count(frame));
+	++this->securityCounter;
+
+	setTimer(Medium::time + this->interval);
+}
+
+
+// PcapReplay
+
+PcapReplay::~PcapReplay() {
+	if (this->file != nullptr)
+		fclose(this->file);
+}
+
+bool PcapReplay::open(int channel, char const *fileName) {
+	this->file = fopen(fileName, "rb");
+	if (this->file == nullptr)
+		return false;
+
+	// read pcap header
+	pcap::Header header;
+	if (fread(&header, sizeof(header), 1, this->file) != 1 || header.network != pcap::Network::IEEE802_15_4) {
+		// error: protocol not supported
+		fclose(this->file);
+		this->file = nullptr;
+		return false;
+	}
+
+	this->channel = channel;
+	this->offset = -1;
+	return readNext();
+}
+
+void PcapReplay::receive(uint8_t const *mac, int length, uint8_t lqi) {
+}
+
+void PcapReplay::activate() {
+	transmit(this->frame, this->length);
+	readNext();
+}
+
+bool PcapReplay::readNext() {
+	pcap::PacketHeader header;
+	int length;
+	while (true) {
+		if (fread(&header, sizeof(header), 1, this->file) != 1 || header.incl_len > MAX_FRAME_LENGTH + CRC_LENGTH)
+			return false;
+
+		// read at most the mac frame into the buffer and skip the crc
+		length = min(int(header.incl_len), MAX_FRAME_LENGTH);
+		if (int(fread(this->frame, 1, length, this->file)) != length
+			|| fseek(this->file, header.incl_len - length, SEEK_CUR) != 0)
+		{
+			return false;
+		}
+
+		// skip records that are too short to contain a crc
+		if (header.orig_len >= CRC_LENGTH)
+			break;
+	}
+
+	// the crc is not replayed, it is not included in the file if the captured length is shorter
+	this->length = min(length, int(header.orig_len) - CRC_LENGTH);
+
+	// schedule relative to the first frame
+	Time timestamp = Time(header.ts_sec) * 1000000 + header.ts_usec;
+	if (this->offset == -1)
+		this->offset = Medium::time - timestamp;
+	setTimer(std::max(timestamp + this->offset, Medium::time));
+	return true;
+}
+
+
+// medium
+
+void add(Node &node) {
+	Medium::nodes.add(node);
+}
+
+void setLossRate(float lossRate) {
+	Medium::lossRate = lossRate;
+}
+
+Time now() {
+	return Medium::time;
+}
+
+void advance(Time time) {
+	while (!Medium::events.empty()) {
+		auto it = Medium::events.begin();
+		if (it->first.first > time)
+			break;
+		Medium::time = it->first.first;
+		auto function = std::move(it->second.function);
+		Medium::events.erase(it);
+		function();
+	}
+	Medium::time = std::max(Medium::time, time);
+}
+
+} // namespace RadioMedium
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <crypt.hpp>
+#include <LinkedList.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+
+
+/*
+	Simulated IEEE 802.15.4 medium for the emulator. Virtual nodes (e.g. Zigbee lights, green power switches or a
+	replayed pcap file) and the emulated Radio share the medium. Frames are sent using unslotted CSMA/CA, occupy the
+	channel for their airtime at 250kbit/s and get acknowledged by the receiver if requested. Frames that overlap on
+	the same channel collide, in addition each frame is lost with the loss rate of sender and receiver.
+
+	The medium has its own time in microseconds that is advanced by the caller, either in real time by the event loop
+	of the emulator or as fast as possible, e.g. for benchmarks with hundreds of nodes.
+*/
+namespace RadioMedium {
+
+// time in microseconds
+using Time = int64_t;
+
+// timing of the 2.4GHz O-QPSK phy
+constexpr int SYMBOL_DURATION = 16;
+constexpr int BYTE_DURATION = 2 * SYMBOL_DURATION;
+constexpr int PHY_HEADER_LENGTH = 4 + 1 + 1; // preamble, start of frame delimiter, length
+constexpr int CRC_LENGTH = 2;
+constexpr int CCA_DURATION = 8 * SYMBOL_DURATION;
+constexpr int TURNAROUND_DURATION = 12 * SYMBOL_DURATION;
+constexpr int ACK_WAIT_DURATION = 54 * SYMBOL_DURATION;
+
+// csma/ca, same as in the nrf52 radio driver
+constexpr int UNIT_BACKOFF_DURATION = 20 * SYMBOL_DURATION;
+constexpr int MIN_BACKOFF_EXPONENT = 3;
+constexpr int MAX_BACKOFF_EXPONENT = 5;
+constexpr int MAX_BACKOFF_COUNT = 3;
+constexpr int MAX_ACK_RETRY_COUNT = 3;
+
+// maximum length of a mac frame without crc
+constexpr int MAX_FRAME_LENGTH = 125;
+
+/**
+ * Get the airtime of a frame including phy header and crc
+ * @param length length of the mac frame without crc
+ * @return airtime in microseconds
+ */
+constexpr Time getAirtime(int length) {
+	return (PHY_HEADER_LENGTH + length + CRC_LENGTH) * BYTE_DURATION;
+}
+
+
+/**
+ * Node on the medium. Derived classes receive frames and decide if they acknowledge them
+ */
+class Node : public LinkedListNode {
+public:
+	virtual ~Node();
+
+	/**
+	 * Called when a frame was received without collision and loss. Also called for ACK frames
+	 * @param mac mac frame without crc
+	 * @param length length of mac frame
+	 * @param lqi link quality indicator
+	 */
+	virtual void receive(uint8_t const *mac, int length, uint8_t lqi) = 0;
+
+	/**
+	 * Check if the node acknowledges a frame that requests an ACK. The default implementation checks the pan and the
+	 * short or long destination address against the members of this node
+	 * @param mac mac frame without crc
+	 * @param length length of mac frame
+	 * @return true if an ACK is sent
+	 */
+	virtual bool acknowledge(uint8_t const *mac, int length);
+
+	/**
+	 * Called when the timer of the node elapses, see setTimer()
+	 */
+	virtual void activate();
+
+	/**
+	 * Send a frame using CSMA/CA, wait for an ACK if requested in the frame control field and retry if necessary.
+	 * Frames are sent in the order of the calls to send()
+	 * @param mac mac frame without crc
+	 * @param length length of mac frame
+	 * @param onSent called with the number of backoffs on success or zero on failure, may be empty
+	 */
+	void send(uint8_t const *mac, int length, std::function<void (int)> onSent = nullptr);
+
+	/**
+	 * Set the timer of the node, activate() gets called at the given time. Replaces a previous time
+	 * @param time time in microseconds
+	 */
+	void setTimer(Time time);
+
+	// channel the node receives and sends on, -1 for none
+	int channel = -1;
+
+	// addresses used by the default acknowledge()
+	uint16_t pan = 0xffff;
+	uint16_t shortAddress = 0xffff;
+	uint64_t longAddress = 0;
+
+	// probability that a frame sent or received by this node is lost
+	float lossRate = 0.0f;
+
+	// statistics
+	int sentCount = 0;
+	int receivedCount = 0;
+	int failedCount = 0;
+
+protected:
+	friend struct Medium;
+
+	/**
+	 * Transmit a frame immediately without CSMA/CA and without waiting for an ACK
+	 * @param mac mac frame without crc
+	 * @param length length of mac frame
+	 */
+	void transmit(uint8_t const *mac, int length);
+
+	// generation of the timer, events of older generations are ignored
+	uint32_t timerGeneration = 0;
+
+	// true while a frame of this node is on air, the node can't receive during this time
+	bool transmitting = false;
+
+	// true while a frame sent by send() is processed
+	bool sending = false;
+};
+using NodeList = LinkedList<Node>;
+
+
+/**
+ * Zigbee light (router) that is always listening and acknowledges frames addressed to it
+ */
+class ZigbeeLight : public Node {
+public:
+	ZigbeeLight(int channel, uint16_t pan, uint16_t shortAddress, uint64_t longAddress);
+
+	void receive(uint8_t const *mac, int length, uint8_t lqi) override;
+
+	// state that can be inspected by a benchmark
+	uint8_t lastSequenceNumber = 0;
+};
+
+
+/**
+ * Green power switch that sends a data frame with an encrypted rocker command in a fixed interval
+ */
+class GreenPowerSwitch : public Node {
+public:
+	GreenPowerSwitch(int channel, uint32_t deviceId, uint8_t const (&key)[16], Time interval);
+
+	void receive(uint8_t const *mac, int length, uint8_t lqi) override;
+	void activate() override;
+
+	uint32_t deviceId;
+	uint32_t securityCounter = 0;
+	AesKey key;
+	Time interval;
+	bool pressed = false;
+};
+
+
+/**
+ * Replay of a pcap file with link type IEEE802_15_4. The frames are sent at the times of their timestamps relative to
+ * the first frame, without CSMA/CA and without waiting for ACKs
+ */
+class PcapReplay : public Node {
+public:
+	~PcapReplay() override;
+
+	/**
+	 * Open a pcap file and start the replay at the current time of the medium
+	 * @param channel channel to replay on
+	 * @param fileName name of the pcap file
+	 * @return true on success
+	 */
+	bool open(int channel, char const *fileName);
+
+	void receive(uint8_t const *mac, int length, uint8_t lqi) override;
+	void activate() override;
+
+protected:
+	bool readNext();
+
+	FILE *file = nullptr;
+
+	// offset from the timestamps in the file to the time of the medium
+	Time offset;
+
+	// next frame to replay
+	int length;
+	uint8_t frame[MAX_FRAME_LENGTH];
+};
+
+
+/**
+ * Add a node to the medium
+ */
+void add(Node &node);
+
+/**
+ * Set the loss rate for all nodes, e.g. 0.1 for 10% packet loss
+ */
+void setLossRate(float lossRate);
+
+/**
+ * Get the current time of the medium
+ * @return time in microseconds
+ */
+Time now();
+
+/**
+ * Process all events up to the given time and advance the time of the medium. The time can be taken from a real time
+ * clock or be advanced as fast as possible, e.g. for benchmarks
+ * @param time time in microseconds
+ */
+void advance(Time time);
+
+} // namespace RadioMedium
@@ -29,6 +29,7 @@ void SpiMR45Vxxx::transferBlocking(int writeCount, void const *writeData, int re
 	writeCount &= 0x7fffffff;
 	auto w = reinterpret_cast<uint8_t const *>(writeData);
 	auto r = reinterpret_cast<uint8_t *>(readData);
+	++this->transferCount;
 
 	uint8_t op = w[0];
 	switch (op) {
@@ -39,6 +40,14 @@ void SpiMR45Vxxx::transferBlocking(int writeCount, void const *writeData, int re
 		file.read(addr, count, r + 3);
 		break;
 	}
+	case FERAM_FSTRD: {
+		// fast read has a dummy byte after the address
+		int addr = (w[1] << 8) | w[2];
+		int count = readCount - 4;
+		assert(addr + count <= this->size);
+		file.read(addr, count, r + 4);
+		break;
+	}
 	case FERAM_WRITE: {
 		int addr = (w[1] << 8) | w[2];
 		int count = writeCount - 3;
@@ -24,5 +24,8 @@ public:
 
 	File file;
 	int size;
+
+	// number of transfers, e.g. for measuring the efficiency of a storage
+	int transferCount = 0;
 	Waitlist<SpiMaster::Parameters> waitlist;
 };
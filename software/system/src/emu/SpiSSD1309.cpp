@@ -4,7 +4,7 @@
 
 
 SpiSSD1309::SpiSSD1309(int width, int height)
-	: width(width), height(height)
+	: width(width), height(height), column2(width - 1), page2(height / 8 - 1)
 {
 	int size = width * height / 8;
 	this->display = new uint8_t[size];
@@ -33,6 +33,25 @@ void SpiSSD1309::transferBlocking(int writeCount, void const *writeData, int rea
 		// execute commands
 		for (int i = 0; i < writeCount; ++i) {
 			switch (w[i]) {
+				// set memory addressing mode
+			case 0x20:
+				++i;
+				break;
+
+				// set column address
+			case 0x21:
+				this->column1 = w[++i];
+				this->column2 = w[++i];
+				this->column = this->column1;
+				break;
+
+				// set page address
+			case 0x22:
+				this->page1 = w[++i];
+				this->page2 = w[++i];
+				this->page = this->page1;
+				break;
+
 				// set contrast control
 			case 0x81:
 				this->displayContrast = w[++i];
@@ -69,10 +88,13 @@ void SpiSSD1309::transferBlocking(int writeCount, void const *writeData, int rea
 			// copy byte (8 pixels in a column)
 			this->display[page * this->width + this->column] = w[i];
 
-			// increment column index
-			this->column = (this->column == this->width - 1) ? 0 : this->column + 1;
-			if (this->column == 0)
-				this->page = this->page == (this->height / 8 - 1) ? 0 : this->page + 1;
+			// increment column index, wrap around inside the window
+			if (this->column == this->column2) {
+				this->column = this->column1;
+				this->page = this->page == this->page2 ? this->page1 : this->page + 1;
+			} else {
+				++this->column;
+			}
 		}
 	}
 }
@@ -35,6 +35,10 @@ public:
 	// ||||||||||||||||
 	int column = 0; // column 0 to 127
 	int page = 0; // page of 8 vertical pixels, 0 to 7
+	int column1 = 0; // column window set by command 0x21, only horizontal addressing mode is emulated
+	int column2;
+	int page1 = 0; // page window set by command 0x22
+	int page2;
 	int displayContrast = 255;
 	bool displayOn = false; // all pixels on
 	bool displayInverse = false;
@@ -58,6 +58,10 @@ Awaitable<BusMaster::ReceiveParameters> BusMasterImpl::receive(int &length, uint
 	return {this->receiveWaitlist, &length, data};
 }
 
+Awaitable<BusMaster::ReceiveBufferParameters> BusMasterImpl::receive(PacketBuffer &packet) {
+	return {this->receiveBufferWaitlist, &packet};
+}
+
 Awaitable<BusMaster::SendParameters> BusMasterImpl::send(int length, uint8_t const *data) {
 	return {this->sendWaitlist, length, data};
 }
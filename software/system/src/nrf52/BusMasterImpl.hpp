@@ -14,6 +14,7 @@ public:
 	BusMasterImpl(int rxPin, int txPin);
 
 	Awaitable<ReceiveParameters> receive(int &length, uint8_t *data) override;
+	Awaitable<ReceiveBufferParameters> receive(PacketBuffer &packet) override;
 	Awaitable<SendParameters> send(int length, uint8_t const *data) override;
 
 	void handle() override;
@@ -55,5 +56,6 @@ protected:
 
 
 	Waitlist<ReceiveParameters> receiveWaitlist;
+	Waitlist<ReceiveBufferParameters> receiveBufferWaitlist;
 	Waitlist<SendParameters> sendWaitlist;
 };
@@ -18,6 +18,7 @@ namespace Calendar {
 
 // waiting coroutines
 Waitlist<> waitlist;
+Waitlist<> changeWaitlist;
 
 
 uint8_t seconds = 0;
@@ -78,4 +79,9 @@ Awaitable<> secondTick() {
 	return {Calendar::waitlist};
 }
 
+Awaitable<> clockChange() {
+	// the clock runs on RTC0 like the timer and does not get adjusted
+	return {Calendar::changeWaitlist};
+}
+
 } // namespace Calendar
@@ -19,6 +19,7 @@
 		RADIO_CONTEXT_COUNT: Number of contexts (virtual radios)
 		RADIO_RECEIVE_QUEUE_LENGTH: length of queue for received messages
 		RADIO_MAX_PAYLOAD_LENGTH: maximum length of payload
+		PACKET_POOL_COUNT: number of buffers in the packet pool
 
 	Resources:
 		NRF_RADIO
@@ -110,8 +111,14 @@ struct Context {
 	uint16_t volatile shortAddress;
 
 	Waitlist<ReceiveParameters> receiveWaitlist;
+	Waitlist<ReceiveBufferParameters> receiveBufferWaitlist;
 	Waitlist<SendParameters> sendWaitlist;
 
+	// packets that were received while no coroutine was waiting, only accessed from the event loop
+	Queue<PacketBuffer, PacketPool::BACKLOG_COUNT> receiveBacklog;
+
+	void pass(PacketBuffer const &packet);
+
 
 	bool filter(uint8_t const *data) const {
 		uint8_t const *mac = data + 1;
@@ -197,6 +204,31 @@ struct Context {
 
 Context contexts[RADIO_CONTEXT_COUNT];
 
+// pass a received packet to the first waiting coroutine or keep it until receive() gets called
+void Context::pass(PacketBuffer const &packet) {
+	// coroutines that receive into a pool buffer share the packet
+	if (!this->receiveBufferWaitlist.isEmpty()) {
+		this->receiveBufferWaitlist.resumeFirst([&packet](ReceiveBufferParameters &p) {
+			*p.packet = packet;
+			return true;
+		});
+		return;
+	}
+
+	// coroutines that receive into their own buffer get a copy
+	if (!this->receiveWaitlist.isEmpty()) {
+		this->receiveWaitlist.resumeFirst([&packet](ReceiveParameters &p) {
+			array::copy(packet.getLength(), p.packet, packet.data());
+			return true;
+		});
+		return;
+	}
+
+	// keep packet if the backlog of the context is not full and the packet pool is not exhausted
+	if (!this->receiveBacklog.isFull() && PacketPool::getFreeCount() > 0)
+		this->receiveBacklog.addBack(packet);
+}
+
 
 // receiver
 // --------
@@ -506,6 +538,18 @@ void ReceiveParameters::cancel() noexcept {
 	unlock();
 }
 
+void ReceiveBufferParameters::append(WaitlistNode &list) noexcept {
+	lock();
+	list.add(*this);
+	unlock();
+}
+
+void ReceiveBufferParameters::cancel() noexcept {
+	lock();
+	remove();
+	unlock();
+}
+
 void SendParameters::append(WaitlistNode &list) noexcept {
 	lock();
 	list.add(*this);
@@ -571,19 +615,22 @@ void handle() {
 			do {
 				Receive &receive = Radio::receiveQueue.getFront();
 
-				// resume coroutines
-				uint8_t passFlag = 1;
-				for (auto &c : Radio::contexts) {
-					if ((receive.passFlags & passFlag) != 0) {
-						// resume first waiting coroutine
-						c.receiveWaitlist.resumeFirst([&receive](ReceiveParameters &p) {
-							// length without crc but with extra data
-							int length = receive.packet[0] - 2 + Radio::RECEIVE_EXTRA_LENGTH;
-							array::copy(1 + length, p.packet, receive.packet);
-							return true;
-						});
+				// copy once from the receive queue of the interrupt into a buffer of the packet pool that is
+				// shared by all contexts
+				PacketBuffer packet;
+				if (receive.passFlags != 0 && packet.allocate()) {
+					// length without crc but with extra data
+					int length = receive.packet[0] - 2 + Radio::RECEIVE_EXTRA_LENGTH;
+					array::copy(1 + length, packet.data(), receive.packet);
+					packet.setLength(1 + length);
+
+					// resume coroutines
+					uint8_t passFlag = 1;
+					for (auto &c : Radio::contexts) {
+						if ((receive.passFlags & passFlag) != 0)
+							c.pass(packet);
+						passFlag <<= 1;
 					}
-					passFlag <<= 1;
 				}
 
 				// remove element from queue and restart receive if the buffer was full
@@ -1045,6 +1092,11 @@ void stop() {
 	Radio::receiveQueue.clear();
 	Radio::sendState = SendState::IDLE;
 	for (auto &context : Radio::contexts) {
+		// return received packets to the packet pool
+		while (!context.receiveBacklog.isEmpty()) {
+			context.receiveBacklog.getFront().reset();
+			context.receiveBacklog.removeFront();
+		}
 		/*context.receiveQueue.resumeAll([](ReceiveParameters &p) {
 			// coroutines waiting for receive get a null pointer
 			p.data = nullptr;
@@ -1119,9 +1171,32 @@ Awaitable<ReceiveParameters> receive(int index, Packet &packet) {
 	assert(uint(index) < RADIO_CONTEXT_COUNT);
 	auto &context = Radio::contexts[index];
 
+	// take packet that was received while no coroutine was waiting
+	if (!context.receiveBacklog.isEmpty()) {
+		auto &buffer = context.receiveBacklog.getFront();
+		array::copy(buffer.getLength(), packet, buffer.data());
+		buffer.reset();
+		context.receiveBacklog.removeFront();
+		return {};
+	}
+
 	return {context.receiveWaitlist, packet};
 }
 
+Awaitable<ReceiveBufferParameters> receive(int index, PacketBuffer &packet) {
+	assert(uint(index) < RADIO_CONTEXT_COUNT);
+	auto &context = Radio::contexts[index];
+
+	// take packet that was received while no coroutine was waiting
+	if (!context.receiveBacklog.isEmpty()) {
+		packet = std::move(context.receiveBacklog.getFront());
+		context.receiveBacklog.removeFront();
+		return {};
+	}
+
+	return {context.receiveBufferWaitlist, packet};
+}
+
 Awaitable<SendParameters> send(int index, uint8_t *packet, uint8_t &result) {
 	assert(uint(index) < RADIO_CONTEXT_COUNT);
 	auto &context = Radio::contexts[index];
@@ -1,10 +1,109 @@
 #include "../Terminal.hpp"
+#include "nrf52.hpp"
+#include <util.hpp>
 
 
+/*
+	Terminal output using the SEGGER RTT protocol: The text is written into a ring buffer in RAM that a debug probe
+	reads while the target is running (e.g. J-Link RTT Viewer or "rtt setup/start/server" of OpenOCD). All channels
+	share the up buffer 0. As in SEGGER's implementation, write() never blocks by default and writes only what fits into
+	the ring buffer. The debug probe can select a mode in the flags of the up buffer: Skip drops text that does not fit
+	completely, block waits for the probe while a debugger is attached so that long output such as a flight recorder
+	dump is not lost, but gives up when the probe does not read for MAX_BLOCK_SPIN polls.
+
+	Resources:
+		CoreDebug->DHCSR (read only, to check if a debugger is attached)
+*/
 namespace Terminal {
 
+constexpr int BUFFER_SIZE = 1024;
+
+// modes in the flags of an up buffer, same values as SEGGER_RTT_MODE_*
+constexpr uint32_t MODE_NO_BLOCK_SKIP = 0;
+constexpr uint32_t MODE_NO_BLOCK_TRIM = 1;
+constexpr uint32_t MODE_BLOCK_IF_FIFO_FULL = 2;
+constexpr uint32_t MODE_MASK = 3;
+
+// number of polls of the read offset after which blocking mode gives up and drops the remaining text
+constexpr int MAX_BLOCK_SPIN = 1000000;
+
+// ring buffer of the RTT protocol
+struct RttBuffer {
+	char const *name;
+	char *data;
+	uint32_t size;
+	uint32_t volatile writeOffset; // written by the target
+	uint32_t volatile readOffset; // written by the debug probe
+	uint32_t volatile flags; // mode, may be changed by the debug probe
+};
+
+// control block of the RTT protocol that the debug probe finds by searching the RAM for the id
+struct RttControlBlock {
+	char id[16];
+	int32_t upCount;
+	int32_t downCount;
+	RttBuffer up[1];
+	RttBuffer down[1];
+};
+
+RttControlBlock controlBlock;
+char upData[BUFFER_SIZE];
+char downData[16];
+
+static void initRtt() {
+	auto &cb = Terminal::controlBlock;
+	cb.upCount = 1;
+	cb.downCount = 1;
+	cb.up[0] = {"Terminal", Terminal::upData, BUFFER_SIZE, 0, 0, MODE_NO_BLOCK_TRIM};
+	cb.down[0] = {"Terminal", Terminal::downData, sizeof(Terminal::downData), 0, 0, 0};
+
+	// write the id last and in reverse order so that the probe does not find an incomplete control block
+	char const id[] = "SEGGER RTT";
+	for (int i = sizeof(id) - 1; i >= 0; --i)
+		cb.id[i] = id[i];
+	__DSB();
+}
+
 void write(int index, String const &str) {
+	auto &cb = Terminal::controlBlock;
+	if (cb.upCount == 0)
+		initRtt();
+	auto &buffer = cb.up[0];
+	uint32_t mode = buffer.flags & MODE_MASK;
+
+	int i = 0;
+	int spin = 0;
+	while (i < str.length) {
+		uint32_t writeOffset = buffer.writeOffset;
+		uint32_t readOffset = buffer.readOffset;
+
+		// number of bytes that can be written without overwriting unread data
+		int freeCount = int(readOffset <= writeOffset ? BUFFER_SIZE - 1 - writeOffset + readOffset
+			: readOffset - writeOffset - 1);
+		if (mode == MODE_NO_BLOCK_SKIP && freeCount < str.length - i)
+			break;
+		if (freeCount == 0) {
+			// wait for the debug probe only in blocking mode while a debugger is attached
+			if (mode != MODE_BLOCK_IF_FIFO_FULL || (CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk) == 0
+				|| ++spin > MAX_BLOCK_SPIN)
+			{
+				break;
+			}
+			continue;
+		}
+		spin = 0;
+
+		// copy up to the end of the ring buffer
+		int count = min(min(str.length - i, freeCount), BUFFER_SIZE - int(writeOffset));
+		for (int j = 0; j < count; ++j)
+			Terminal::upData[writeOffset + j] = str[i + j];
+		i += count;
 
+		// make the data visible before the write offset
+		__DMB();
+		writeOffset += count;
+		buffer.writeOffset = writeOffset == BUFFER_SIZE ? 0 : writeOffset;
+	}
 }
 
 Stream out{1};
@@ -1,6 +1,6 @@
 #include "../Calendar.hpp"
 #include "Loop.hpp"
-#include <boost/date_time.hpp>
+#include "WallClock.hpp"
 
 
 namespace Calendar {
@@ -8,15 +8,26 @@ namespace Calendar {
 class Context : public Loop::Timeout {
 public:
 	void activate() override {
-		// next activation in 1s
-		this->time += 1s;
+		// advance wall clock, detects adjustments of the system clock and daylight saving time
+		timespec time;
+		clock_gettime(CLOCK_REALTIME, &time);
+		bool changed = this->clock.tick(time.tv_sec);
+
+		// next activation 1ms after the next second of the system clock
+		this->time = Loop::now() + SystemDuration{int32_t(1001 - time.tv_nsec / 1000000)};
 
 		// resume all waiting coroutines
+		if (changed)
+			this->changeWaitlist.resumeAll();
 		this->waitlist.resumeAll();
 	}
 
+	// cached wall clock
+	WallClock clock;
+
 	// waiting coroutines
 	Waitlist<> waitlist;
+	Waitlist<> changeWaitlist;
 };
 Context context;
 
@@ -29,19 +40,21 @@ void init() {
 		return;
 	Calendar::inited = true;
 
-	Calendar::context.time = Loop::now() + 1s;
+	timespec time;
+	clock_gettime(CLOCK_REALTIME, &time);
+	Calendar::context.clock.sync(time.tv_sec);
+	Calendar::context.time = Loop::now() + SystemDuration{int32_t(1001 - time.tv_nsec / 1000000)};
 	Loop::timeouts.add(Calendar::context);
 }
 
 ClockTime now() {
-	auto time = boost::date_time::second_clock<boost::posix_time::ptime>::local_time();
-	auto t = time.time_of_day();
-	int seconds = t.seconds();
-	int minutes = t.minutes();
-	int hours = t.hours();
-	auto d = time.date();
-	int weekDay = (d.day_of_week() + 6) % 7;
-	return ClockTime(weekDay, hours, minutes, seconds);
+	if (!Calendar::inited) {
+		// read local time directly
+		WallClock clock;
+		clock.sync(::time(nullptr));
+		return clock.now();
+	}
+	return Calendar::context.clock.now();
 }
 
 Awaitable<> secondTick() {
@@ -51,4 +64,11 @@ Awaitable<> secondTick() {
 	return {Calendar::context.waitlist};
 }
 
+Awaitable<> clockChange() {
+	// check if Timer::init() was called
+	assert(Calendar::inited);
+
+	return {Calendar::context.changeWaitlist};
+}
+
 } // namespace Calendar
@@ -3,6 +3,7 @@
 #include <enum.hpp>
 #include <string>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -75,6 +76,23 @@ public:
 			pwrite(this->fd, buffer, remaining, offset + count * 16);
 	}
 
+	/**
+	 * Map the file into memory, unmap using munmap()
+	 * @param size size of mapped region, should not exceed the file size
+	 * @return pointer to mapped memory or nullptr on error
+	 */
+	void *map(int size) {
+		void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+		return data == MAP_FAILED ? nullptr : data;
+	}
+
+	/**
+	 * Flush written data to the storage device
+	 */
+	void sync() {
+		fsync(this->fd);
+	}
+
 protected:
 	int fd;
 };
@@ -0,0 +1,68 @@
+#include "MappedFlashImpl.hpp"
+#include <assert.hpp>
+#include <cstring>
+
+
+MappedFlashImpl::MappedFlashImpl(std::string const &filename, int sectorCount, int sectorSize, int blockSize, bool nor)
+	: file(filename, File::Mode::READ_WRITE), sectorCount(sectorCount), sectorSize(sectorSize), blockSize(blockSize)
+	, nor(nor)
+{
+	int size = sectorCount * sectorSize;
+
+	// set size of emulated flash and initialize to 0xff if necessary
+	this->file.resize(size, 0xff);
+
+	// map into memory
+	this->data = reinterpret_cast<uint8_t *>(this->file.map(size));
+	assert(this->data != nullptr);
+}
+
+MappedFlashImpl::~MappedFlashImpl() {
+	if (this->data != nullptr)
+		munmap(this->data, this->sectorCount * this->sectorSize);
+}
+
+Flash::Info MappedFlashImpl::getInfo() {
+	return {this->sectorCount, this->sectorSize, this->blockSize};
+}
+
+void MappedFlashImpl::eraseSectorBlocking(int sectorIndex) {
+	// check range
+	assert(sectorIndex >= 0 && sectorIndex < this->sectorCount);
+
+	// erase sector
+	memset(this->data + sectorIndex * this->sectorSize, 0xff, this->sectorSize);
+}
+
+void MappedFlashImpl::readBlocking(int address, int length, void *data) {
+	// check block alignment
+	assert(address % this->blockSize == 0);
+
+	// check range
+	assert(address >= 0 && address + length <= this->sectorCount * this->sectorSize);
+
+	// read from mapped file
+	memcpy(data, this->data + address, length);
+}
+
+void MappedFlashImpl::writeBlocking(int address, int length, const void *data) {
+	// check block alignment
+	assert(address % this->blockSize == 0);
+
+	// check range
+	assert(address >= 0 && address + length <= this->sectorCount * this->sectorSize);
+
+	if (this->nor) {
+		// a write can only clear bits, like on real flash
+		auto d = reinterpret_cast<uint8_t const *>(data);
+		uint8_t *f = this->data + address;
+		for (int i = 0; i < length; ++i) {
+			// check that no bit gets set that was not erased before
+			assert((d[i] & ~f[i]) == 0);
+			f[i] &= d[i];
+		}
+	} else {
+		// write to mapped file
+		memcpy(this->data + address, data, length);
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../Flash.hpp"
+#include "File.hpp"
+#include <string>
+
+
+/**
+ * Emulated flash that keeps the flash file mapped into memory, avoids a system call for each access
+ */
+class MappedFlashImpl : public Flash {
+public:
+	/**
+	 * Constructor
+	 * @param filename file name where the data is stored
+	 * @param sectorCount number of sectors
+	 * @param sectorSize size of one sector
+	 * @param blockSize size of block that has to be written at once
+	 * @param nor enforce NOR flash semantics, i.e. write can only clear bits and erase sets all bits
+	 */
+	MappedFlashImpl(std::string const &filename, int sectorCount, int sectorSize, int blockSize, bool nor = true);
+
+	~MappedFlashImpl() override;
+
+	Info getInfo() override;
+	void eraseSectorBlocking(int sectorIndex) override;
+	void readBlocking(int address, int length, void *data) override;
+	void writeBlocking(int address, int length, const void *data) override;
+
+protected:
+	File file;
+	int sectorCount;
+	int sectorSize;
+	int blockSize;
+	bool nor;
+
+	// mapped flash contents
+	uint8_t *data;
+};
@@ -31,23 +31,51 @@ class Context : public Loop::FileDescriptor {
 public:
 	void activate(uint16_t events) override {
 		if (events & POLLIN) {
-			this->receiveWaitlist.resumeFirst([this](ReceiveParameters &p) {
-				// receive
-				struct sockaddr_in6 source = {};
-				socklen_t length = sizeof(source);
-				auto receivedCount = recvfrom(this->fd, p.data, *p.length, 0, (struct sockaddr*)&source, &length);
-
-				if (receivedCount >= 0) {
-					*p.length = receivedCount;
-
-					// convert source
-					array::copy(16, p.source->address.u8, source.sin6_addr.s6_addr);
-					p.source->port = ntohs(source.sin6_port);
-					return true;
-				}
-				return false;
-			});
-			if (this->receiveWaitlist.isEmpty())
+			if (!this->receiveBufferWaitlist.isEmpty()) {
+				// receive into a buffer of the packet pool
+				this->receiveBufferWaitlist.resumeFirst([this](ReceiveBufferParameters &p) {
+					if (!p.packet->allocate()) {
+						// pool exhausted: drop the datagram, otherwise poll() would report it again immediately
+						recv(this->fd, nullptr, 0, 0);
+						return false;
+					}
+
+					// receive
+					struct sockaddr_in6 source = {};
+					socklen_t length = sizeof(source);
+					auto receivedCount = recvfrom(this->fd, p.packet->data(), PACKET_POOL_SIZE, 0,
+						(struct sockaddr*)&source, &length);
+
+					if (receivedCount >= 0) {
+						p.packet->setLength(receivedCount);
+
+						// convert source
+						array::copy(16, p.source->address.u8, source.sin6_addr.s6_addr);
+						p.source->port = ntohs(source.sin6_port);
+						return true;
+					}
+					p.packet->reset();
+					return false;
+				});
+			} else {
+				this->receiveWaitlist.resumeFirst([this](ReceiveParameters &p) {
+					// receive
+					struct sockaddr_in6 source = {};
+					socklen_t length = sizeof(source);
+					auto receivedCount = recvfrom(this->fd, p.data, *p.length, 0, (struct sockaddr*)&source, &length);
+
+					if (receivedCount >= 0) {
+						*p.length = receivedCount;
+
+						// convert source
+						array::copy(16, p.source->address.u8, source.sin6_addr.s6_addr);
+						p.source->port = ntohs(source.sin6_port);
+						return true;
+					}
+					return false;
+				});
+			}
+			if (this->receiveWaitlist.isEmpty() && this->receiveBufferWaitlist.isEmpty())
 				this->events &= ~POLLIN;
 		}
 		if (events & POLLOUT) {
@@ -69,6 +97,7 @@ public:
 
 	// waiting coroutines
 	Waitlist<ReceiveParameters> receiveWaitlist;
+	Waitlist<ReceiveBufferParameters> receiveBufferWaitlist;
 	Waitlist<SendParameters> sendWaitlist;
 };
 
@@ -139,6 +168,10 @@ void close(int index) {
 		*p.length = 0;
 		return true;
 	});
+	context.receiveBufferWaitlist.resumeAll([](ReceiveBufferParameters &p) {
+		p.packet->reset();
+		return true;
+	});
 	context.sendWaitlist.resumeAll([](SendParameters &p) {
 		return true;
 	});
@@ -161,6 +194,21 @@ Awaitable<ReceiveParameters> receive(int index, Endpoint& source, int &length, v
 	return {context.receiveWaitlist, &source, &length, data};
 }
 
+Awaitable<ReceiveBufferParameters> receive(int index, Endpoint& source, PacketBuffer &packet) {
+	assert(uint(index) < NETWORK_CONTEXT_COUNT);
+	auto &context = Network::contexts[index];
+	assert(context.fd != -1);
+
+	context.events |= POLLIN;
+
+	// add to event loop if necessary
+	if (!context.isInList())
+		Loop::fileDescriptors.add(context);
+
+	// add to wait list
+	return {context.receiveBufferWaitlist, &source, &packet};
+}
+
 Awaitable<SendParameters> send(int index, Endpoint const &destination, int length, void const *data) {
 	assert(uint(index) < NETWORK_CONTEXT_COUNT);
 	auto &context = Network::contexts[index];
@@ -1,16 +1,46 @@
 #include "StorageImpl.hpp"
 #include "File.hpp"
+#include <crc.hpp>
 #include <util.hpp>
+#include <cstddef>
+#include <cstdio>
 #include <cstring>
 
 
 namespace {
 
+// header at the start of the log file to distinguish it from the format of older versions
+struct FileHeader {
+	uint32_t magic;
+	uint32_t version;
+};
+constexpr uint32_t MAGIC = 0x4c534352; // "RCSL" (RoomControl storage log)
+constexpr uint32_t VERSION = 1;
+
+// header of a record in the log, followed by the data
 struct Header {
 	uint16_t id;
-	uint16_t length;
+	uint16_t size;
+
+	// checksum over id, size and data
+	uint16_t checksum;
 };
 
+uint16_t calcChecksum(Header const &header, void const *data) {
+	return crc16(header.size, data, crc16(offsetof(Header, checksum), &header));
+}
+
+// header of an element in the file format of older versions which stored all elements without checksum
+struct OldHeader {
+	uint16_t id;
+	uint16_t size;
+};
+
+bool writeFileHeader(File &file) {
+	FileHeader header = {MAGIC, VERSION};
+	return file.write(0, sizeof(header), &header) == sizeof(header);
+}
+
 }
 
 StorageImpl::StorageImpl(std::string const &filename, int maxId, int maxDataSize)
@@ -40,7 +70,13 @@ Storage::Status StorageImpl::readBlocking(int id, int &size, void *data) {
 		size = 0;
 		return Status::INVALID_ID;
 	}
-	auto &element = this->elements[id];
+	auto it = this->elements.find(id);
+	if (it == this->elements.end()) {
+		// not found
+		size = 0;
+		return Status::OK;
+	}
+	auto &element = it->second;
 	int len = min(size, int(element.size()));
 	memcpy(data, element.data(), len);
 	size = element.size(); // size is size of element even if it is larger than size
@@ -56,45 +92,195 @@ Storage::Status StorageImpl::writeBlocking(int id, int size, void const *data) {
 		assert(false);
 		return Status::DATA_SIZE_EXCEEDED;
 	}
-	auto &element = this->elements[id];
-	auto begin = reinterpret_cast<uint8_t const *>(data);
-	element.assign(begin, begin + size);
-	writeData();
+
+	// check if element exists and has same data
+	auto it = this->elements.find(id);
+	int oldSize = it == this->elements.end() ? -1 : int(it->second.size());
+	if (oldSize == -1 && size == 0)
+		return Status::OK;
+	if (oldSize == size && memcmp(it->second.data(), data, size) == 0)
+		return Status::OK;
+
+	// check if the log file is valid
+	if (this->logSize == 0)
+		return Status::FATAL_ERROR;
+
+	// append record to the log
+	{
+		File file(this->filename, File::Mode::WRITE);
+		if (!file.isOpen() || !appendRecord(file, this->logSize, id, size, data))
+			return Status::FATAL_ERROR;
+		file.sync();
+	}
+	this->logSize += sizeof(Header) + size;
+
+	// update element, size zero erases the element
+	if (oldSize >= 0)
+		this->liveSize -= sizeof(Header) + oldSize;
+	if (size > 0) {
+		auto begin = reinterpret_cast<uint8_t const *>(data);
+		this->elements[id].assign(begin, begin + size);
+		this->liveSize += sizeof(Header) + size;
+	} else {
+		this->elements.erase(it);
+	}
+
+	// compact when most of the log consists of outdated records
+	if (this->logSize > COMPACT_MIN_SIZE && this->logSize > this->liveSize * 2)
+		compact();
+
 	return Status::OK;
 }
 
 Storage::Status StorageImpl::clearBlocking() {
 	this->elements.clear();
-	writeData();
+	this->logSize = 0;
+	this->liveSize = 0;
+	File file(this->filename, File::Mode::WRITE | File::Mode::TRUNCATE);
+	if (!file.isOpen() || !writeFileHeader(file))
+		return Status::FATAL_ERROR;
+	file.sync();
+	this->logSize = sizeof(FileHeader);
 	return Status::OK;
 }
 
+void StorageImpl::visitBlocking(int prefix, int mask, Visitor const &visitor) {
+	// elements are sorted by id, therefore iterate over the range of ids given by prefix and mask
+	int last = prefix | (~mask & 0xffff);
+	for (auto it = this->elements.lower_bound(prefix); it != this->elements.end() && it->first <= last; ++it) {
+		if ((it->first & mask) != prefix)
+			continue;
+		auto &element = it->second;
+		void *data = visitor(it->first, element.size());
+		if (data != nullptr)
+			memcpy(data, element.data(), element.size());
+	}
+}
+
 void StorageImpl::readData() {
-	File file(filename, File::Mode::READ);
+	File file(this->filename, File::Mode::READ_WRITE);
+	if (!file.isOpen())
+		return;
+	int fileSize = file.getSize();
 
-	int offset = 0;
+	// start a new log if the file is empty
+	if (fileSize == 0) {
+		if (writeFileHeader(file)) {
+			file.sync();
+			this->logSize = sizeof(FileHeader);
+		}
+		return;
+	}
+
+	// check the file header
+	FileHeader fileHeader;
+	if (file.read(0, sizeof(fileHeader), &fileHeader) != sizeof(fileHeader) || fileHeader.magic != MAGIC
+		|| fileHeader.version != VERSION)
+	{
+		if (readOldData(file, fileSize)) {
+			// migrate a file of an older version to the log format
+			compact();
+		} else {
+			// unknown format: keep the file as backup instead of overwriting it and start a new log
+			this->elements.clear();
+			this->liveSize = 0;
+			std::string backupFilename = this->filename + ".bak";
+			if (std::rename(this->filename.c_str(), backupFilename.c_str()) == 0)
+				clearBlocking();
+		}
+		return;
+	}
+
+	// replay records until end of file or a damaged record which was interrupted while writing
+	int offset = sizeof(FileHeader);
 	Header header;
+	std::vector<uint8_t> data;
 	while (file.read(offset, sizeof(header), &header) == sizeof(header)) {
-		offset += sizeof(header);
-		uint8_t data[1024];
-		if (file.read(offset, header.length, data) < header.length)
+		data.resize(header.size);
+		if (file.read(offset + sizeof(header), header.size, data.data()) < header.size)
+			break;
+		if (header.checksum != calcChecksum(header, data.data()))
 			break;
-		this->elements[header.id].assign(data, data + header.length);
-		offset += header.length;
+
+		auto it = this->elements.find(header.id);
+		if (it != this->elements.end()) {
+			this->liveSize -= sizeof(Header) + it->second.size();
+			this->elements.erase(it);
+		}
+		if (header.size > 0) {
+			this->elements[header.id] = data;
+			this->liveSize += sizeof(Header) + header.size;
+		}
+		offset += sizeof(header) + header.size;
 	}
-}
+	this->logSize = offset;
 
-void StorageImpl::writeData() {
-	File file(filename, File::Mode::WRITE | File::Mode::TRUNCATE);
-	if (!file.isOpen())
-		return;
+	// cut off damaged tail so that new records get appended after the last valid record
+	if (offset < fileSize) {
+		file.resize(offset);
+		file.sync();
+	}
+}
 
+bool StorageImpl::readOldData(File &file, int fileSize) {
+	// read elements, the file is only accepted if it consists of valid elements up to the end
 	int offset = 0;
-	for (auto &p : this->elements) {
-		Header header = {p.first, uint16_t(p.second.size())};
-		file.write(offset, sizeof(header), &header);
+	OldHeader header;
+	std::vector<uint8_t> data;
+	while (offset < fileSize) {
+		if (file.read(offset, sizeof(header), &header) != sizeof(header)
+			|| header.id > this->maxId || header.size > this->maxDataSize)
+		{
+			return false;
+		}
 		offset += sizeof(header);
-		file.write(offset, p.second.size(), p.second.data());
-		offset += p.second.size();
+		data.resize(header.size);
+		if (file.read(offset, header.size, data.data()) != header.size)
+			return false;
+		offset += header.size;
+
+		// older versions stored empty elements
+		if (header.size > 0)
+			this->elements[header.id] = data;
+		else
+			this->elements.erase(header.id);
+	}
+
+	this->liveSize = 0;
+	for (auto &p : this->elements)
+		this->liveSize += sizeof(Header) + p.second.size();
+	return true;
+}
+
+bool StorageImpl::appendRecord(File &file, int offset, int id, int size, void const *data) {
+	// write header and data in one go
+	std::vector<uint8_t> buffer(sizeof(Header) + size);
+	Header header = {uint16_t(id), uint16_t(size), 0};
+	header.checksum = calcChecksum(header, data);
+	memcpy(buffer.data(), &header, sizeof(Header));
+	memcpy(buffer.data() + sizeof(Header), data, size);
+	return file.write(offset, buffer.size(), buffer.data()) == int(buffer.size());
+}
+
+void StorageImpl::compact() {
+	// write current elements into a temporary file
+	std::string tempFilename = this->filename + ".tmp";
+	int offset = sizeof(FileHeader);
+	{
+		File file(tempFilename, File::Mode::WRITE | File::Mode::TRUNCATE);
+		if (!file.isOpen() || !writeFileHeader(file))
+			return;
+		for (auto &p : this->elements) {
+			int size = p.second.size();
+			if (!appendRecord(file, offset, p.first, size, p.second.data()))
+				return;
+			offset += sizeof(Header) + size;
+		}
+		file.sync();
 	}
+
+	// atomically replace the log by the compacted log
+	if (std::rename(tempFilename.c_str(), this->filename.c_str()) != 0)
+		return;
+	this->logSize = offset;
 }
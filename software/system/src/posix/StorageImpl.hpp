@@ -1,3 +1,5 @@
+#pragma once
+
 #include "../Storage.hpp"
 #include "File.hpp"
 #include <map>
@@ -6,7 +8,9 @@
 
 
 /**
- * Implementation of Storage interface using files
+ * Implementation of Storage interface using an append-only log file. Each write appends one record with a checksum,
+ * the log is replayed at startup and compacted when it contains too many outdated records. The log starts with a
+ * magic number and version, files of older versions are migrated at startup
  */
 class StorageImpl : public Storage {
 public:
@@ -25,13 +29,30 @@ public:
 	virtual Status readBlocking(int id, int &size, void *data) override;
 	virtual Status writeBlocking(int id, int size, void const *data) override;
 	virtual Status clearBlocking() override;
+	virtual void visitBlocking(int prefix, int mask, Visitor const &visitor) override;
 
 protected:
+	// minimum log size in bytes before compaction is considered
+	static constexpr int COMPACT_MIN_SIZE = 65536;
+
+	// replay the log and truncate a damaged tail
 	void readData();
-	void writeData();
+
+	// read a file in the format of older versions, returns false if the file is not in this format
+	bool readOldData(File &file, int fileSize);
+
+	// append a record to the log
+	bool appendRecord(File &file, int offset, int id, int size, void const *data);
+
+	// rewrite the log so that it contains only the current elements
+	void compact();
 
 	std::string filename;
 	int maxId;
 	int maxDataSize;
 	std::map<uint16_t, std::vector<uint8_t>> elements;
+
+	// size of the log file (zero if there is no valid log file) and size of the records of current elements
+	int logSize = 0;
+	int liveSize = 0;
 };
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <ClockTime.hpp>
+#include <ctime>
+
+
+/*
+	Wall clock in local time that caches the current ClockTime so that reading it is cheap. It gets advanced once per
+	second by the Calendar and synchronized with the system clock (localtime_r) only when the system clock drifts away
+	from the cached time or when the offset of the local time may change. Time zone offsets and daylight saving time
+	transitions are multiples of 15 minutes, therefore the offset is checked every quarter of an hour.
+*/
+class WallClock {
+public:
+	// interval for checking the local time offset in seconds
+	static constexpr int CHECK_INTERVAL = 15 * 60;
+
+	/**
+	 * Synchronize with the system clock
+	 * @param time system time in seconds since epoch
+	 * @return true if the cached clock time was not equal to the local time of the system clock
+	 */
+	bool sync(time_t time) {
+		// re-read time zone in case it has changed
+		tzset();
+		tm t;
+		localtime_r(&time, &t);
+		ClockTime clock((t.tm_wday + 6) % 7, t.tm_hour, t.tm_min, t.tm_sec);
+
+		bool changed = clock.time != this->clock.time;
+		this->time = time;
+		this->clock = clock;
+		return changed;
+	}
+
+	/**
+	 * Advance the cached clock time by one second and synchronize if necessary
+	 * @param time current system time in seconds since epoch
+	 * @return true if the clock was adjusted, i.e. the system clock jumped or the local time offset changed
+	 */
+	bool tick(time_t time) {
+		// increment clock time
+		++this->time;
+		int seconds = this->clock.getSeconds() + 1;
+		if (seconds < 60) {
+			this->clock.setSeconds(seconds);
+		} else {
+			this->clock.setSeconds(0);
+			int minutes = this->clock.getMinutes() + 1;
+			if (minutes < 60) {
+				this->clock.setMinutes(minutes);
+			} else {
+				this->clock.setMinutes(0);
+				int hours = this->clock.getHours() + 1;
+				if (hours < 24) {
+					this->clock.setHours(hours);
+				} else {
+					this->clock = ClockTime((this->clock.getWeekday() + 1) % 7, 0, 0, 0);
+				}
+			}
+		}
+
+		// synchronize on drift or when the local time offset may change
+		if (time != this->time || time % CHECK_INTERVAL == 0)
+			return sync(time);
+		return false;
+	}
+
+	/**
+	 * Get cached clock time
+	 * @return clock time
+	 */
+	ClockTime now() const {return this->clock;}
+
+protected:
+	// system time in seconds since epoch that corresponds to the cached clock time
+	time_t time = 0;
+
+	// cached clock time
+	ClockTime clock;
+};
@@ -0,0 +1,55 @@
+#include <Timer.hpp>
+#include <Terminal.hpp>
+#include <Loop.hpp>
+#include <Bitmap.hpp>
+#include <StringOperators.hpp>
+#include <tahoma_8pt.hpp>
+#include <nrf52/nrf52.hpp>
+
+
+/*
+	Benchmark for the redraw of a full menu on Cortex-M4 (six lines of text, selection and underlined entry), the same
+	drawing as utilBenchmark on the host. Prints the cycles per redraw measured with the DWT cycle counter to the
+	terminal (RTT) every few seconds so that a debug probe that attaches later also sees the result.
+*/
+
+constexpr int COUNT = 1000;
+
+Coroutine benchmark() {
+	String const lines[] = {"Local Devices", "Radio Devices", "Alarms", "Functions", "Flight Recorder", "Exit"};
+	Bitmap<128, 64> bitmap;
+
+	// enable cycle counter
+	CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+
+	while (true) {
+		DWT->CYCCNT = 0;
+		for (int i = 0; i < COUNT; ++i) {
+			bitmap.clear();
+			int y = 0;
+			for (auto line : lines) {
+				int x = bitmap.drawText(10, y, tahoma_8pt, line);
+				if (y == 15)
+					bitmap.hLine(10, y + tahoma_8pt.height, x - 10);
+				y += tahoma_8pt.height;
+			}
+			bitmap.fillRectangle(9, 0, 80, tahoma_8pt.height, DrawMode::FLIP);
+		}
+		int cycles = int(DWT->CYCCNT / COUNT);
+
+		// cpu runs at 64MHz
+		Terminal::out << "menu redraw: " << dec(cycles) << " cycles, " << dec(cycles / 64) << "us\n";
+
+		co_await Timer::sleep(5s);
+	}
+}
+
+int main() {
+	Loop::init();
+	Timer::init();
+
+	benchmark();
+
+	Loop::run();
+}
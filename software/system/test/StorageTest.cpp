@@ -4,6 +4,13 @@
 #include <Terminal.hpp>
 #include <StringOperators.hpp>
 #include <boardConfig.hpp>
+#ifdef PLATFORM_POSIX
+#include <posix/StorageImpl.hpp>
+#endif
+#ifdef PLATFORM_EMU
+#include <emu/SpiMR45Vxxx.hpp>
+#include <FeRamStorage4.hpp>
+#endif
 
 
 struct Kiss32Random {
@@ -43,12 +50,76 @@ void fail() {
 	while (true) {}
 }
 
+#ifdef PLATFORM_POSIX
+// benchmark for the log based storage of posix platforms, writes 10000 small records
+void benchmarkStorageImpl() {
+	auto start = Timer::now();
+	{
+		StorageImpl storage("storageImplTest.bin", 0xffff, 1024);
+		storage.clearBlocking();
+
+		for (uint32_t i = 0; i < 10000; ++i) {
+			if (storage.writeBlocking(i % 64, sizeof(i), &i) != Storage::Status::OK)
+				fail();
+		}
+	}
+	auto end = Timer::now();
+
+	// replay the log and check the last written values
+	StorageImpl storage("storageImplTest.bin", 0xffff, 1024);
+	for (int id = 0; id < 64; ++id) {
+		uint32_t value;
+		int size = sizeof(value);
+		storage.readBlocking(id, size, &value);
+		uint32_t last = id + (9999 - id) / 64 * 64;
+		if (size != sizeof(value) || value != last)
+			fail();
+	}
+
+	Terminal::out << "StorageImpl: " << dec(int((end - start) / 1ms)) << "ms for 10000 writes\n";
+}
+#endif
+
+#ifdef PLATFORM_EMU
+// count the SPI transfers of the FeRam storage for loading all counters as done on startup
+void benchmarkFeRamStorage4() {
+	SpiMR45Vxxx feRam("feRamTest.bin", 8192);
+	FeRamStorage4<8192> storage(feRam);
+	constexpr int COUNT = 128;
+
+	for (uint32_t id = 0; id < COUNT; ++id) {
+		if (storage.writeBlocking(id, sizeof(id), &id) != Storage::Status::OK)
+			fail();
+	}
+	int writeCount = feRam.transferCount;
+
+	for (int id = 0; id < COUNT; ++id) {
+		uint32_t value;
+		int size = sizeof(value);
+		storage.readBlocking(id, size, &value);
+		if (size != sizeof(value) || value != uint32_t(id))
+			fail();
+	}
+	int readCount = feRam.transferCount - writeCount;
+
+	Terminal::out << "FeRamStorage4: " << dec(writeCount) << " transfers for " << dec(COUNT) << " writes, "
+		<< dec(readCount) << " transfers for " << dec(COUNT) << " reads\n";
+}
+#endif
+
 int main() {
 	Loop::init();
 	Timer::init();
 	Output::init(); // for debug led's
 	DriversStorageTest drivers;
 
+#ifdef PLATFORM_POSIX
+	benchmarkStorageImpl();
+#endif
+#ifdef PLATFORM_EMU
+	benchmarkFeRamStorage4();
+#endif
+
 	Kiss32Random random;
 
 	auto start = Timer::now();
@@ -0,0 +1,31 @@
+#include <posix/WallClock.hpp>
+#include <boost/date_time.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+
+
+// benchmark the cached wall clock (one tick and one read per iteration, synchronizes every 15 minutes) against
+// reading the local time using boost on every call
+TEST(systemBenchmark, WallClock) {
+	constexpr int count = 100000;
+	time_t time = ::time(nullptr);
+	WallClock clock;
+	clock.sync(time);
+
+	uint32_t sum = 0;
+	auto start1 = std::chrono::steady_clock::now();
+	for (int i = 1; i <= count; ++i) {
+		clock.tick(time + i);
+		sum += clock.now().time;
+	}
+	auto cached = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start1).count();
+
+	auto start2 = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i)
+		sum += boost::date_time::second_clock<boost::posix_time::ptime>::local_time().time_of_day().seconds();
+	auto boost = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start2).count();
+
+	std::cout << "Calendar::now(): cached " << cached / count << "ns, boost " << boost / count << "ns ("
+		<< sum % 2 << ")" << std::endl;
+}
@@ -1,6 +1,14 @@
 #include <SystemTime.hpp>
+#include <Animator.hpp>
 #include <ClockTime.hpp>
+#include <PacketPool.hpp>
+#include <WeekSchedule.hpp>
+#include <posix/WallClock.hpp>
+#include <emu/RadioMedium.hpp>
 #include <gtest/gtest.h>
+#include <cstdlib>
+#include <memory>
+#include <vector>
 
 
 TEST(systemTest, SystemTime) {
@@ -52,6 +60,357 @@ TEST(systemTest, ClockTime) {
 	EXPECT_FALSE(alarm.matches(time3));
 }
 
+// run the wall clock across a daylight saving time transition and check that it gets adjusted exactly at the
+// transition
+void testTransition(time_t start, int seconds, ClockTime before, ClockTime after) {
+	WallClock clock;
+	clock.sync(start);
+	EXPECT_EQ(clock.now().time, before.time);
+	int changedCount = 0;
+	for (int i = 1; i <= seconds; ++i) {
+		bool changed = clock.tick(start + i);
+		if (changed)
+			++changedCount;
+
+		// compare against local time of the system
+		WallClock reference;
+		reference.sync(start + i);
+		EXPECT_EQ(clock.now().time, reference.now().time);
+	}
+	EXPECT_EQ(changedCount, 1);
+	EXPECT_EQ(clock.now().time, after.time);
+}
+
+TEST(systemTest, WallClock) {
+	// central european time with daylight saving time, the rules are given explicitly so that no time zone database
+	// is needed
+	setenv("TZ", "CET-1CEST,M3.5.0,M10.5.0/3", 1);
+
+	// Sunday, 2021-03-28 01:59:50 CET to 03:00:10 CEST (transition at 01:00:00 UTC)
+	testTransition(1616893190, 20, ClockTime(6, 1, 59, 50), ClockTime(6, 3, 0, 10));
+
+	// Sunday, 2021-10-31 02:59:50 CEST to 02:00:10 CET (transition at 01:00:00 UTC)
+	testTransition(1635641990, 20, ClockTime(6, 2, 59, 50), ClockTime(6, 2, 0, 10));
+
+	// wrap around of the week: Sunday, 2021-04-04 23:59:59 CEST to Monday 00:00:00
+	WallClock clock;
+	clock.sync(1617573599);
+	EXPECT_EQ(clock.now().time, ClockTime(6, 23, 59, 59).time);
+	EXPECT_FALSE(clock.tick(1617573600));
+	EXPECT_EQ(clock.now().time, ClockTime(0, 0, 0, 0).time);
+
+	// system clock jumps by one minute
+	EXPECT_TRUE(clock.tick(1617573661));
+	EXPECT_EQ(clock.now().time, ClockTime(0, 0, 1, 1).time);
+
+	unsetenv("TZ");
+}
+
+// wait for a time or a step and record the time at which the animator resumed
+Coroutine animate(Animator &animator, SystemTime time, bool step, SystemTime const &now, SystemTime &resumed) {
+	if (step)
+		co_await animator.step(time);
+	else
+		co_await animator.wait(time);
+	resumed = now;
+}
+
+// wait for a time or until cancelled
+Coroutine animateOrCancel(Animator &animator, SystemTime time, Barrier<> &cancel, int &result) {
+	result = co_await select(animator.wait(time), cancel.wait());
+}
+
+// count how often the owner of the animator gets woken up for an earlier time
+Coroutine countChanges(Animator &animator, int &count) {
+	while (true) {
+		co_await animator.changed();
+		++count;
+	}
+}
+
+TEST(systemTest, Animator) {
+	Animator animator;
+	SystemTime now = {1000};
+	SystemTime next;
+	EXPECT_FALSE(animator.getNext(next));
+
+	int changeCount = 0;
+	Coroutine changes = countChanges(animator, changeCount);
+
+	// exact time (e.g. off timeout) and steps on the tick grid (e.g. animation step)
+	SystemTime timeout = {};
+	SystemTime step1 = {};
+	SystemTime step2 = {};
+	animate(animator, now + 250ms, false, now, timeout);
+	animate(animator, now + 110ms, true, now, step1);
+	animate(animator, now + 190ms, true, now, step2);
+	EXPECT_EQ(changeCount, 2);
+	EXPECT_TRUE(animator.getNext(next));
+	EXPECT_EQ(next.value, 1200);
+
+	// nothing is due before the tick
+	now = {1199};
+	animator.advance(now);
+	EXPECT_EQ(step1.value, 0);
+	EXPECT_TRUE(animator.getNext(next));
+	EXPECT_EQ(next.value, 1200);
+
+	// both steps get resumed in one batch on the tick
+	now = {1200};
+	animator.advance(now);
+	EXPECT_EQ(step1.value, 1200);
+	EXPECT_EQ(step2.value, 1200);
+	EXPECT_EQ(timeout.value, 0);
+
+	// the timeout is not quantized to the grid
+	EXPECT_TRUE(animator.getNext(next));
+	EXPECT_EQ(next.value, 1250);
+	now = {1250};
+	animator.advance(now);
+	EXPECT_EQ(timeout.value, 1250);
+	EXPECT_FALSE(animator.getNext(next));
+
+	// a later time does not wake up the owner
+	changeCount = 0;
+	SystemTime late = {};
+	animate(animator, now + 500ms, false, now, late);
+	animate(animator, now + 600ms, false, now, late);
+	EXPECT_EQ(changeCount, 1);
+
+	// cancelled function gets removed, the next time may still be the time of the cancelled function
+	Barrier<> cancel;
+	int result = 0;
+	animateOrCancel(animator, now + 100ms, cancel, result);
+	EXPECT_EQ(changeCount, 2);
+	cancel.resumeAll();
+	EXPECT_EQ(result, 2);
+	now = {1350};
+	animator.advance(now);
+	EXPECT_EQ(result, 2);
+	EXPECT_EQ(late.value, 0);
+	EXPECT_TRUE(animator.getNext(next));
+	EXPECT_EQ(next.value, 1750);
+
+	// overdue functions get resumed on the next advance
+	now = {2000};
+	animator.advance(now);
+	EXPECT_EQ(late.value, 2000);
+	EXPECT_FALSE(animator.getNext(next));
+
+	changes.destroy();
+}
+
+// collect ids of the entries that are due after the clock advanced from checked to now
+std::vector<int> getDue(WeekSchedule<16> const &schedule, int checked, int now, int elapsed) {
+	std::vector<int> ids;
+	int span = schedule.getDueSpan(checked, now, elapsed);
+	schedule.forEachDue(checked, span, [&ids](uint8_t id) {ids.push_back(id);});
+	return ids;
+}
+
+TEST(systemTest, WeekSchedule) {
+	constexpr int WEEK = ClockTime::SECONDS_PER_WEEK;
+	WeekSchedule<16> schedule;
+	EXPECT_TRUE(schedule.isEmpty());
+
+	// Monday 7:00 and Friday 7:00 for alarm 1, Sunday 23:59:59 for alarm 2 (last second of the week)
+	int monday = ClockTime(0, 7, 0).getWeekSeconds();
+	int friday = ClockTime(4, 7, 0).getWeekSeconds();
+	int sunday = ClockTime(6, 23, 59, 59).getWeekSeconds();
+	schedule.add(friday, 1);
+	schedule.add(sunday, 2);
+	schedule.add(monday, 1);
+	EXPECT_EQ(schedule.size(), 3);
+
+	// next entry, an entry at the given time is already over, after the last entry the schedule wraps around
+	EXPECT_EQ(schedule.getNextIndex(0), 0);
+	EXPECT_EQ(schedule.getNextIndex(monday - 1), 0);
+	EXPECT_EQ(schedule.getNextIndex(monday), 1);
+	EXPECT_EQ(schedule.getNextIndex(friday), 2);
+	EXPECT_EQ(schedule.getNextIndex(sunday), 0);
+	EXPECT_EQ(schedule.getDelay(monday - 10), 10);
+	EXPECT_EQ(schedule.getDelay(sunday), monday + 1);
+
+	// a single entry goes off once per week
+	WeekSchedule<16> single;
+	single.add(monday, 5);
+	EXPECT_EQ(single.getNextIndex(monday), 0);
+	EXPECT_EQ(single.getDelay(monday), WEEK);
+	EXPECT_EQ(getDue(single, monday, monday, WEEK), std::vector<int>({5}));
+	EXPECT_EQ(getDue(single, monday, monday + 1, WEEK), std::vector<int>({5}));
+
+	// regular wakeup at the alarm time and wakeup one second late
+	EXPECT_EQ(getDue(schedule, monday - 10, monday, 10), std::vector<int>({1}));
+	EXPECT_EQ(getDue(schedule, monday - 10, monday + 1, 11), std::vector<int>({1}));
+	EXPECT_TRUE(getDue(schedule, monday, monday + 10, 10).empty());
+
+	// wrap around of the week
+	EXPECT_EQ(getDue(schedule, sunday - 5, 10, 15), std::vector<int>({2}));
+	EXPECT_EQ(getDue(schedule, sunday - 5, monday, monday + 5), std::vector<int>({2, 1}));
+
+	// wall clock resyncs because the loop ran late: alarms in between still go off
+	EXPECT_EQ(getDue(schedule, monday - 2, monday + 3, 3), std::vector<int>({1}));
+
+	// clock jumps forward by one hour (start of daylight saving time)
+	EXPECT_EQ(getDue(schedule, monday - 1800, monday + 1800, 1), std::vector<int>({1}));
+
+	// clock gets set for the first time: nothing goes off
+	EXPECT_TRUE(getDue(schedule, 0, friday + 10, 1).empty());
+
+	// clock jumps back by one hour (end of daylight saving time): alarms do not go off twice
+	EXPECT_TRUE(getDue(schedule, monday + 1800, monday - 1800, 1).empty());
+
+	// clock jumps back by less than the elapsed time: only the remaining span is checked
+	EXPECT_EQ(getDue(schedule, monday - 10, monday + 5, 20), std::vector<int>({1}));
+
+	// empty schedule
+	schedule.clear();
+	EXPECT_TRUE(schedule.isEmpty());
+	EXPECT_EQ(schedule.getNextIndex(monday), 0);
+	EXPECT_TRUE(getDue(schedule, 0, 100, 100).empty());
+}
+
+TEST(systemTest, PacketPool) {
+	int count = PacketPool::getFreeCount();
+	ASSERT_GE(count, 2);
+
+	// allocate a buffer and share it
+	PacketBuffer a;
+	ASSERT_TRUE(a.allocate());
+	a.data()[0] = 10;
+	a.setLength(1);
+	EXPECT_EQ(PacketPool::getFreeCount(), count - 1);
+	EXPECT_FALSE(a.isShared());
+	{
+		PacketBuffer b = a;
+		EXPECT_TRUE(a.isShared());
+		EXPECT_TRUE(b.isShared());
+		EXPECT_EQ(b.data(), a.data());
+		EXPECT_EQ(PacketPool::getFreeCount(), count - 1);
+
+		// copy on write: b gets its own buffer, a keeps the original data
+		ASSERT_TRUE(b.makeWritable());
+		EXPECT_NE(b.data(), a.data());
+		EXPECT_FALSE(a.isShared());
+		EXPECT_FALSE(b.isShared());
+		EXPECT_EQ(b.getLength(), 1);
+		EXPECT_EQ(b.data()[0], 10);
+		b.data()[0] = 20;
+		EXPECT_EQ(a.data()[0], 10);
+		EXPECT_EQ(PacketPool::getFreeCount(), count - 2);
+
+		// an unshared buffer is writable without copy
+		uint8_t *data = b.data();
+		ASSERT_TRUE(b.makeWritable());
+		EXPECT_EQ(b.data(), data);
+	}
+	EXPECT_EQ(PacketPool::getFreeCount(), count - 1);
+
+	// move transfers the reference
+	PacketBuffer c = std::move(a);
+	EXPECT_FALSE(a.isValid());
+	EXPECT_TRUE(c.isValid());
+	EXPECT_EQ(PacketPool::getFreeCount(), count - 1);
+
+	// exhaust the pool
+	std::vector<PacketBuffer> buffers(count - 1);
+	for (auto &buffer : buffers)
+		ASSERT_TRUE(buffer.allocate());
+	EXPECT_EQ(PacketPool::getFreeCount(), 0);
+	int failCount = PacketPool::getFailCount();
+	PacketBuffer d;
+	EXPECT_FALSE(d.allocate());
+	EXPECT_FALSE(d.isValid());
+	EXPECT_EQ(PacketPool::getFailCount(), failCount + 1);
+
+	// a shared buffer can't be made writable when the pool is exhausted
+	PacketBuffer e = c;
+	EXPECT_FALSE(e.makeWritable());
+	EXPECT_EQ(e.data(), c.data());
+	EXPECT_EQ(PacketPool::getFailCount(), failCount + 2);
+
+	// all buffers return to the pool
+	buffers.clear();
+	EXPECT_EQ(PacketPool::getFreeCount(), count - 1);
+	c.reset();
+	EXPECT_EQ(PacketPool::getFreeCount(), count - 1);
+	e.reset();
+	EXPECT_EQ(PacketPool::getFreeCount(), count);
+}
+
+TEST(systemTest, RadioMedium) {
+	// hundreds of lights and switches on the same channel
+	constexpr int LIGHT_COUNT = 200;
+	constexpr int SWITCH_COUNT = 100;
+	constexpr int CHANNEL = 15;
+	constexpr uint16_t PAN = 0x1234;
+	constexpr RadioMedium::Time SECOND = 1000000;
+	uint8_t const key[16] = {};
+
+	std::vector<std::unique_ptr<RadioMedium::ZigbeeLight>> lights;
+	for (int i = 0; i < LIGHT_COUNT; ++i) {
+		auto &light = lights.emplace_back(std::make_unique<RadioMedium::ZigbeeLight>(CHANNEL, PAN, 0x1000 + i,
+			0x0011223344000000 + i));
+		RadioMedium::add(*light);
+	}
+	std::vector<std::unique_ptr<RadioMedium::GreenPowerSwitch>> switches;
+	for (int i = 0; i < SWITCH_COUNT; ++i) {
+		// slightly different intervals so that the switches drift apart
+		auto &s = switches.emplace_back(std::make_unique<RadioMedium::GreenPowerSwitch>(CHANNEL, 0x10000000 + i, key,
+			SECOND + i * 1000));
+		RadioMedium::add(*s);
+	}
+
+	// first light sends a data frame that requests an ACK to each other light
+	int acknowledgedCount = 0;
+	int failedCount = 0;
+	for (int i = 1; i < LIGHT_COUNT; ++i) {
+		uint16_t destination = 0x1000 + i;
+		uint8_t frame[] = {
+			0x61, 0x88, // data frame, ACK request, pan id compression, short addresses
+			uint8_t(i), // sequence number
+			uint8_t(PAN), uint8_t(PAN >> 8),
+			uint8_t(destination), uint8_t(destination >> 8),
+			0x00, 0x10, // source
+			0x01, 0x02, 0x03, 0x04 // payload
+		};
+		lights[0]->send(frame, std::size(frame), [&acknowledgedCount, &failedCount](int backoffCount) {
+			if (backoffCount > 0)
+				++acknowledgedCount;
+			else
+				++failedCount;
+		});
+	}
+
+	// run the medium for ten seconds
+	RadioMedium::Time end = RadioMedium::now() + 10 * SECOND;
+	while (RadioMedium::now() < end)
+		RadioMedium::advance(RadioMedium::now() + 1000);
+
+	// all frames of the first light are done and nearly all were acknowledged despite the switch traffic
+	EXPECT_EQ(acknowledgedCount + failedCount, LIGHT_COUNT - 1);
+	EXPECT_EQ(lights[0]->sentCount, acknowledgedCount);
+	EXPECT_GE(acknowledgedCount, (LIGHT_COUNT - 1) * 9 / 10);
+
+	// an acknowledged frame was received by its destination
+	int receivedCount = 0;
+	for (int i = 1; i < LIGHT_COUNT; ++i) {
+		if (lights[i]->lastSequenceNumber == uint8_t(i))
+			++receivedCount;
+	}
+	EXPECT_GE(receivedCount, acknowledgedCount);
+
+	// each switch sent 9 or 10 frames (interval is between 1.0s and 1.1s)
+	for (auto &s : switches) {
+		int count = s->sentCount + s->failedCount;
+		EXPECT_GE(count, 9);
+		EXPECT_LE(count, 10);
+	}
+
+	// lights receive the frames of the switches
+	for (auto &light : lights)
+		EXPECT_GT(light->receivedCount, 0);
+}
 
 int main(int argc, char **argv) {
 	testing::InitGoogleTest(&argc, argv);
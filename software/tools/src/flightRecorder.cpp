@@ -0,0 +1,77 @@
+#include <FlightRecorder.hpp>
+#include <Terminal.hpp>
+#include <StringOperators.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+// converts a flight recorder dump that was captured from the terminal (lines starting with "fr ") into a recording
+// file and prints the records. Replay the recording file in the emulator: control <recording> [<speed>]
+
+using Record = FlightRecorder::Record;
+
+
+// print a record: time in seconds, source, destination and message in hex
+void printRecord(Record const &record, uint32_t startTime) {
+	auto &m = record.message;
+	Terminal::out << flt(float(record.time - startTime) / float(FlightRecorder::TICKS_PER_SECOND), 1, 3) << "s "
+		<< dec(record.source.interfaceId) << ':' << dec(record.source.elementId) << ':' << dec(record.source.plugIndex)
+		<< " -> " << dec(record.interfaceId) << ':' << dec(record.elementId) << ':' << dec(record.plugIndex)
+		<< '/' << dec(record.connectionIndex)
+		<< " value " << hex(m.value.u8) << ' ' << flt(m.value.f32, 1, 3)
+		<< " command " << dec(m.command) << " transition " << dec(m.transition) << '\n';
+}
+
+int main(int argc, char const *argv[]) {
+	if (argc < 2) {
+		Terminal::err << "usage: flightRecorder <dump or recording> [<output recording>]\n";
+		return 1;
+	}
+
+	// read records either from a recording file or from a text dump
+	std::vector<Record> records;
+	Record *data;
+	int count = FlightRecorder::load(argv[1], data);
+	if (count >= 0) {
+		records.assign(data, data + count);
+		delete [] data;
+	} else {
+		std::ifstream file(argv[1]);
+		if (!file) {
+			Terminal::err << "error: can't open " << argv[1] << '\n';
+			return 1;
+		}
+		std::string line;
+		while (std::getline(file, line)) {
+			// the dump may be embedded in other terminal output
+			auto pos = line.find("fr ");
+			if (pos == std::string::npos)
+				continue;
+			Record record;
+			if (FlightRecorder::parse(String(int(line.size() - pos), line.data() + pos), record))
+				records.push_back(record);
+		}
+	}
+
+	// print records
+	uint32_t startTime = records.empty() ? 0 : records.front().time;
+	for (auto &record : records)
+		printRecord(record, startTime);
+	Terminal::out << dec(int(records.size())) << " records\n";
+
+	// write recording file
+	if (argc >= 3) {
+		std::ofstream file(argv[2], std::ios::binary);
+		FlightRecorder::FileHeader header = {FlightRecorder::FILE_MAGIC, FlightRecorder::FILE_VERSION, sizeof(Record),
+			uint32_t(records.size())};
+		file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+		file.write(reinterpret_cast<char const *>(records.data()), records.size() * sizeof(Record));
+		if (!file) {
+			Terminal::err << "error: can't write " << argv[2] << '\n';
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -1,5 +1,6 @@
 #include <Terminal.hpp>
 #include <RadioDefs.hpp>
+#include <RingBuffer.hpp>
 #include <usb.hpp>
 #include <crypt.hpp>
 #include <hash.hpp>
@@ -9,17 +10,30 @@
 #include <zcl.hpp>
 #include <gp.hpp>
 #include <pcap.hpp>
+#include <pcapng.hpp>
 #include <MessageReader.hpp>
 #include <StringBuffer.hpp>
 #include <StringOperators.hpp>
 #include <util.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <string>
 #include <filesystem>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <libusb.h>
 
 
-// logs ieee 802.15.4 traffic to a .pcap file
+// logs ieee 802.15.4 traffic to .pcapng files and analyzes .pcap and .pcapng files
 
 // PTM 215Z/216Z: Press A0 for 7 seconds to commission on channel 15, then A1 and A0 together to confirm
 
@@ -257,9 +271,13 @@ void handleGp(uint8_t const *mac, PacketReader &r) {
 	// header: header that is not encrypted, payload is part of header for security levels 0 and 1
 	// payload: payload that is encrypted, has zero length for security levels 0 and 1
 	// mic: message integrity code, 2 or 4 bytes
-	uint32_t securityCounter;
+	uint32_t securityCounter = 0;
 	int micLength;
 	switch (securityLevel) {
+	case gp::NwkExtendedFrameControl::SECURITY_LEVEL_NONE:
+		// no security, e.g. security was removed by batch analysis
+		micLength = 0;
+		break;
 	case gp::NwkExtendedFrameControl::SECURITY_LEVEL_CNT8_MIC16:
 		// security level 1: 1 byte counter, 2 byte mic
 
@@ -300,7 +318,7 @@ void handleGp(uint8_t const *mac, PacketReader &r) {
 
 	// check message integrity code or decrypt message, depending on security level
 	Nonce nonce(deviceId, securityCounter);
-	if (!r.decrypt(micLength, nonce, device.aesKey)) {
+	if (micLength > 0 && !r.decrypt(micLength, nonce, device.aesKey)) {
 		if (securityLevel <= gp::NwkExtendedFrameControl::SECURITY_LEVEL_CNT32_MIC32) {
 			Terminal::out << ("Decrypt Error; ");
 			// we can continue as data is not encrypted
@@ -317,17 +335,25 @@ void handleGp(uint8_t const *mac, PacketReader &r) {
 	Terminal::out << ("\n");
 }
 
-void handleGpCommission(uint32_t deviceId, PacketReader &r) {
+// content of a commissioning command
+struct GpCommissioning {
+	gp::DeviceType deviceType;
+	bool haveKey = false;
+	uint8_t key[16];
+	bool haveCounter = false;
+	uint32_t counter;
+};
+
+// read commissioning command without printing, returns false if the key can't be decrypted or the command is too short
+bool readGpCommissioning(uint32_t deviceId, PacketReader &r, GpCommissioning &commissioning) {
 	// remove commissioning command (0xe0)
 	r.u8();
 
-	GpDevice device;
-
 	// A.4.2.1.1 Commissioning
 
 	// device type
 	// 0x02: on/off switch
-	auto deviceType = r.e8<gp::DeviceType>();
+	commissioning.deviceType = r.e8<gp::DeviceType>();
 
 	// options
 	auto options = r.e8<gp::Options>();
@@ -351,10 +377,8 @@ void handleGpCommission(uint32_t deviceId, PacketReader &r) {
 				header.setU32L(0, deviceId);
 
 				// in-place decrypt
-				if (!decrypt(key, header.data, 4, key, 16, 4, nonce, zb::za09LinkAesKey)) {
-					Terminal::out << ("Error while decrypting key!\n");
-					return;
-				}
+				if (!decrypt(key, header.data, 4, key, 16, 4, nonce, zb::za09LinkAesKey))
+					return false;
 
 				// skip key and MIC
 				r.skip(16 + 4);
@@ -362,30 +386,44 @@ void handleGpCommission(uint32_t deviceId, PacketReader &r) {
 				// skip key
 				r.skip(16);
 			}
-
-			// print key
-			Terminal::out << ("Key: ");
-			for (int i = 0; i < 16; ++i) {
-				if (i > 0)
-					Terminal::out << (":");
-				Terminal::out << (hex(key[i]));
-			}
-			Terminal::out << ("\n");
-
-			// set key for device
-			setKey(device.aesKey, Array<uint8_t const, 16>(key));
+			array::copy(16, commissioning.key, key);
+			commissioning.haveKey = true;
 		}
 		if ((extendedOptions & gp::ExtendedOptions::COUNTER_PRESENT) != 0) {
-			uint32_t counter = r.u32L();
-			Terminal::out << ("Counter: 0x" + hex(counter) + "\n");
+			commissioning.counter = r.u32L();
+			commissioning.haveCounter = true;
 		}
 	}
 
 	// check if we exceeded the end
-	if (r.getRemaining() < 0)
+	return r.getRemaining() >= 0;
+}
+
+void handleGpCommission(uint32_t deviceId, PacketReader &r) {
+	GpCommissioning commissioning;
+	if (!readGpCommissioning(deviceId, r, commissioning)) {
+		Terminal::out << ("Error in commissioning command!\n");
 		return;
+	}
+
+	GpDevice device;
+	if (commissioning.haveKey) {
+		// print key
+		Terminal::out << ("Key: ");
+		for (int i = 0; i < 16; ++i) {
+			if (i > 0)
+				Terminal::out << (":");
+			Terminal::out << (hex(commissioning.key[i]));
+		}
+		Terminal::out << ("\n");
 
-	switch (deviceType) {
+		// set key for device
+		setKey(device.aesKey, Array<uint8_t const, 16>(commissioning.key));
+	}
+	if (commissioning.haveCounter)
+		Terminal::out << ("Counter: 0x" + hex(commissioning.counter) + "\n");
+
+	switch (commissioning.deviceType) {
 	case gp::DeviceType::ON_OFF_SWITCH:
 		// hue switch
 
@@ -925,6 +963,1040 @@ void handleZcl(PacketReader &r, uint8_t destinationEndpoint) {
 }
 
 
+// Capture Files
+// -------------
+// Input files are memory mapped and can be in .pcap format or in .pcapng format as written by the live capture
+
+// packet in a mapped capture file
+struct FilePacket {
+	// timestamp in microseconds since 1970
+	uint64_t timestamp;
+
+	int length;
+	uint8_t const *data;
+};
+
+// reads the IEEE 802.15.4 packets of a .pcap or .pcapng file
+class CaptureReader {
+public:
+	~CaptureReader() {
+		if (this->begin != nullptr)
+			munmap(const_cast<uint8_t *>(this->begin), this->end - this->begin);
+	}
+
+	/**
+	 * Map a capture file and check its header, prints an error message on failure
+	 * @param path path of the capture file
+	 * @return true on success
+	 */
+	bool open(fs::path const &path) {
+		std::string name = path.string();
+		int fd = ::open(name.c_str(), O_RDONLY);
+		struct stat st;
+		if (fd == -1 || fstat(fd, &st) != 0) {
+			Terminal::err << "error: can't read capture file " << str(name.c_str()) << "\n";
+			if (fd != -1)
+				close(fd);
+			return false;
+		}
+		size_t size = st.st_size;
+		void *map = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+		close(fd);
+		if (map == MAP_FAILED) {
+			Terminal::err << "error: header incomplete!\n";
+			return false;
+		}
+		this->begin = this->it = reinterpret_cast<uint8_t const *>(map);
+		this->end = this->begin + size;
+
+		// pcapng: the section header gets checked in read() as a file may contain multiple sections
+		if (size >= 4 && *reinterpret_cast<pcapng::BlockType const *>(this->begin) == pcapng::BlockType::SECTION_HEADER) {
+			this->ng = true;
+			return true;
+		}
+
+		// pcap
+		if (size < sizeof(pcap::Header)) {
+			Terminal::err << "error: header incomplete!\n";
+			return false;
+		}
+		auto &header = *reinterpret_cast<pcap::Header const *>(this->begin);
+		if (header.magic_number != 0xa1b2c3d4 && header.magic_number != 0xa1b23c4d) {
+			Terminal::err << "error: unknown file format!\n";
+			return false;
+		}
+		if (header.network != pcap::Network::IEEE802_15_4) {
+			Terminal::err << "error: protocol not supported!\n";
+			return false;
+		}
+		this->nanoseconds = header.magic_number == 0xa1b23c4d;
+		this->it += sizeof(pcap::Header);
+		return true;
+	}
+
+	/**
+	 * Read the next packet, skips other blocks and packets of other protocols in .pcapng files
+	 * @param packet packet that points into the mapped file
+	 * @return true if a packet was read, false at the end of the file or when the file is truncated
+	 */
+	bool read(FilePacket &packet) {
+		if (!this->ng) {
+			// pcap
+			if (this->end - this->it < int(sizeof(pcap::PacketHeader)))
+				return false;
+			auto header = reinterpret_cast<pcap::PacketHeader const *>(this->it);
+			if (this->end - this->it - int(sizeof(pcap::PacketHeader)) < int64_t(header->incl_len))
+				return false;
+			this->it += sizeof(pcap::PacketHeader) + header->incl_len;
+			packet.timestamp = uint64_t(header->ts_sec) * 1000000
+				+ (this->nanoseconds ? header->ts_usec / 1000 : header->ts_usec);
+			packet.length = header->incl_len;
+			packet.data = reinterpret_cast<uint8_t const *>(header + 1);
+			return true;
+		}
+
+		// pcapng
+		while (this->end - this->it >= int(sizeof(pcapng::BlockHeader))) {
+			auto block = this->it;
+			auto &header = *reinterpret_cast<pcapng::BlockHeader const *>(block);
+			if (header.totalLength < sizeof(pcapng::BlockHeader) + 4 || (header.totalLength & 3) != 0
+				|| this->end - block < int64_t(header.totalLength))
+			{
+				return false;
+			}
+			this->it += header.totalLength;
+
+			// body of the block up to the total length at the end
+			int bodyLength = header.totalLength - 4;
+			switch (header.type) {
+			case pcapng::BlockType::SECTION_HEADER:
+				if (bodyLength < int(sizeof(pcapng::SectionHeader))
+					|| reinterpret_cast<pcapng::SectionHeader const *>(block)->byteOrderMagic != 0x1A2B3C4D)
+				{
+					Terminal::err << "error: byte order not supported!\n";
+					this->it = this->end;
+					return false;
+				}
+
+				// interface ids start at zero in each section
+				this->interfaces.clear();
+				break;
+			case pcapng::BlockType::INTERFACE_DESCRIPTION:
+				if (bodyLength >= int(sizeof(pcapng::InterfaceDescription))) {
+					auto &description = *reinterpret_cast<pcapng::InterfaceDescription const *>(block);
+					Interface interface = {description.linkType == uint16_t(pcap::Network::IEEE802_15_4), 1000000};
+
+					// options
+					int offset = sizeof(pcapng::InterfaceDescription);
+					while (offset + int(sizeof(pcapng::OptionHeader)) <= bodyLength) {
+						auto &option = *reinterpret_cast<pcapng::OptionHeader const *>(block + offset);
+						offset += sizeof(pcapng::OptionHeader);
+						if (option.code == pcapng::OptionCode::END_OF_OPTIONS || offset + option.length > bodyLength)
+							break;
+						if (option.code == pcapng::OptionCode::IF_TSRESOL && option.length >= 1) {
+							// negative power of 10 or of 2 if the msb is set
+							int resolution = block[offset];
+							uint64_t unitsPerSecond = 1;
+							for (int i = 0; i < (resolution & 0x7f); ++i)
+								unitsPerSecond *= (resolution & 0x80) == 0 ? 10 : 2;
+							interface.unitsPerSecond = unitsPerSecond;
+						}
+						offset += (option.length + 3) & ~3;
+					}
+					this->interfaces.push_back(interface);
+				} else {
+					this->interfaces.push_back({false, 1000000});
+				}
+				break;
+			case pcapng::BlockType::ENHANCED_PACKET:
+				if (bodyLength >= int(sizeof(pcapng::EnhancedPacket))) {
+					auto &enhanced = *reinterpret_cast<pcapng::EnhancedPacket const *>(block);
+					if (enhanced.interfaceId >= this->interfaces.size() || !this->interfaces[enhanced.interfaceId].ieee
+						|| enhanced.capturedLength > bodyLength - sizeof(pcapng::EnhancedPacket))
+					{
+						break;
+					}
+
+					// convert timestamp to microseconds
+					uint64_t timestamp = uint64_t(enhanced.timestampHigh) << 32 | enhanced.timestampLow;
+					uint64_t unitsPerSecond = this->interfaces[enhanced.interfaceId].unitsPerSecond;
+					packet.timestamp = timestamp / unitsPerSecond * 1000000
+						+ timestamp % unitsPerSecond * 1000000 / unitsPerSecond;
+					packet.length = enhanced.capturedLength;
+					packet.data = block + sizeof(pcapng::EnhancedPacket);
+					return true;
+				}
+				break;
+			default:
+				// skip other blocks such as interface statistics
+				break;
+			}
+		}
+		return false;
+	}
+
+protected:
+	// interface of a pcapng section
+	struct Interface {
+		// link type is IEEE 802.15.4
+		bool ieee;
+
+		// timestamp resolution
+		uint64_t unitsPerSecond;
+	};
+
+	uint8_t const *begin = nullptr;
+	uint8_t const *end = nullptr;
+	uint8_t const *it = nullptr;
+
+	// pcap: timestamps in nanoseconds instead of microseconds
+	bool nanoseconds = false;
+
+	// pcapng: interfaces of the current section
+	bool ng = false;
+	std::vector<Interface> interfaces;
+};
+
+
+// Batch Analysis
+// --------------
+// Offline analysis of a large capture: The capture file is memory mapped, packets are decoded and decrypted by worker
+// threads without per-packet output and the results are written in timestamp order
+
+// type of a source address
+enum class AddressType : uint8_t {
+	NONE,
+	MAC_SHORT,
+	MAC_LONG,
+	ZBEE,
+	GP
+};
+
+using Address = std::pair<AddressType, uint64_t>;
+
+// result of the analysis of one packet
+enum class BatchStatus : uint8_t {
+	// packet is not encrypted
+	PLAIN,
+
+	// packet was decrypted or its message integrity code was checked
+	DECRYPTED,
+
+	// no key is known for the packet
+	NO_KEY,
+
+	// decryption or check of message integrity code failed
+	DECRYPT_ERROR,
+
+	// packet is too short or has an unknown format
+	MALFORMED
+};
+constexpr int BATCH_STATUS_COUNT = 5;
+
+// packet in the mapped capture file
+struct BatchPacket {
+	FilePacket captured;
+
+	// source address and status, filled in by the worker threads
+	Address source;
+	BatchStatus status;
+};
+
+// buffer for decoding a packet, reused for each chunk of packets
+struct BatchBuffer {
+	// packet with security header and message integrity code removed if it was decrypted
+	int length;
+	uint8_t data[sizeof(Packet::data)];
+};
+
+// traffic statistics of one source address
+struct BatchStatistics {
+	int packetCount = 0;
+	int byteCount = 0;
+	int statusCounts[BATCH_STATUS_COUNT] = {};
+
+	void add(BatchStatus status, int length) {
+		++this->packetCount;
+		this->byteCount += length;
+		++this->statusCounts[int(status)];
+	}
+
+	void add(BatchStatistics const &s) {
+		this->packetCount += s.packetCount;
+		this->byteCount += s.byteCount;
+		for (int i = 0; i < BATCH_STATUS_COUNT; ++i)
+			this->statusCounts[i] += s.statusCounts[i];
+	}
+};
+
+using BatchStatisticsMap = std::map<Address, BatchStatistics>;
+
+// green power key that is valid starting at the packet with the given index
+struct BatchGpKey {
+	int index;
+	AesKey aesKey;
+};
+
+// keys of green power devices in order of commissioning, read-only while the worker threads are running
+std::map<uint32_t, std::vector<BatchGpKey>> batchGpKeys;
+
+// number of packets that are processed by the worker threads in one go
+constexpr int BATCH_CHUNK_SIZE = 65536;
+
+
+// parse the mac header, returns false if the packet is no data frame
+bool readMacHeader(PacketReader &r, Address &source) {
+	auto frameControl = r.e16L<ieee::FrameControl>();
+	if ((frameControl & ieee::FrameControl::SEQUENCE_NUMBER_SUPPRESSION) == 0)
+		r.u8();
+
+	// destination pan/address
+	bool haveDestination = (frameControl & ieee::FrameControl::DESTINATION_ADDRESSING_FLAG) != 0;
+	if (haveDestination) {
+		r.skip((frameControl & ieee::FrameControl::DESTINATION_ADDRESSING_LONG_FLAG) == 0 ? 2 + 2 : 2 + 8);
+	}
+
+	// source pan/address
+	if ((frameControl & ieee::FrameControl::SOURCE_ADDRESSING_FLAG) != 0) {
+		if ((frameControl & ieee::FrameControl::PAN_ID_COMPRESSION) == 0 || !haveDestination)
+			r.skip(2);
+		if ((frameControl & ieee::FrameControl::SOURCE_ADDRESSING_LONG_FLAG) == 0)
+			source = {AddressType::MAC_SHORT, r.u16L()};
+		else
+			source = {AddressType::MAC_LONG, r.u64L()};
+	}
+
+	return (frameControl & ieee::FrameControl::TYPE_MASK) == ieee::FrameControl::TYPE_DATA && r.getRemaining() > 0;
+}
+
+// decrypt a nwk frame and remove the security header and message integrity code
+BatchStatus analyzeNwk(PacketReader &r, BatchPacket &packet, BatchBuffer &buffer) {
+	// nwk header (encryption header starts here)
+	uint8_t *nwk = r.current;
+	r.setHeader();
+
+	auto frameControl = r.e16L<zb::NwkFrameControl>();
+	r.u16L(); // destination
+	packet.source = {AddressType::ZBEE, r.u16L()};
+	r.skip(2); // radius, counter
+	if ((frameControl & zb::NwkFrameControl::DESTINATION) != 0)
+		r.skip(8);
+	if ((frameControl & zb::NwkFrameControl::EXTENDED_SOURCE) != 0)
+		r.skip(8);
+	if ((frameControl & zb::NwkFrameControl::SOURCE_ROUTE) != 0) {
+		uint8_t relayCount = r.u8();
+		r.skip(1 + relayCount * 2);
+	}
+	if ((frameControl & zb::NwkFrameControl::SECURITY) == 0)
+		return r.isValid() ? BatchStatus::PLAIN : BatchStatus::MALFORMED;
+
+	// security header
+	uint8_t *securityHeader = r.current;
+	if (r.getRemaining() < 1 + 4 + 8 + 1 + 4)
+		return BatchStatus::MALFORMED;
+	r.restoreSecurityLevel(securityLevel);
+	auto securityControl = r.e8<zb::SecurityControl>();
+	if ((securityControl & zb::SecurityControl::KEY_MASK) != zb::SecurityControl::KEY_NETWORK
+		|| (securityControl & zb::SecurityControl::EXTENDED_NONCE) == 0)
+	{
+		return BatchStatus::NO_KEY;
+	}
+	uint32_t securityCounter = r.u32L();
+	uint8_t const *extendedSource = r.current;
+	r.skip(8 + 1);
+	Nonce nonce(extendedSource, securityCounter, securityControl);
+
+	// decrypt in-place
+	r.setMessage();
+	if (!r.decrypt(4, nonce, networkAesKey))
+		return BatchStatus::DECRYPT_ERROR;
+
+	// remove security header and clear security flag so that the packet can be read by other tools
+	int payloadLength = r.getRemaining();
+	std::memmove(securityHeader, r.current, payloadLength);
+	nwk[0 + 1] &= ~uint8_t(uint16_t(zb::NwkFrameControl::SECURITY) >> 8);
+	buffer.length = securityHeader + payloadLength - buffer.data;
+	return BatchStatus::DECRYPTED;
+}
+
+// decrypt a green power frame and remove security counter and message integrity code
+BatchStatus analyzeGp(uint8_t const *mac, PacketReader &r, int index, BatchPacket &packet, BatchBuffer &buffer) {
+	// zgp stub nwk header (encryption header starts here)
+	r.setHeader();
+	auto frameControl = r.e8<gp::NwkFrameControl>();
+	uint8_t *extended = nullptr;
+	auto securityLevel = gp::NwkExtendedFrameControl::SECURITY_LEVEL_NONE;
+	if ((frameControl & gp::NwkFrameControl::EXTENDED) != 0) {
+		extended = r.current;
+		securityLevel = r.e8<gp::NwkExtendedFrameControl>() & gp::NwkExtendedFrameControl::SECURITY_LEVEL_MASK;
+	}
+	uint32_t deviceId = r.u32L();
+	if (!r.isValid())
+		return BatchStatus::MALFORMED;
+	packet.source = {AddressType::GP, deviceId};
+	if (securityLevel == gp::NwkExtendedFrameControl::SECURITY_LEVEL_NONE)
+		return BatchStatus::PLAIN;
+
+	// find the key that was valid when the packet was received
+	auto it = batchGpKeys.find(deviceId);
+	if (it == batchGpKeys.end() || it->second.front().index > index)
+		return BatchStatus::NO_KEY;
+	auto &keys = it->second;
+	auto key = std::upper_bound(keys.begin(), keys.end(), index,
+		[](int index, BatchGpKey const &key) {return index < key.index;}) - 1;
+
+	// same security levels as in handleGp()
+	uint8_t *counter = r.current;
+	uint32_t securityCounter;
+	int micLength;
+	switch (securityLevel) {
+	case gp::NwkExtendedFrameControl::SECURITY_LEVEL_CNT8_MIC16:
+		r.setHeader(mac + 2);
+		securityCounter = mac[2];
+		micLength = 2;
+		r.setMessageFromEnd(micLength);
+		break;
+	case gp::NwkExtendedFrameControl::SECURITY_LEVEL_CNT32_MIC32:
+		securityCounter = r.u32L();
+		micLength = 4;
+		r.setMessageFromEnd(micLength);
+		break;
+	case gp::NwkExtendedFrameControl::SECURITY_LEVEL_ENC_CNT32_MIC32:
+		securityCounter = r.u32L();
+		r.setMessage();
+		micLength = 4;
+		break;
+	default:
+		return BatchStatus::MALFORMED;
+	}
+	if (r.getRemaining() < micLength)
+		return BatchStatus::MALFORMED;
+
+	Nonce nonce(deviceId, securityCounter);
+	if (!r.decrypt(micLength, nonce, key->aesKey))
+		return BatchStatus::DECRYPT_ERROR;
+
+	// remove security counter and message integrity code and clear security level (level 1 keeps its 2 byte mic
+	// as the counter is the mac sequence number)
+	if (securityLevel != gp::NwkExtendedFrameControl::SECURITY_LEVEL_CNT8_MIC16) {
+		int payloadLength = r.getRemaining();
+		std::memmove(counter, r.current, payloadLength);
+		*extended &= ~uint8_t(gp::NwkExtendedFrameControl::SECURITY_LEVEL_MASK);
+		buffer.length = counter + payloadLength - buffer.data;
+	}
+	return BatchStatus::DECRYPTED;
+}
+
+// analyze one packet without printing, called by the worker threads
+void analyzePacket(BatchPacket &packet, int index, BatchBuffer &buffer) {
+	auto &captured = packet.captured;
+	buffer.length = min(captured.length, int(sizeof(buffer.data)));
+	std::memcpy(buffer.data, captured.data, buffer.length);
+	packet.source = {AddressType::NONE, 0};
+
+	PacketReader r(buffer.length, buffer.data);
+	uint8_t const *mac = r.current;
+	if (!readMacHeader(r, packet.source)) {
+		if (r.isValid()) {
+			packet.status = BatchStatus::PLAIN;
+		} else {
+			packet.source = {AddressType::NONE, 0};
+			packet.status = BatchStatus::MALFORMED;
+		}
+		return;
+	}
+
+	BatchStatus status;
+	auto version = r.peekE8<gp::NwkFrameControl>() & gp::NwkFrameControl::VERSION_MASK;
+	switch (version) {
+	case gp::NwkFrameControl::VERSION_2:
+		status = analyzeNwk(r, packet, buffer);
+		break;
+	case gp::NwkFrameControl::VERSION_3_GP:
+		status = analyzeGp(mac, r, index, packet, buffer);
+		break;
+	default:
+		status = BatchStatus::MALFORMED;
+	}
+
+	// keep the original packet if it was not decrypted (in-place decryption may have destroyed it)
+	if (status != BatchStatus::PLAIN && status != BatchStatus::DECRYPTED) {
+		buffer.length = min(captured.length, int(sizeof(buffer.data)));
+		std::memcpy(buffer.data, captured.data, buffer.length);
+	}
+	packet.status = status;
+}
+
+// sequential pass that collects the keys of commissioned green power devices
+void collectGpKeys(std::vector<BatchPacket> const &packets) {
+	uint8_t data[sizeof(Packet::data)];
+	int count = packets.size();
+	for (int index = 0; index < count; ++index) {
+		auto &captured = packets[index].captured;
+		int length = min(captured.length, int(sizeof(data)));
+		std::memcpy(data, captured.data, length);
+		PacketReader r(length, data);
+		Address source;
+		if (!readMacHeader(r, source)
+			|| (r.peekE8<gp::NwkFrameControl>() & gp::NwkFrameControl::VERSION_MASK) != gp::NwkFrameControl::VERSION_3_GP)
+		{
+			continue;
+		}
+
+		// only unsecured commissioning commands
+		auto frameControl = r.e8<gp::NwkFrameControl>();
+		if ((frameControl & gp::NwkFrameControl::EXTENDED) != 0 && (r.e8<gp::NwkExtendedFrameControl>()
+			& gp::NwkExtendedFrameControl::SECURITY_LEVEL_MASK) != gp::NwkExtendedFrameControl::SECURITY_LEVEL_NONE)
+		{
+			continue;
+		}
+		uint32_t deviceId = r.u32L();
+		if (r.getRemaining() <= 0 || r.peekE8<gp::Command>() != gp::Command::COMMISSIONING)
+			continue;
+
+		GpCommissioning commissioning;
+		if (readGpCommissioning(deviceId, r, commissioning) && commissioning.haveKey) {
+			BatchGpKey key;
+			key.index = index;
+			setKey(key.aesKey, Array<uint8_t const, 16>(commissioning.key));
+			batchGpKeys[deviceId].push_back(key);
+		}
+	}
+}
+
+// print a number right aligned in a column of the summary
+void printColumn(int value, int width) {
+	char buffer[11];
+	String s = toString(buffer, value);
+	for (int i = s.count(); i < width; ++i)
+		Terminal::out << ' ';
+	Terminal::out << s;
+}
+
+// print an address of the summary
+void printAddress(Address const &address) {
+	switch (address.first) {
+	case AddressType::NONE:
+		Terminal::out << "(none)              ";
+		break;
+	case AddressType::MAC_SHORT:
+		Terminal::out << "MAC " << hex(uint16_t(address.second)) << "            ";
+		break;
+	case AddressType::MAC_LONG:
+		Terminal::out << "MAC " << hex(address.second);
+		break;
+	case AddressType::ZBEE:
+		Terminal::out << "NWK " << hex(uint16_t(address.second)) << "            ";
+		break;
+	case AddressType::GP:
+		Terminal::out << "GP  " << hex(uint32_t(address.second)) << "        ";
+		break;
+	}
+}
+
+/**
+ * Analyze a capture file using multiple threads
+ * @param inputFile input .pcap or .pcapng file
+ * @param outputFile output pcap file for decrypted packets, no output if empty
+ * @param filter only write packets whose source address (mac, nwk or gp) has this value to the output, -1 for all
+ * @param threadCount number of worker threads
+ * @return exit code
+ */
+int analyzeBatch(fs::path const &inputFile, fs::path const &outputFile, int64_t filter, int threadCount) {
+	// map input file
+	CaptureReader reader;
+	if (!reader.open(inputFile))
+		return 1;
+
+	// index packets and sort them by timestamp (stable to keep the order of packets with the same timestamp)
+	std::vector<BatchPacket> packets;
+	FilePacket captured;
+	while (reader.read(captured))
+		packets.emplace_back().captured = captured;
+	std::stable_sort(packets.begin(), packets.end(), [](BatchPacket const &a, BatchPacket const &b) {
+		return a.captured.timestamp < b.captured.timestamp;
+	});
+	int packetCount = packets.size();
+
+	// collect keys of green power devices which depend on the order of packets
+	collectGpKeys(packets);
+
+	// open output pcap file
+	FILE *file = nullptr;
+	if (!outputFile.empty()) {
+		file = fopen(outputFile.string().c_str(), "wb");
+		if (file == nullptr) {
+			Terminal::err << "error: can't write pcap file " << str(outputFile.string().c_str()) << "\n";
+		} else {
+			pcap::Header header = {0xa1b2c3d4, 2, 4, 0, 0, 128, pcap::Network::IEEE802_15_4};
+			fwrite(&header, sizeof(header), 1, file);
+		}
+	}
+
+	// decoded packets are only kept until the chunk is written, without output each thread reuses one buffer
+	bool keep = file != nullptr;
+	std::vector<BatchBuffer> buffers(keep ? BATCH_CHUNK_SIZE : threadCount);
+
+	// process chunks of packets in parallel, then write the chunk in order
+	std::vector<BatchStatisticsMap> threadStatistics(threadCount);
+	int writeCount = 0;
+	for (int chunk = 0; chunk < packetCount; chunk += BATCH_CHUNK_SIZE) {
+		int chunkEnd = min(chunk + BATCH_CHUNK_SIZE, packetCount);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; ++t) {
+			threads.emplace_back([&packets, &buffers, &statistics = threadStatistics[t], keep, chunk, chunkEnd, t,
+				threadCount]()
+			{
+				// interleave packets so that all threads get a similar mix of encrypted and plain packets
+				for (int index = chunk + t; index < chunkEnd; index += threadCount) {
+					auto &packet = packets[index];
+					analyzePacket(packet, index, buffers[keep ? index - chunk : t]);
+					statistics[packet.source].add(packet.status, packet.captured.length);
+				}
+			});
+		}
+		for (auto &thread : threads)
+			thread.join();
+
+		if (file != nullptr) {
+			for (int index = chunk; index < chunkEnd; ++index) {
+				auto &packet = packets[index];
+				if (filter != -1 && (packet.source.first == AddressType::NONE || packet.source.second != uint64_t(filter)))
+					continue;
+				auto &buffer = buffers[index - chunk];
+				uint64_t timestamp = packet.captured.timestamp;
+				pcap::PacketHeader packetHeader;
+				packetHeader.ts_sec = uint32_t(timestamp / 1000000);
+				packetHeader.ts_usec = uint32_t(timestamp % 1000000);
+				packetHeader.incl_len = buffer.length;
+				packetHeader.orig_len = buffer.length + 2; // 2 byte crc
+				fwrite(&packetHeader, sizeof(packetHeader), 1, file);
+				fwrite(buffer.data, 1, buffer.length, file);
+				++writeCount;
+			}
+		}
+	}
+	if (file != nullptr) {
+		fclose(file);
+		Terminal::out << "wrote " << dec(writeCount) << " packets to " << str(outputFile.string().c_str()) << "\n";
+	}
+
+	// merge statistics of the worker threads
+	BatchStatisticsMap statistics;
+	BatchStatistics total;
+	for (auto &s : threadStatistics) {
+		for (auto &p : s) {
+			statistics[p.first].add(p.second);
+			total.add(p.second);
+		}
+	}
+
+	// print summary
+	Terminal::out << dec(packetCount) << " packets, " << dec(batchGpKeys.size()) << " commissioned GP devices, "
+		<< dec(threadCount) << " threads\n";
+	Terminal::out << "Source                 Packets      Bytes     Plain Decrypted     NoKey     Error Malformed\n";
+	for (auto &p : statistics) {
+		auto &s = p.second;
+		printAddress(p.first);
+		printColumn(s.packetCount, 10);
+		printColumn(s.byteCount, 11);
+		for (int i = 0; i < BATCH_STATUS_COUNT; ++i)
+			printColumn(s.statusCounts[i], 10);
+		Terminal::out << '\n';
+	}
+	int errorCount = total.statusCounts[int(BatchStatus::DECRYPT_ERROR)];
+	int malformedCount = total.statusCounts[int(BatchStatus::MALFORMED)];
+	Terminal::out << "decrypt errors: " << dec(errorCount) << ", malformed: " << dec(malformedCount) << '\n';
+	return 0;
+}
+
+
+// Live Capture
+// ------------
+// Asynchronous usb transfers only copy received packets into a ring buffer so that the radio is read without delay.
+// A writer thread takes the packets out of the ring buffer, writes them to pcapng files and dissects them
+
+// packet in the capture ring buffer
+struct CapturePacket {
+	// timestamp in microseconds since 1970
+	uint64_t timestamp;
+
+	// link quality indicator
+	uint8_t lqi;
+
+	int length;
+	uint8_t data[sizeof(Packet::data)];
+};
+
+// number of packets in the capture ring buffer
+constexpr int CAPTURE_RING_SIZE = 4096;
+
+// number of usb transfers that are queued at the same time
+constexpr int CAPTURE_TRANSFER_COUNT = 8;
+
+// interval in which the writer thread checks for new packets when idle
+constexpr auto CAPTURE_IDLE_INTERVAL = std::chrono::milliseconds(5);
+
+// state shared between the usb transfers (producer) and the writer thread (consumer)
+struct Capture {
+	RingBuffer<CapturePacket, CAPTURE_RING_SIZE> ring;
+
+	// number of packets received from the radio including dropped packets
+	std::atomic<uint64_t> receivedCount = 0;
+
+	// number of packets dropped because the ring buffer was full
+	std::atomic<uint64_t> droppedCount = 0;
+
+	// number of failed usb transfers
+	std::atomic<uint64_t> errorCount = 0;
+
+	// number of usb transfers that are submitted, only used by the usb thread
+	int activeTransferCount = 0;
+
+	// conversion of 32 bit microsecond timestamps of the radio into absolute time, only used by the usb thread
+	bool haveTimestamp = false;
+	uint32_t radioTimestamp;
+	uint64_t timestamp;
+
+	// set to false to stop the capture
+	std::atomic<bool> running = true;
+
+	// set to true when all usb transfers have stopped
+	std::atomic<bool> finished = false;
+};
+
+Capture *volatile activeCapture = nullptr;
+
+void onSignal(int) {
+	if (activeCapture != nullptr)
+		activeCapture->running = false;
+}
+
+uint64_t getSystemTimestamp() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// called by libusb when a transfer is complete, copies the packet into the ring buffer and submits the transfer again
+void LIBUSB_CALL onTransfer(libusb_transfer *transfer) {
+	auto &capture = *reinterpret_cast<Capture *>(transfer->user_data);
+	if (transfer->status == LIBUSB_TRANSFER_COMPLETED) {
+		// packet is followed by lqi and 32 bit timestamp
+		int length = transfer->actual_length - 5;
+		if (length > 0) {
+			uint8_t const *ts = transfer->buffer + length + 1;
+			uint32_t radioTimestamp = ts[0] | (ts[1] << 8) | (ts[2] << 16) | (ts[3] << 24);
+			if (!capture.haveTimestamp) {
+				capture.haveTimestamp = true;
+				capture.timestamp = getSystemTimestamp();
+			} else {
+				// unsigned difference handles the wrap around of the 32 bit timestamp
+				capture.timestamp += uint32_t(radioTimestamp - capture.radioTimestamp);
+			}
+			capture.radioTimestamp = radioTimestamp;
+
+			++capture.receivedCount;
+			auto packet = capture.ring.getNextBack();
+			if (packet != nullptr) {
+				packet->timestamp = capture.timestamp;
+				packet->lqi = transfer->buffer[length];
+				packet->length = min(length, int(sizeof(packet->data)));
+				std::memcpy(packet->data, transfer->buffer, packet->length);
+				capture.ring.addBack();
+			} else {
+				++capture.droppedCount;
+			}
+		}
+	} else if (transfer->status != LIBUSB_TRANSFER_CANCELLED) {
+		++capture.errorCount;
+		if (transfer->status == LIBUSB_TRANSFER_NO_DEVICE)
+			capture.running = false;
+	}
+
+	// submit again
+	if (capture.running && libusb_submit_transfer(transfer) == LIBUSB_SUCCESS)
+		return;
+	--capture.activeTransferCount;
+}
+
+// writes pcapng files and starts a new file when the size or time limit is reached
+class PcapngWriter {
+public:
+	/**
+	 * Constructor
+	 * @param path path of output file, an index is appended to the name when rotating
+	 * @param rotateSize size in bytes after which a new file is started, 0 for no limit
+	 * @param rotateTime time in seconds after which a new file is started, 0 for no limit
+	 */
+	PcapngWriter(fs::path const &path, int64_t rotateSize, int rotateTime)
+		: path(path), rotateSize(rotateSize), rotateTime(uint64_t(rotateTime) * 1000000) {}
+
+	~PcapngWriter() {close(0, 0);}
+
+	/**
+	 * Write a packet
+	 * @param timestamp timestamp in microseconds
+	 * @param length length of packet
+	 * @param data packet data
+	 * @param capture counters for the statistics block at the end of each file
+	 */
+	void write(uint64_t timestamp, int length, uint8_t const *data, Capture const &capture) {
+		// start a new file if limits are exceeded
+		if (this->file != nullptr && ((this->rotateSize > 0 && this->fileSize >= this->rotateSize)
+			|| (this->rotateTime > 0 && timestamp - this->fileTimestamp >= this->rotateTime)))
+		{
+			close(capture.receivedCount, capture.droppedCount);
+		}
+		if (this->file == nullptr && !open(timestamp))
+			return;
+
+		int paddedLength = (length + 3) & ~3;
+		pcapng::EnhancedPacket block;
+		block.header.type = pcapng::BlockType::ENHANCED_PACKET;
+		block.header.totalLength = sizeof(block) + paddedLength + 4;
+		block.interfaceId = 0;
+		block.timestampHigh = uint32_t(timestamp >> 32);
+		block.timestampLow = uint32_t(timestamp);
+		block.capturedLength = length;
+		block.originalLength = length + 2; // 2 byte crc not transferred
+		uint32_t padding = 0;
+		fwrite(&block, sizeof(block), 1, this->file);
+		fwrite(data, 1, length, this->file);
+		fwrite(&padding, 1, paddedLength - length, this->file);
+		fwrite(&block.header.totalLength, 4, 1, this->file);
+		this->fileSize += block.header.totalLength;
+		this->lastTimestamp = timestamp;
+	}
+
+	/**
+	 * Flush written packets to the file, e.g. when idle
+	 */
+	void flush() {
+		if (this->file != nullptr)
+			fflush(this->file);
+	}
+
+	/**
+	 * Write the statistics block and close the current file
+	 * @param receivedCount number of received packets since start of capture
+	 * @param droppedCount number of dropped packets since start of capture
+	 */
+	void close(uint64_t receivedCount, uint64_t droppedCount) {
+		if (this->file == nullptr)
+			return;
+
+		// interface statistics block with options for received and dropped packets (assembled in a buffer as the 64
+		// bit option values are only 32 bit aligned)
+		pcapng::InterfaceStatistics statistics;
+		pcapng::OptionHeader received = {pcapng::OptionCode::ISB_IFRECV, 8};
+		pcapng::OptionHeader dropped = {pcapng::OptionCode::ISB_IFDROP, 8};
+		pcapng::OptionHeader end = {pcapng::OptionCode::END_OF_OPTIONS, 0};
+		uint32_t totalLength = sizeof(statistics) + 2 * (4 + 8) + sizeof(end) + 4;
+		statistics.header = {pcapng::BlockType::INTERFACE_STATISTICS, totalLength};
+		statistics.interfaceId = 0;
+		statistics.timestampHigh = uint32_t(this->lastTimestamp >> 32);
+		statistics.timestampLow = uint32_t(this->lastTimestamp);
+
+		uint8_t block[sizeof(statistics) + 2 * (4 + 8) + sizeof(end) + 4];
+		uint8_t *it = block;
+		auto append = [&it](void const *data, int size) {
+			std::memcpy(it, data, size);
+			it += size;
+		};
+		append(&statistics, sizeof(statistics));
+		append(&received, 4);
+		append(&receivedCount, 8);
+		append(&dropped, 4);
+		append(&droppedCount, 8);
+		append(&end, 4);
+		append(&totalLength, 4);
+		fwrite(block, sizeof(block), 1, this->file);
+
+		fclose(this->file);
+		this->file = nullptr;
+	}
+
+protected:
+	bool open(uint64_t timestamp) {
+		// append index to file name if rotation is enabled
+		fs::path path = this->path;
+		if (this->rotateSize > 0 || this->rotateTime > 0) {
+			char index[16];
+			snprintf(index, sizeof(index), "_%04d", this->fileIndex);
+			path.replace_filename(this->path.stem().string() + index + this->path.extension().string());
+		}
+		++this->fileIndex;
+		this->file = fopen(path.string().c_str(), "wb");
+		if (this->file == nullptr) {
+			Terminal::err << "error: can't write " << str(path.string().c_str()) << "\n";
+			return false;
+		}
+		Terminal::out << "capturing to " << str(path.string().c_str()) << "\n";
+
+		// section header block
+		pcapng::SectionHeader section;
+		uint32_t sectionLength = sizeof(section) + 4;
+		section.header = {pcapng::BlockType::SECTION_HEADER, sectionLength};
+		section.byteOrderMagic = 0x1A2B3C4D;
+		section.majorVersion = 1;
+		section.minorVersion = 0;
+		section.sectionLength = -1;
+		fwrite(&section, sizeof(section), 1, this->file);
+		fwrite(&sectionLength, 4, 1, this->file);
+
+		// interface description block with microsecond timestamp resolution
+		struct {
+			pcapng::InterfaceDescription interface;
+			pcapng::OptionHeader tsresol;
+			uint8_t tsresolValue[4];
+			pcapng::OptionHeader end;
+			uint32_t totalLength;
+		} interface;
+		interface.interface.header = {pcapng::BlockType::INTERFACE_DESCRIPTION, sizeof(interface)};
+		interface.interface.linkType = uint16_t(pcap::Network::IEEE802_15_4);
+		interface.interface.reserved = 0;
+		interface.interface.snapLength = 128;
+		interface.tsresol = {pcapng::OptionCode::IF_TSRESOL, 1};
+		interface.tsresolValue[0] = 6;
+		interface.tsresolValue[1] = interface.tsresolValue[2] = interface.tsresolValue[3] = 0;
+		interface.end = {pcapng::OptionCode::END_OF_OPTIONS, 0};
+		interface.totalLength = sizeof(interface);
+		fwrite(&interface, sizeof(interface), 1, this->file);
+
+		this->fileSize = sectionLength + sizeof(interface);
+		this->fileTimestamp = timestamp;
+		return true;
+	}
+
+	fs::path path;
+	int64_t rotateSize;
+	uint64_t rotateTime;
+
+	FILE *file = nullptr;
+	int fileIndex = 0;
+	int64_t fileSize;
+	uint64_t fileTimestamp;
+	uint64_t lastTimestamp = 0;
+};
+
+/**
+ * Writer thread: Write packets from the ring buffer to pcapng files and dissect them
+ * @param capture capture state
+ * @param writer writer for pcapng files, nullptr if no output file
+ * @param quiet don't dissect packets
+ */
+void writePackets(Capture &capture, PcapngWriter *writer, bool quiet) {
+	uint64_t reportedDroppedCount = 0;
+	uint64_t startTimestamp = 0;
+	while (true) {
+		auto packet = capture.ring.getFront();
+		if (packet == nullptr) {
+			// idle: report dropped packets and flush the output file
+			uint64_t droppedCount = capture.droppedCount;
+			if (droppedCount != reportedDroppedCount) {
+				Terminal::err << "warning: " << dec(droppedCount - reportedDroppedCount)
+					<< " packets dropped (ring buffer full)\n";
+				reportedDroppedCount = droppedCount;
+			}
+			if (writer != nullptr)
+				writer->flush();
+
+			// stop when the usb transfers have stopped and all packets are written
+			if (capture.finished && capture.ring.isEmpty())
+				break;
+			std::this_thread::sleep_for(CAPTURE_IDLE_INTERVAL);
+			continue;
+		}
+
+		if (writer != nullptr)
+			writer->write(packet->timestamp, packet->length, packet->data, capture);
+
+		if (!quiet) {
+			if (startTimestamp == 0)
+				startTimestamp = packet->timestamp;
+			uint64_t timestamp = packet->timestamp - startTimestamp;
+			Terminal::out << ("length: " + dec(packet->length) + ", LQI: " + dec(packet->lqi) + '\n');
+			Terminal::out << ("timestamp: " + dec(timestamp / 1000000 % 86400) + "." + dec(timestamp % 1000000, 6) + '\n');
+
+			// dissect (in-place decryption modifies the packet, therefore after writing)
+			PacketReader r(packet->length, packet->data);
+			handleIeee(r);
+		}
+
+		capture.ring.removeFront();
+	}
+	if (writer != nullptr)
+		writer->close(capture.receivedCount, capture.droppedCount);
+}
+
+/**
+ * Capture packets from the radio until interrupted
+ * @param handle usb device handle, radio is already configured
+ * @param outputFile output file, no output if empty
+ * @param rotateSize size in bytes after which a new output file is started, 0 for no limit
+ * @param rotateTime time in seconds after which a new output file is started, 0 for no limit
+ * @param quiet don't dissect packets
+ */
+void capturePackets(libusb_device_handle *handle, fs::path const &outputFile, int64_t rotateSize, int rotateTime,
+	bool quiet)
+{
+	auto capture = std::make_unique<Capture>();
+	std::unique_ptr<PcapngWriter> writer;
+	if (!outputFile.empty())
+		writer = std::make_unique<PcapngWriter>(outputFile, rotateSize, rotateTime);
+
+	// stop on ctrl-c
+	activeCapture = capture.get();
+	signal(SIGINT, onSignal);
+	signal(SIGTERM, onSignal);
+
+	// start writer thread
+	std::thread writerThread(writePackets, std::ref(*capture), writer.get(), quiet);
+
+	// submit usb transfers
+	libusb_transfer *transfers[CAPTURE_TRANSFER_COUNT];
+	uint8_t buffers[CAPTURE_TRANSFER_COUNT][sizeof(Packet::data)];
+	for (int i = 0; i < CAPTURE_TRANSFER_COUNT; ++i) {
+		auto transfer = transfers[i] = libusb_alloc_transfer(0);
+		libusb_fill_bulk_transfer(transfer, handle, 1 | usb::IN, buffers[i], sizeof(buffers[i]), onTransfer,
+			capture.get(), 0);
+		int ret = libusb_submit_transfer(transfer);
+		if (ret != LIBUSB_SUCCESS)
+			Terminal::err << ("submit transfer error: " + dec(ret) + '\n');
+		else
+			++capture->activeTransferCount;
+	}
+	if (capture->activeTransferCount == 0)
+		capture->running = false;
+
+	// handle usb events until interrupted, the transfer callbacks are called from here
+	while (capture->running) {
+		timeval timeout = {0, 100000};
+		libusb_handle_events_timeout_completed(nullptr, &timeout, nullptr);
+	}
+
+	// cancel transfers and wait until all callbacks have returned
+	for (auto transfer : transfers)
+		libusb_cancel_transfer(transfer);
+	while (capture->activeTransferCount > 0) {
+		timeval timeout = {0, 100000};
+		libusb_handle_events_timeout_completed(nullptr, &timeout, nullptr);
+	}
+	for (auto transfer : transfers)
+		libusb_free_transfer(transfer);
+
+	// wait until the writer thread has processed the remaining packets
+	capture->finished = true;
+	writerThread.join();
+	signal(SIGINT, SIG_DFL);
+	signal(SIGTERM, SIG_DFL);
+	activeCapture = nullptr;
+
+	Terminal::out << "received " << dec(capture->receivedCount.load()) << " packets, dropped "
+		<< dec(capture->droppedCount.load()) << ", usb errors " << dec(capture->errorCount.load()) << "\n";
+}
+
+
 int controlTransfer(libusb_device_handle *handle, Radio::Request request, uint16_t wValue, uint16_t wIndex) {
 	return libusb_control_transfer(handle,
 		uint8_t(usb::Request::OUT | usb::Request::TYPE_VENDOR | usb::Request::RECIPIENT_INTERFACE),
@@ -936,6 +2008,12 @@ int main(int argc, char const *argv[]) {
 	fs::path inputFile;
 	fs::path outputFile;
 	bool haveKey = false;
+	bool batch = false;
+	int threadCount = std::thread::hardware_concurrency();
+	int64_t filter = -1;
+	int64_t rotateSize = 0;
+	int rotateTime = 0;
+	bool quiet = false;
 	int radioChannel = 15;
 	auto radioFlags = Radio::ContextFlags::PASS_ALL;
 	for (int i = 1; i < argc; ++i) {
@@ -956,7 +2034,7 @@ int main(int argc, char const *argv[]) {
 			setKey(networkAesKey, key);
 			haveKey = true;
 		} else if (arg == "-i" || arg == "--input") {
-			// input pcap file
+			// input .pcap or .pcapng file
 			++i;
 			inputFile = argv[i];
 		} else if (arg == "-c" || arg == "--channel") {
@@ -966,6 +2044,28 @@ int main(int argc, char const *argv[]) {
 		} else if (arg == "-a" || arg == "--ack") {
 			// ack all received packets
 			radioFlags |= Radio::ContextFlags::HANDLE_ACK;
+		} else if (arg == "-s" || arg == "--rotate-size") {
+			// start a new output file after the given number of megabytes
+			++i;
+			rotateSize = int64_t(atoi(argv[i])) << 20;
+		} else if (arg == "-t" || arg == "--rotate-time") {
+			// start a new output file after the given number of seconds
+			++i;
+			rotateTime = atoi(argv[i]);
+		} else if (arg == "-q" || arg == "--quiet") {
+			// don't print captured packets
+			quiet = true;
+		} else if (arg == "-b" || arg == "--batch") {
+			// analyze input file in parallel and print a summary instead of each packet
+			batch = true;
+		} else if (arg == "-j" || arg == "--threads") {
+			// number of threads for batch analysis
+			++i;
+			threadCount = atoi(argv[i]);
+		} else if (arg == "-f" || arg == "--filter") {
+			// source address of packets to write in batch analysis
+			++i;
+			filter = strtoull(argv[i], nullptr, 16);
 		} else {
 			// output pcap file
 			if (arg == "-o" )
@@ -976,7 +2076,16 @@ int main(int argc, char const *argv[]) {
 	if (!haveKey)
 		Terminal::err << "no network key given (-k x:y:z:...)\n";
 
-	// either read from input .pcap file or from usb device
+	// batch analysis of input file
+	if (batch) {
+		if (inputFile.empty()) {
+			Terminal::err << "error: batch analysis needs an input file (-i file.pcapng)\n";
+			return 1;
+		}
+		return analyzeBatch(inputFile, outputFile, filter, max(threadCount, 1));
+	}
+
+	// either read from input file or from usb device
 	if (inputFile.empty()) {
 		// read from usb
 		int r = libusb_init(NULL);
@@ -1034,7 +2143,6 @@ int main(int argc, char const *argv[]) {
 
 			//ret = libusb_set_interface_alt_setting(handle, 0, 0);
 
-			pcap::Header header;
 			Packet packet;
 			int length;
 
@@ -1048,96 +2156,29 @@ int main(int argc, char const *argv[]) {
 			controlTransfer(handle, Radio::Request::ENABLE_RECEIVER, 1, 0);
 			controlTransfer(handle, Radio::Request::SET_FLAGS, uint16_t(radioFlags), 0);
 
-			// open output pcap file
-			FILE *file = fopen(outputFile.string().c_str(), "wb");
-
-			// write pcap header
-			if (file != nullptr) {
-				Terminal::out << "capturing to " << str(outputFile.string().c_str()) << "\n";
-				header.magic_number = 0xa1b2c3d4;
-				header.version_major = 2;
-				header.version_minor = 4;
-				header.thiszone = 0;
-				header.sigfigs = 0;
-				header.snaplen = 128;
-				header.network = pcap::Network::IEEE802_15_4;
-				fwrite(&header, sizeof(header), 1, file);
-			}
-
-			// loop
+			// capture until interrupted
 			Terminal::out << "waiting for IEEE 802.15.4 packets from device on channel " << dec(radioChannel) << " ...\n";
-			//auto startTime = std::chrono::steady_clock::now();
-			uint32_t startTime = -1;
-			while (true) {
-				// receive from radio
-				ret = libusb_bulk_transfer(handle, 1 | usb::IN, packet.data, sizeof(packet.data), &length, 0);
-				if (ret != LIBUSB_SUCCESS) {
-					Terminal::err << ("transfer error: " + dec(ret) + '\n');
-					break;
-				}
-				length -= 5;
-				Terminal::out << ("length: " + dec(length) + ", LQI: " + dec(packet.data[length]) + '\n');
-				uint8_t const *ts = &packet.data[length + 1];
-				uint32_t timestamp = ts[0] | (ts[1] << 8) | (ts[2] << 16) | (ts[3] << 24);
-				if (startTime == -1)
-					startTime = timestamp;
-				timestamp -= startTime;
-				Terminal::out << ("timestamp: " + dec(timestamp / 1000000) + "." + dec(timestamp % 1000000) + '\n');
-
-				if (length > 0) {
-					// write to pcap file
-					//auto now = std::chrono::steady_clock::now();
-					//auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(now - startTime).count();
-					if (file != nullptr) {
-						packet.header.ts_sec = timestamp / 1000000;
-						packet.header.ts_usec = timestamp % 1000000;
-						packet.header.incl_len = length;
-						packet.header.orig_len = length + 2; // 2 byte crc not transferred
-						fwrite(&packet, 1, sizeof(pcap::PacketHeader) + packet.header.incl_len, file);
-
-						// flush file so that we can interrupt any time
-						fflush(file);
-					}
-
-					// dissect
-					PacketReader r(length, packet.data);
-					handleIeee(r);
-				}
-			}
+			capturePackets(handle, outputFile, rotateSize, rotateTime, quiet);
+			libusb_close(handle);
 			break;
 		}
 		libusb_free_device_list(devs, 1);
 		libusb_exit(NULL);
 	} else {
-		// read from file
-
-		// open input pcap file
-		std::string name = inputFile.string();
-		FILE *file = fopen(name.c_str(), "rb");
-		if (file == nullptr) {
-			Terminal::err << "error: can't read pcap file " << str(name.c_str()) << "\n";
-		} else {
-			// read pcap header
-			pcap::Header header;
-			if (fread(&header, sizeof(header), 1, file) < 1) {
-				Terminal::err << "error: pcap header incomplete!\n";
-			} else if (header.network != pcap::Network::IEEE802_15_4) {
-				Terminal::err << "error: protocol not supported!\n";
-			} else {
-				// read packets
-				Packet packet;
-				while (fread(&packet.header, sizeof(pcap::PacketHeader), 1, file) == 1) {
-					// read packet data
-					int len = min(packet.header.incl_len, int(sizeof(packet.data)));
-					if (fread(packet.data, 1, len, file) < packet.header.incl_len)
-						break;
-
-					// dissect packet
-					PacketReader r(packet.header.incl_len, packet.data);
-					handleIeee(r);
-				}
+		// read from .pcap or .pcapng file
+		CaptureReader reader;
+		if (reader.open(inputFile)) {
+			FilePacket captured;
+			while (reader.read(captured)) {
+				// copy as the packet gets decrypted in-place
+				uint8_t data[sizeof(Packet::data)];
+				int length = min(captured.length, int(sizeof(data)));
+				std::memcpy(data, captured.data, length);
+
+				// dissect packet
+				PacketReader r(length, data);
+				handleIeee(r);
 			}
-			fclose(file);
 		}
 	}
 	return 0;
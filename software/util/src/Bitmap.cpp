@@ -1,6 +1,80 @@
 #include "Bitmap.hpp"
+#include "assert.hpp"
 
 
+// 32 bit word that may alias the bytes of a bitmap
+using Word = uint32_t __attribute__((may_alias));
+
+// apply a mask to a span of columns of a page using 32 bit words where possible
+template <DrawMode M>
+static void fillSpan(uint8_t *page, int width, uint8_t mask) {
+	uint32_t mask32 = mask * 0x01010101;
+	uint8_t *end = page + width;
+
+	// leading bytes up to word alignment
+	while (page < end && (uintptr_t(page) & 3) != 0) {
+		if constexpr (M == DrawMode::CLEAR)
+			*page &= ~mask;
+		else if constexpr (M == DrawMode::FLIP)
+			*page ^= mask;
+		else
+			*page |= mask;
+		++page;
+	}
+
+	// words
+	auto word = reinterpret_cast<Word *>(page);
+	auto wordEnd = word + ((end - page) >> 2);
+	for (; word < wordEnd; ++word) {
+		if constexpr (M == DrawMode::CLEAR)
+			*word &= ~mask32;
+		else if constexpr (M == DrawMode::FLIP)
+			*word ^= mask32;
+		else
+			*word |= mask32;
+	}
+	page = reinterpret_cast<uint8_t *>(word);
+
+	// trailing bytes
+	while (page < end) {
+		if constexpr (M == DrawMode::CLEAR)
+			*page &= ~mask;
+		else if constexpr (M == DrawMode::FLIP)
+			*page ^= mask;
+		else
+			*page |= mask;
+		++page;
+	}
+}
+
+template <DrawMode M>
+static void fillPages(int w, uint8_t *data, int x, int y, int width, int height) {
+	int endRows = (y + height) & 7;
+	uint8_t *page = &data[(y >> 3) * w] + x;
+	uint8_t *pageEnd = &data[((y + height) >> 3) * w] + x;
+
+	// first page
+	{
+		uint8_t mask = 0xff << (y & 7);
+		if (page == pageEnd && endRows > 0) {
+			mask &= 0xff >> (8 - endRows);
+			endRows = 0;
+		}
+		fillSpan<M>(page, width, mask);
+		page += w;
+	}
+
+	// full pages
+	while (page < pageEnd) {
+		fillSpan<M>(page, width, 0xff);
+		page += w;
+	}
+
+	// last page
+	if (endRows > 0)
+		fillSpan<M>(page, width, 0xff >> (8 - endRows));
+}
+
 void fillBitmap(int w, int h, uint8_t *data, int x, int y, int width, int height, DrawMode mode) {
 	//mode = mode & DrawMode::FORE_MASK;
 	if (mode == DrawMode::KEEP)
@@ -23,68 +97,17 @@ void fillBitmap(int w, int h, uint8_t *data, int x, int y, int width, int height
 	}
 	if (width <= 0 || height <= 0)
 		return;
-	
-	int endRows = (y + height) & 7;
-	uint8_t *page = &data[(y >> 3) * w] + x;
-	uint8_t *pageEnd = &data[((y + height) >> 3) * w] + x;
-
-	// first page
-	{
-		uint8_t mask = 0xff << (y & 7);
-		if (page == pageEnd && endRows > 0) {
-			mask &= 0xff >> (8 - endRows);
-			endRows = 0;
-		}
-		for (int i = 0; i < width; ++i) {
-			switch (mode) {
-			case DrawMode::CLEAR:
-				page[i] &= ~mask;
-				break;
-			case DrawMode::FLIP:
-				page[i] ^= mask;
-				break;
-			default:
-				page[i] |= mask;
-				break;
-			}
-		}
-		page += w;
-	}
-	
-	// full pages
-	while (page < pageEnd) {
-		for (int i = 0; i < width; ++i) {
-			switch (mode) {
-			case DrawMode::CLEAR:
-				page[i] = 0;
-				break;
-			case DrawMode::FLIP:
-				page[i] ^= 0xff;
-				break;
-			default:
-				page[i] = 0xff;
-				break;
-			}
-		}
-		page += w;
-	}
 
-	// last page
-	if (endRows > 0) {
-		uint8_t mask = 0xff >> (8 - endRows);
-		for (int i = 0; i < width; ++i) {
-			switch (mode) {
-			case DrawMode::CLEAR:
-				page[i] &= ~mask;
-				break;
-			case DrawMode::FLIP:
-				page[i] ^= mask;
-				break;
-			default:
-				page[i] |= mask;
-				break;
-			}
-		}
+	switch (mode) {
+	case DrawMode::CLEAR:
+		fillPages<DrawMode::CLEAR>(w, data, x, y, width, height);
+		break;
+	case DrawMode::FLIP:
+		fillPages<DrawMode::FLIP>(w, data, x, y, width, height);
+		break;
+	default:
+		fillPages<DrawMode::SET>(w, data, x, y, width, height);
+		break;
 	}
 }
 
@@ -153,3 +176,80 @@ void copyBitmapH(int w, int h, uint8_t *data, int x, int y, int width, int heigh
 		bitmap += bitmapStride;
 	}
 }
+
+template <DrawMode M>
+static void copyColumns(int w, int h, uint8_t *data, int x, int y, int width, int height, const uint8_t *bitmap,
+	int bitmapWidth)
+{
+	int bitmapPageCount = (height + 7) >> 3;
+	int pageCount = (h + 7) >> 3;
+	int page = y >> 3;
+	int shift = y & 7;
+	uint32_t rowMask = (uint32_t(1) << height) - 1;
+
+	// skip pages above the top border
+	int skip = 0;
+	if (page < 0) {
+		skip = -page;
+		page = 0;
+	}
+
+	uint8_t *column = &data[page * w] + x;
+	for (int i = 0; i < width; ++i) {
+		// gather the pages of a column of the bitmap into a word and shift to the destination rows
+		uint32_t word = 0;
+		for (int j = 0; j < bitmapPageCount; ++j)
+			word |= bitmap[j * bitmapWidth + i] << (j << 3);
+		word = ((word & rowMask) << shift) >> (skip << 3);
+
+		// apply word to the destination pages
+		uint8_t *d = column + i;
+		for (int p = page; word != 0 && p < pageCount; ++p) {
+			uint8_t bits = word;
+			if constexpr (M == DrawMode::CLEAR)
+				*d &= ~bits;
+			else if constexpr (M == DrawMode::FLIP)
+				*d ^= bits;
+			else
+				*d |= bits;
+			word >>= 8;
+			d += w;
+		}
+	}
+}
+
+void copyBitmapV(int w, int h, uint8_t *data, int x, int y, int width, int height, const uint8_t *bitmap,
+	DrawMode mode)
+{
+	// height plus shift must fit into a 32 bit word
+	assert(height <= 24);
+	if (mode == DrawMode::KEEP)
+		return;
+
+	// number of bytes in a page of the bitmap
+	int bitmapWidth = width;
+
+	// clamp to border
+	if (x < 0) {
+		bitmap += -x;
+		width += x;
+		x = 0;
+	}
+	if (x + width > w) {
+		width = w - x;
+	}
+	if (width <= 0 || y >= h || y + height <= 0)
+		return;
+
+	switch (mode) {
+	case DrawMode::CLEAR:
+		copyColumns<DrawMode::CLEAR>(w, h, data, x, y, width, height, bitmap, bitmapWidth);
+		break;
+	case DrawMode::FLIP:
+		copyColumns<DrawMode::FLIP>(w, h, data, x, y, width, height, bitmap, bitmapWidth);
+		break;
+	default:
+		copyColumns<DrawMode::SET>(w, h, data, x, y, width, height, bitmap, bitmapWidth);
+		break;
+	}
+}
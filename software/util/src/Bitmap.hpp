@@ -8,10 +8,15 @@
 // fill a bitmap with background
 void fillBitmap(int w, int h, uint8_t *data, int x, int y, int width, int height, DrawMode mode);
 
-// copy a bitmap that is organized horizontally (font)
+// copy a bitmap that is organized horizontally
 void copyBitmapH(int w, int h, uint8_t *data, int x, int y, int width, int height, const uint8_t *bitmap,
 	DrawMode mode);
 
+// copy a bitmap that is organized in pages of 8 rows where each byte is a column, same as Bitmap (font).
+// Height is at most 24
+void copyBitmapV(int w, int h, uint8_t *data, int x, int y, int width, int height, const uint8_t *bitmap,
+	DrawMode mode);
+
 template <int W, int H>
 class Bitmap {
 public:
@@ -61,7 +66,7 @@ public:
 				
 				// draw character
 				const Character &character = font.characters[ch - font.first];
-				copyBitmapH(W, H, this->data, x, y, character.width, font.height, font.bitmap + character.offset, mode);
+				copyBitmapV(W, H, this->data, x, y, character.width, font.height, font.bitmap + character.offset, mode);
 				x += character.width;
 
 				// draw space
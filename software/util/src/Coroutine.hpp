@@ -247,6 +247,21 @@ public:
 		return false;
 	}
 
+	/**
+	 * Visit all elements in the order in which they were added
+	 * @tparam V visitor type, e.g. a lambda function
+	 * @param visitor visitor
+	 */
+	template <typename V>
+	void visitAll(V const &visitor) {
+		auto *current = this->head.next;
+		auto *end = &this->head;
+		while (current != end) {
+			visitor(Selector::get(static_cast<Element*>(current)));
+			current = current->next;
+		}
+	}
+
 	/**
 	 * Remove and resume first waiting coroutine
 	 * @return true when a coroutine was resumed, false when the list was empty
@@ -30,7 +30,7 @@ struct Font {
 	// characters supported by the font
 	Character const *characters;
 
-	// glyph bitmap data
+	// glyph bitmap data, organized in pages of 8 rows where each byte is a column (same as Bitmap)
 	uint8_t const *bitmap;
 	
 	int calcWidth(String text, int space = 1);
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+
+
+/**
+ * Hash table with open addressing that maps integer keys to pointers. Does not take ownership of the pointers
+ * @tparam K key type (unsigned integer of up to 64 bit)
+ * @tparam V value type, the hash table stores pointers to V
+ * @tparam N size of hash table, must be a power of two and should be at least twice the maximum number of elements
+ */
+template <typename K, typename V, int N>
+class PointerHash {
+	static_assert(N > 1 && (N & (N - 1)) == 0);
+
+	static constexpr int log2(int n) {return n > 1 ? 1 + log2(n >> 1) : 0;}
+	static constexpr int SHIFT = 32 - log2(N);
+
+public:
+
+	bool isEmpty() const {return this->elementCount <= 0;}
+
+	int count() const {return this->elementCount;}
+
+	void clear() {
+		for (Element &element : this->hashTable)
+			element.value = nullptr;
+		this->elementCount = 0;
+	}
+
+	/**
+	 * Get the value for a key
+	 * @param key key
+	 * @return value or nullptr if the key is not in the hash table
+	 */
+	V *get(K key) const {
+		int index = hash(key);
+		while (true) {
+			auto &element = this->hashTable[index];
+			if (element.value == nullptr)
+				return nullptr;
+			if (element.key == key)
+				return element.value;
+			index = (index + 1) & (N - 1);
+		}
+	}
+
+	/**
+	 * Set the value for a key, replaces an existing value
+	 * @param key key
+	 * @param value value, must not be nullptr
+	 * @return true if successful, false if the hash table is full
+	 */
+	bool set(K key, V *value) {
+		int index = hash(key);
+		while (true) {
+			auto &element = this->hashTable[index];
+			if (element.value == nullptr) {
+				// keep one empty element so that lookups terminate
+				if (this->elementCount >= N - 1)
+					return false;
+				++this->elementCount;
+				element.key = key;
+				element.value = value;
+				return true;
+			}
+			if (element.key == key) {
+				element.value = value;
+				return true;
+			}
+			index = (index + 1) & (N - 1);
+		}
+	}
+
+	/**
+	 * Remove a key if it maps to the given value
+	 * @param key key
+	 * @param value value, the key is not removed if it maps to another value
+	 */
+	void remove(K key, V *value) {
+		int index = hash(key);
+		while (true) {
+			auto &element = this->hashTable[index];
+			if (element.value == nullptr)
+				return;
+			if (element.key == key)
+				break;
+			index = (index + 1) & (N - 1);
+		}
+		if (this->hashTable[index].value != value)
+			return;
+		--this->elementCount;
+
+		// move following elements back into the gap so that no tombstones are needed
+		int gap = index;
+		while (true) {
+			index = (index + 1) & (N - 1);
+			auto &element = this->hashTable[index];
+			if (element.value == nullptr)
+				break;
+
+			// move element if its home position is not cyclically in (gap, index]
+			int home = hash(element.key);
+			if (((index - home) & (N - 1)) >= ((index - gap) & (N - 1))) {
+				this->hashTable[gap] = element;
+				gap = index;
+			}
+		}
+		this->hashTable[gap].value = nullptr;
+	}
+
+protected:
+
+	static int hash(K key) {
+		// fold to 32 bit and use fibonacci hashing
+		auto k = uint64_t(key);
+		return int((uint32_t(k ^ (k >> 32)) * 2654435769u) >> SHIFT) & (N - 1);
+	}
+
+	struct Element {
+		K key;
+		V *value = nullptr;
+	};
+
+	Element hashTable[N];
+	int elementCount = 0;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+
+/**
+ * Lock-free ring buffer with fixed size for exactly one producer thread and one consumer thread. Elements are written
+ * and read in place, the producer fills getNextBack() and commits it using addBack(), the consumer reads getFront()
+ * and releases it using removeFront()
+ * @tparam Element element type
+ * @tparam N capacity, must be a power of two
+ */
+template <typename Element, int N>
+class RingBuffer {
+	static_assert(N > 1 && (N & (N - 1)) == 0);
+
+public:
+	/**
+	 * Check if the ring buffer is empty
+	 * @return true if empty
+	 */
+	bool isEmpty() const {
+		return this->front.load(std::memory_order_acquire) == this->back.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Get number of elements in the ring buffer, only a snapshot when called while the other thread is active
+	 * @return number of elements
+	 */
+	int count() const {
+		return int(this->back.load(std::memory_order_acquire) - this->front.load(std::memory_order_acquire));
+	}
+
+	/**
+	 * Producer: Get the next element behind the back of the ring buffer
+	 * @return element to fill or nullptr if the ring buffer is full
+	 */
+	Element *getNextBack() {
+		uint32_t back = this->back.load(std::memory_order_relaxed);
+		if (back - this->front.load(std::memory_order_acquire) >= uint32_t(N))
+			return nullptr;
+		return &this->elements[back & (N - 1)];
+	}
+
+	/**
+	 * Producer: Add the element returned by getNextBack() to the ring buffer
+	 */
+	void addBack() {
+		this->back.store(this->back.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/**
+	 * Consumer: Get the element at the front of the ring buffer
+	 * @return element at front or nullptr if the ring buffer is empty
+	 */
+	Element *getFront() {
+		uint32_t front = this->front.load(std::memory_order_relaxed);
+		if (front == this->back.load(std::memory_order_acquire))
+			return nullptr;
+		return &this->elements[front & (N - 1)];
+	}
+
+	/**
+	 * Consumer: Remove the element at the front so that the producer can use it again
+	 */
+	void removeFront() {
+		this->front.store(this->front.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+protected:
+	// indices count up and wrap around, separate cache lines avoid false sharing between the threads
+	alignas(64) std::atomic<uint32_t> front = 0;
+	alignas(64) std::atomic<uint32_t> back = 0;
+
+	Element elements[N];
+};
@@ -0,0 +1,27 @@
+#include <Bitmap.hpp>
+#include <tahoma_8pt.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+
+
+// benchmark redraw of a full menu (six lines of text, selection and underlined entry)
+TEST(utilBenchmark, Bitmap) {
+	String const lines[] = {"Local Devices", "Radio Devices", "Alarms", "Functions", "Flight Recorder", "Exit"};
+	Bitmap<128, 64> bitmap;
+	constexpr int count = 10000;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i) {
+		bitmap.clear();
+		int y = 0;
+		for (auto line : lines) {
+			int x = bitmap.drawText(10, y, tahoma_8pt, line);
+			if (y == 15)
+				bitmap.hLine(10, y + tahoma_8pt.height, x - 10);
+			y += tahoma_8pt.height;
+		}
+		bitmap.fillRectangle(9, 0, 80, tahoma_8pt.height, DrawMode::FLIP);
+	}
+	auto time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "menu redraw: " << time / count << "us" << std::endl;
+}
@@ -1,20 +1,25 @@
 #include <Array.hpp>
 #include <ArrayList.hpp>
+#include <Bitmap.hpp>
 #include <convert.hpp>
 #include <Coroutine.hpp>
 #include <DataQueue.hpp>
 #include <enum.hpp>
 #include <IsSubclass.hpp>
 #include <LinkedList.hpp>
+#include <PointerHash.hpp>
 #include <Queue.hpp>
+#include <RingBuffer.hpp>
 #include <StringBuffer.hpp>
 #include <StringHash.hpp>
 #include <StringSet.hpp>
 #include <StringOperators.hpp>
 #include <TopicBuffer.hpp>
 #include <Cie1931.hpp>
+#include <tahoma_8pt.hpp>
 #include <gtest/gtest.h>
 #include <random>
+#include <thread>
 #include <netinet/in.h> // htonl
 
 
@@ -388,6 +393,61 @@ TEST(utilTest, Queue) {
 	EXPECT_EQ(queue.getFront(), 1000 + 1);
 }
 
+TEST(utilTest, RingBuffer) {
+	using R = RingBuffer<int, 4>;
+	R ring;
+
+	// check if initially empty
+	EXPECT_TRUE(ring.isEmpty());
+	EXPECT_EQ(ring.getFront(), nullptr);
+
+	// add elements until ring buffer is full
+	int i = 0;
+	while (int *element = ring.getNextBack()) {
+		*element = 1000 + i;
+		ring.addBack();
+		++i;
+	}
+	EXPECT_EQ(i, 4);
+	EXPECT_EQ(ring.count(), 4);
+
+	// remove one element and add another one that wraps around
+	EXPECT_EQ(*ring.getFront(), 1000);
+	ring.removeFront();
+	*ring.getNextBack() = 2000;
+	ring.addBack();
+	for (int j : {1001, 1002, 1003, 2000}) {
+		EXPECT_EQ(*ring.getFront(), j);
+		ring.removeFront();
+	}
+	EXPECT_TRUE(ring.isEmpty());
+
+	// transfer elements from a producer thread to a consumer thread
+	constexpr int count = 100000;
+	RingBuffer<int, 64> ring2;
+	std::thread producer([&ring2]() {
+		for (int i = 0; i < count; ++i) {
+			int *element;
+			while ((element = ring2.getNextBack()) == nullptr)
+				std::this_thread::yield();
+			*element = i;
+			ring2.addBack();
+		}
+	});
+	int errorCount = 0;
+	for (int i = 0; i < count; ++i) {
+		int *element;
+		while ((element = ring2.getFront()) == nullptr)
+			std::this_thread::yield();
+		if (*element != i)
+			++errorCount;
+		ring2.removeFront();
+	}
+	producer.join();
+	EXPECT_EQ(errorCount, 0);
+	EXPECT_TRUE(ring2.isEmpty());
+}
+
 
 // Stream
 // ------
@@ -598,6 +658,74 @@ TEST(utilTest, StringHash) {
 }
 
 
+// exposes the hash function to check the distribution of the test keys
+struct PointerHashTest : public PointerHash<uint64_t, int, 64> {
+	using PointerHash::hash;
+};
+
+TEST(utilTest, PointerHash) {
+	std::mt19937_64 gen(1337); // 64 bit mersenne_twister_engine seeded with 1337
+	constexpr int KEY_COUNT = 200;
+	uint64_t keys[KEY_COUNT];
+	int values[KEY_COUNT];
+
+	// random 64 bit keys, half of them only differ in the upper 32 bit
+	for (int i = 0; i < KEY_COUNT; ++i)
+		keys[i] = (i & 1) == 0 ? gen() : keys[i - 1] ^ (gen() << 32);
+
+	// the keys are spread over the hash table, but some share their home position which needs probing
+	bool used[64] = {};
+	int usedCount = 0;
+	for (int i = 0; i < 32; ++i) {
+		int index = PointerHashTest::hash(keys[i]);
+		usedCount += used[index] ? 0 : 1;
+		used[index] = true;
+	}
+	EXPECT_GT(usedCount, 16);
+	EXPECT_LT(usedCount, 32);
+
+	PointerHash<uint64_t, int, 64> hash;
+	std::map<uint64_t, int *> stdMap;
+	EXPECT_TRUE(hash.isEmpty());
+
+	// randomly add and remove keys, keeping at most 32 elements in the hash table
+	std::uniform_int_distribution<int> distrib(0, KEY_COUNT - 1);
+	int other;
+	for (int round = 0; round < 10000; ++round) {
+		int i = distrib(gen);
+		uint64_t key = keys[i];
+		if (stdMap.size() < 32 && (round & 1) == 0) {
+			EXPECT_TRUE(hash.set(key, &values[i]));
+			stdMap[key] = &values[i];
+		} else {
+			// removing with a value that is not in the hash table has no effect
+			hash.remove(key, &other);
+			EXPECT_EQ(stdMap.count(key) > 0 ? &values[i] : nullptr, hash.get(key));
+
+			hash.remove(key, &values[i]);
+			stdMap.erase(key);
+		}
+		EXPECT_EQ(stdMap.size(), hash.count());
+	}
+
+	// compare contents to std::map
+	for (uint64_t key : keys) {
+		auto it = stdMap.find(key);
+		EXPECT_EQ(it == stdMap.end() ? nullptr : it->second, hash.get(key));
+	}
+
+	// fill up to one empty element
+	hash.clear();
+	EXPECT_TRUE(hash.isEmpty());
+	for (int i = 0; i < 63; ++i)
+		EXPECT_TRUE(hash.set(keys[i], &values[i]));
+	EXPECT_FALSE(hash.set(keys[63], &values[63]));
+	for (int i = 0; i < 63; ++i)
+		EXPECT_EQ(&values[i], hash.get(keys[i]));
+	EXPECT_EQ(nullptr, hash.get(keys[63]));
+}
+
+
 // Topic
 // -----
 
@@ -1038,6 +1166,68 @@ TEST(utilTest, Semaphore) {
 	c2.destroy();
 }
 
+// original tahoma_8pt with horizontally organized glyph bitmaps, reference for the transposed font
+namespace horizontal {
+#include <tahoma_8pt.dotfactory.c>
+}
+
+// reference for bitmap drawing: apply draw mode to a single pixel
+template <int W, int H>
+void drawPixel(Bitmap<W, H> &bitmap, int x, int y, DrawMode mode) {
+	if (x < 0 || x >= W || y < 0 || y >= H)
+		return;
+	uint8_t &b = bitmap.data[(y >> 3) * W + x];
+	uint8_t bit = 1 << (y & 7);
+	switch (mode) {
+	case DrawMode::CLEAR:
+		b &= ~bit;
+		break;
+	case DrawMode::FLIP:
+		b ^= bit;
+		break;
+	case DrawMode::SET:
+		b |= bit;
+		break;
+	default:
+		break;
+	}
+}
+
+TEST(utilTest, Bitmap) {
+	std::mt19937 gen(1);
+	DrawMode const modes[] = {DrawMode::CLEAR, DrawMode::FLIP, DrawMode::KEEP, DrawMode::SET};
+	Bitmap<128, 64> bitmap;
+	Bitmap<128, 64> reference;
+	for (int i = 0; i < 10000; ++i) {
+		for (int j = 0; j < 128 * 64 / 8; ++j)
+			bitmap.data[j] = reference.data[j] = gen();
+		int x = int(gen() % 160) - 16;
+		int y = int(gen() % 90) - 13;
+		DrawMode mode = modes[gen() % 4];
+
+		if ((i & 1) == 0) {
+			// fill
+			int width = gen() % 140;
+			int height = gen() % 80;
+			bitmap.fillRectangle(x, y, width, height, mode);
+			for (int b = 0; b < height; ++b) {
+				for (int a = 0; a < width; ++a)
+					drawPixel(reference, x + a, y + b, mode);
+			}
+		} else {
+			// glyph: draw the transposed font using copyBitmapV() and the original font using copyBitmapH()
+			auto &font = tahoma_8pt;
+			auto &original = horizontal::tahoma_8pt;
+			unsigned char ch = font.first + gen() % (font.last - font.first + 1);
+			auto &character = original.characters[ch - original.first];
+			bitmap.drawText(x, y, font, String(1, &ch), 1, mode);
+			copyBitmapH(128, 64, reference.data, x, y, character.width, original.height,
+				original.bitmap + character.offset, mode);
+		}
+		ASSERT_TRUE(array::equals(128 * 64 / 8, bitmap.data, reference.data));
+	}
+}
+
 TEST(utilTest, color) {
 	auto xy1 = hueToCie(0.0f, 0.0f);
 	auto xy2 = hueToCie(0.0f, 1.0f);